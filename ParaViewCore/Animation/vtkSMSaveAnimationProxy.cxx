@@ -38,7 +38,15 @@
 #include "vtkSMViewLayoutProxy.h"
 #include "vtkSMViewProxy.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace vtkSMSaveAnimationProxyNS
@@ -53,11 +61,138 @@ public:
   }
 };
 
+/**
+ * Number of threads used to encode and write image series. Movies are always
+ * encoded by a single thread since frames must be written in order.
+ */
+static int GetNumberOfImageEncoders()
+{
+  const unsigned int cores = std::thread::hardware_concurrency();
+  return static_cast<int>(std::max(1u, std::min(4u, cores / 2)));
+}
+
+/**
+ * Bounded queue of grabbed frames that are encoded and written by a pool of
+ * worker threads, so that encoding and disk writes overlap with rendering the
+ * next frames. Frames are handed to workers in the order they were pushed;
+ * with a single worker, they are also written in that order. Push() blocks
+ * while the queue is full, bounding the memory held by pending frames.
+ */
+class FrameQueue
+{
+public:
+  using WriteFunction = std::function<bool(int worker, vtkImageData* image, int index)>;
+
+  FrameQueue()
+    : Capacity(0)
+    , Done(false)
+    , Failed(false)
+  {
+  }
+  ~FrameQueue() { this->Finish(); }
+
+  void Start(int numberOfWorkers, WriteFunction write)
+  {
+    this->Finish();
+    this->Write = write;
+    this->Capacity = 2 * static_cast<size_t>(numberOfWorkers);
+    this->Done = false;
+    this->Failed = false;
+    for (int cc = 0; cc < numberOfWorkers; ++cc)
+    {
+      this->Workers.push_back(std::thread(&FrameQueue::Run, this, cc));
+    }
+  }
+
+  /**
+   * Queue a frame. Returns false if writing an earlier frame failed.
+   */
+  bool Push(vtkImageData* image, int index)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->NotFull.wait(lock, [this]() { return this->Frames.size() < this->Capacity; });
+    if (this->Failed)
+    {
+      return false;
+    }
+    Frame frame;
+    frame.Image = image;
+    frame.Index = index;
+    this->Frames.push_back(frame);
+    this->NotEmpty.notify_one();
+    return true;
+  }
+
+  /**
+   * Wait for all queued frames to be written and stop the workers. Returns
+   * false if any frame failed to be written.
+   */
+  bool Finish()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Done = true;
+    }
+    this->NotEmpty.notify_all();
+    for (auto& worker : this->Workers)
+    {
+      worker.join();
+    }
+    this->Workers.clear();
+    return !this->Failed;
+  }
+
+private:
+  struct Frame
+  {
+    vtkSmartPointer<vtkImageData> Image;
+    int Index;
+  };
+
+  void Run(int worker)
+  {
+    while (true)
+    {
+      Frame frame;
+      {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->NotEmpty.wait(lock, [this]() { return this->Done || !this->Frames.empty(); });
+        if (this->Frames.empty())
+        {
+          return;
+        }
+        frame = this->Frames.front();
+        this->Frames.pop_front();
+      }
+      this->NotFull.notify_one();
+
+      // skip remaining frames once a write failed.
+      if (!this->Failed && !this->Write(worker, frame.Image, frame.Index))
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Failed = true;
+      }
+    }
+  }
+
+  WriteFunction Write;
+  std::deque<Frame> Frames;
+  size_t Capacity;
+  bool Done;
+  std::atomic<bool> Failed;
+  std::mutex Mutex;
+  std::condition_variable NotEmpty;
+  std::condition_variable NotFull;
+  std::vector<std::thread> Workers;
+};
+
 template <class T>
 class SceneImageWriter : public vtkSMAnimationSceneWriter
 {
-  vtkSmartPointer<T> Writer;
+  std::vector<vtkSmartPointer<T> > Writers;
   vtkWeakPointer<vtkSMSaveAnimationProxy> Helper;
+  FrameQueue Frames;
+  int FrameIndex;
 
 public:
   vtkTemplateTypeMacro(SceneImageWriter, vtkSMAnimationSceneWriter);
@@ -69,22 +204,51 @@ public:
   /**
    * Set the writer to use.
    */
-  void SetWriter(T* writer) { this->Writer = writer; }
-  T* GetWriter() { return this->Writer; }
+  void SetWriter(T* writer) { this->Writers.assign(1, writer); }
+  T* GetWriter(int worker = 0)
+  {
+    return worker < static_cast<int>(this->Writers.size()) ? this->Writers[worker].Get() : nullptr;
+  }
+
+  /**
+   * Add a writer, configured identically to the one passed to SetWriter(),
+   * letting one more frame be encoded concurrently.
+   */
+  void AddWriter(T* writer) { this->Writers.push_back(writer); }
 
 protected:
-  SceneImageWriter() {}
+  SceneImageWriter()
+    : FrameIndex(0)
+  {
+  }
   ~SceneImageWriter() {}
-  bool SaveInitialize(int vtkNotUsed(startCount)) override
+
+  /**
+   * Number of threads encoding frames. Defaults to one per writer.
+   */
+  virtual int GetNumberOfEncoders() { return static_cast<int>(this->Writers.size()); }
+
+  bool SaveInitialize(int startCount) override
   {
     // Animation scene call render on each tick. We override that render call
     // since it's a waste of rendering, the code to save the images will call
     // render anyways.
     this->AnimationScene->SetOverrideStillRender(1);
+
+    // only the root node writes images, see SaveFrame().
+    vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+    if (!controller || controller->GetLocalProcessId() == 0)
+    {
+      this->FrameIndex = startCount;
+      this->Frames.Start(std::max(1, this->GetNumberOfEncoders()),
+        [this](int worker, vtkImageData* image, int index) {
+          return this->WriteFrameImage(worker, image, index);
+        });
+    }
     return true;
   }
 
-  bool SaveFrame(double time) override
+  bool SaveFrame(double vtkNotUsed(time)) override
   {
     vtkSmartPointer<vtkImageData> image = SceneGrabber::Grab(this->Helper);
 
@@ -99,16 +263,22 @@ protected:
       return true;
     }
 
-    return this->WriteFrameImage(time, image);
+    // the image is encoded and written in the background while the next
+    // frame renders.
+    return this->Frames.Push(image, this->FrameIndex++);
   }
 
   bool SaveFinalize() override
   {
     this->AnimationScene->SetOverrideStillRender(0);
-    return true;
+    return this->Frames.Finish();
   }
 
-  virtual bool WriteFrameImage(double time, vtkImageData* data) = 0;
+  /**
+   * Write a frame. Called on encoding threads; `worker` identifies the writer
+   * to use and `index` is the frame count, starting at the start file count.
+   */
+  virtual bool WriteFrameImage(int worker, vtkImageData* data, int index) = 0;
 
 private:
   SceneImageWriter(const SceneImageWriter&) = delete;
@@ -128,6 +298,9 @@ protected:
   }
   ~SceneImageWriterMovie() {}
 
+  // movie frames must be written in order.
+  int GetNumberOfEncoders() override { return 1; }
+
   bool SaveInitialize(int startCount) override
   {
     if (auto* writer = this->GetWriter())
@@ -139,7 +312,7 @@ protected:
     return false;
   }
 
-  bool WriteFrameImage(double vtkNotUsed(time), vtkImageData* data) override
+  bool WriteFrameImage(int vtkNotUsed(worker), vtkImageData* data, int vtkNotUsed(index)) override
   {
     assert(data);
     auto* writer = this->GetWriter();
@@ -156,12 +329,14 @@ protected:
 
   bool SaveFinalize() override
   {
+    // wait for pending frames before closing the movie.
+    const bool status = this->Superclass::SaveFinalize();
     if (this->Started)
     {
       this->GetWriter()->End();
     }
     this->Started = false;
-    return this->Superclass::SaveFinalize();
+    return status;
   }
 
 private:
@@ -185,15 +360,13 @@ public:
 
 protected:
   SceneImageWriterImageSeries()
-    : Counter(0)
-    , SuffixFormat(nullptr)
+    : SuffixFormat(nullptr)
   {
   }
   ~SceneImageWriterImageSeries() { this->SetSuffixFormat(nullptr); }
 
   bool SaveInitialize(int startCount) override
   {
-    this->Counter = startCount;
     auto path = vtksys::SystemTools::GetFilenamePath(this->FileName);
     auto prefix = vtksys::SystemTools::GetFilenameWithoutLastExtension(this->FileName);
     this->Prefix = path.empty() ? prefix : path + "/" + prefix;
@@ -201,15 +374,15 @@ protected:
     return this->Superclass::SaveInitialize(startCount);
   }
 
-  bool WriteFrameImage(double vtkNotUsed(time), vtkImageData* data) override
+  bool WriteFrameImage(int worker, vtkImageData* data, int index) override
   {
-    auto writer = this->GetWriter();
+    auto writer = this->GetWriter(worker);
     assert(data);
     assert(this->SuffixFormat);
     assert(writer);
 
     char buffer[1024];
-    snprintf(buffer, 1024, this->SuffixFormat, this->Counter);
+    snprintf(buffer, 1024, this->SuffixFormat, index);
 
     std::ostringstream str;
     str << this->Prefix << buffer << this->Extension;
@@ -218,15 +391,12 @@ protected:
     writer->Write();
     writer->SetInputData(nullptr);
 
-    const bool success = writer->GetErrorCode() == vtkErrorCode::NoError;
-    this->Counter += success ? 1 : 0;
-    return success;
+    return writer->GetErrorCode() == vtkErrorCode::NoError;
   }
 
 private:
   SceneImageWriterImageSeries(const SceneImageWriterImageSeries&) = delete;
   void operator=(const SceneImageWriterImageSeries&) = delete;
-  int Counter;
   char* SuffixFormat;
   std::string Prefix;
   std::string Extension;
@@ -337,6 +507,25 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
   {
     vtkNew<vtkSMSaveAnimationProxyNS::SceneImageWriterImageSeries> realWriter;
     realWriter->SetWriter(imgWriter);
+
+    // images are independent, so several can be encoded at once. Each encoding
+    // thread needs its own writer, configured like the format proxy.
+    vtkSMSessionProxyManager* pxm = this->GetSessionProxyManager();
+    for (int cc = 1; cc < vtkSMSaveAnimationProxyNS::GetNumberOfImageEncoders(); ++cc)
+    {
+      vtkSmartPointer<vtkSMProxy> clone;
+      clone.TakeReference(pxm->NewProxy(formatProxy->GetXMLGroup(), formatProxy->GetXMLName()));
+      if (!clone)
+      {
+        break;
+      }
+      clone->Copy(formatProxy);
+      clone->UpdateVTKObjects();
+      if (auto cloneWriter = vtkImageWriter::SafeDownCast(clone->GetClientSideObject()))
+      {
+        realWriter->AddWriter(cloneWriter);
+      }
+    }
     realWriter->SetSuffixFormat(vtkSMPropertyHelper(formatProxy, "SuffixFormat").GetAsString());
     realWriter->SetHelper(this);
     writer = realWriter;
@@ -162,6 +162,19 @@ const char* vtkPVCompositeDataInformation::GetName(unsigned int idx)
   return this->Internal->ChildrenInformation[idx].Name.c_str();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataInformation::Compact()
+{
+  for (auto& node : this->Internal->ChildrenInformation)
+  {
+    if (node.Info)
+    {
+      node.Info->ClearDetails();
+      node.Info->CompositeDataInformation->Compact();
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVCompositeDataInformation::CopyFromObject(vtkObject* object)
 {
@@ -219,6 +232,8 @@ void vtkPVCompositeDataInformation::CopyFromObject(vtkObject* object)
     if (curDO)
     {
       childInfo = vtkSmartPointer<vtkPVDataInformation>::New();
+      // the root information decides whether the whole tree is compacted.
+      childInfo->SetCompactCompositeThreshold(-1);
       childInfo->CopyFromObject(curDO);
     }
     this->Internal->ChildrenInformation.resize(index + 1);
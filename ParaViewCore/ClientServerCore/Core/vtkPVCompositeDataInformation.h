@@ -108,6 +108,14 @@ public:
   vtkGetMacro(NumberOfAMRLevels, unsigned int);
   //@}
 
+  /**
+   * Drops the attribute arrays information for all blocks in this tree,
+   * keeping only the block types, names and counts. The information for the
+   * individual blocks is then marked as compact (see
+   * vtkPVDataInformation::GetIsCompact()).
+   */
+  void Compact();
+
   // TODO:
   // Add API to obtain meta data information for each of the children.
 
@@ -24,6 +24,7 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
+#include "vtkDataObjectTreeIterator.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSet.h"
 #include "vtkExecutive.h"
@@ -34,6 +35,7 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkMath.h"
+#include "vtkMultiPieceDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
@@ -48,10 +50,12 @@
 #include "vtkPointData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSelection.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkTable.h"
 #include "vtkUniformGrid.h"
+#include "vtkUniformGridAMR.h"
 
 #include <algorithm>
 #include <map>
@@ -63,6 +67,86 @@ vtkStandardNewMacro(vtkPVDataInformation);
 
 std::map<std::string, std::string> helpers;
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Number of leaves in the structure of the composite dataset, including empty
+// ones. Unlike the number of non-empty datasets, this is the same on all ranks.
+vtkIdType vtkPVDataInformationCountLeaves(vtkCompositeDataSet* cds)
+{
+  if (vtkUniformGridAMR* amr = vtkUniformGridAMR::SafeDownCast(cds))
+  {
+    return static_cast<vtkIdType>(amr->GetTotalNumberOfBlocks());
+  }
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(cds->NewIterator());
+  iter->SkipEmptyNodesOff();
+  vtkIdType count = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    ++count;
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+// Returns the node with the given composite index in an AMR dataset. AMR
+// information is organized as one multi-piece node per level (see
+// vtkPVCompositeDataInformation::CopyFromAMR), so the index counts the level
+// nodes as well as the blocks, unlike the flat index of the AMR iterator.
+vtkSmartPointer<vtkDataObject> vtkPVDataInformationGetAMRNode(
+  vtkUniformGridAMR* amr, unsigned int compositeIndex)
+{
+  unsigned int index = 1;
+  for (unsigned int level = 0, numLevels = amr->GetNumberOfLevels(); level < numLevels; ++level)
+  {
+    const unsigned int numDataSets = amr->GetNumberOfDataSets(level);
+    if (compositeIndex == index)
+    {
+      vtkNew<vtkMultiPieceDataSet> levelDS;
+      levelDS->SetNumberOfPieces(numDataSets);
+      for (unsigned int cc = 0; cc < numDataSets; ++cc)
+      {
+        levelDS->SetPiece(cc, amr->GetDataSet(level, cc));
+      }
+      return levelDS.GetPointer();
+    }
+    if (compositeIndex <= index + numDataSets)
+    {
+      return amr->GetDataSet(level, compositeIndex - index - 1);
+    }
+    index += numDataSets + 1;
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVDataInformationGetNode(
+  vtkCompositeDataSet* cds, unsigned int compositeIndex)
+{
+  if (vtkUniformGridAMR* amr = vtkUniformGridAMR::SafeDownCast(cds))
+  {
+    return vtkPVDataInformationGetAMRNode(amr, compositeIndex);
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(cds->NewIterator());
+  if (vtkDataObjectTreeIterator* treeIter = vtkDataObjectTreeIterator::SafeDownCast(iter))
+  {
+    treeIter->VisitOnlyLeavesOff();
+  }
+  iter->SkipEmptyNodesOff();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (iter->GetCurrentFlatIndex() == compositeIndex)
+    {
+      return iter->GetCurrentDataObject();
+    }
+  }
+  return nullptr;
+}
+}
+
 //----------------------------------------------------------------------------
 vtkPVDataInformation::vtkPVDataInformation()
 {
@@ -114,14 +198,15 @@ vtkPVDataInformation::~vtkPVDataInformation()
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
-  str << 828792 << this->PortNumber;
+  str << 828792 << this->PortNumber << this->CompositeIndex << this->CompactCompositeThreshold;
 }
 
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
 {
   int magic_number;
-  str >> magic_number >> this->PortNumber;
+  str >> magic_number >> this->PortNumber >> this->CompositeIndex >>
+    this->CompactCompositeThreshold;
   if (magic_number != 828792)
   {
     vtkErrorMacro("Magic number mismatch.");
@@ -135,6 +220,9 @@ void vtkPVDataInformation::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "PortNumber: " << this->PortNumber << endl;
+  os << indent << "CompositeIndex: " << this->CompositeIndex << endl;
+  os << indent << "CompactCompositeThreshold: " << this->CompactCompositeThreshold << endl;
+  os << indent << "IsCompact: " << this->IsCompact << endl;
   os << indent << "DataSetType: " << this->DataSetType << endl;
   os << indent << "CompositeDataSetType: " << this->CompositeDataSetType << endl;
   os << indent << "NumberOfPoints: " << this->NumberOfPoints << endl;
@@ -273,6 +361,7 @@ void vtkPVDataInformation::Initialize()
   this->Time = 0.0;
   this->NumberOfTimeSteps = 0;
   this->SetTimeLabel(nullptr);
+  this->IsCompact = false;
 }
 
 //----------------------------------------------------------------------------
@@ -331,6 +420,20 @@ void vtkPVDataInformation::DeepCopy(
   this->TimeSpan[1] = timespan[1];
   this->NumberOfTimeSteps = dataInfo->GetNumberOfTimeSteps();
   this->SetTimeLabel(dataInfo->GetTimeLabel());
+  this->IsCompact = dataInfo->IsCompact;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::ClearDetails()
+{
+  this->PointDataInformation->Initialize();
+  this->CellDataInformation->Initialize();
+  this->VertexDataInformation->Initialize();
+  this->EdgeDataInformation->Initialize();
+  this->RowDataInformation->Initialize();
+  this->FieldDataInformation->Initialize();
+  this->PointArrayInformation->Initialize();
+  this->IsCompact = true;
 }
 
 //----------------------------------------------------------------------------
@@ -440,6 +543,18 @@ void vtkPVDataInformation::CopyFromCompositeDataSet(vtkCompositeDataSet* data)
   // AddInformation should have updated NumberOfDataSets correctly to count
   // number of non-zero datasets. We don't need to fix it here.
   // this->NumberOfDataSets = numDataSets;
+
+  // For large trees, shipping arrays information for every block dominates
+  // the cost of gathering and transferring the information. The union of all
+  // arrays is available on this object, so only keep the tree structure and
+  // let clients request details for individual blocks on demand. The
+  // decision is made on the size of the structure, not on the number of
+  // non-empty blocks, so that all ranks agree on it.
+  if (this->CompactCompositeThreshold >= 0 &&
+    vtkPVDataInformationCountLeaves(data) > this->CompactCompositeThreshold)
+  {
+    this->CompositeDataInformation->Compact();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -779,6 +894,21 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
   }
 
   vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(dobj);
+  if (cds && this->CompositeIndex > 0)
+  {
+    // Gather information only for the requested node.
+    vtkSmartPointer<vtkDataObject> curDO = vtkPVDataInformationGetNode(cds, this->CompositeIndex);
+    if (curDO)
+    {
+      const unsigned int compositeIndex = this->CompositeIndex;
+      this->CompositeIndex = 0;
+      this->CopyFromObject(curDO);
+      this->CompositeIndex = compositeIndex;
+      this->CopyCommonMetaData(curDO, info);
+    }
+    return;
+  }
+
   if (cds)
   {
     this->CopyFromCompositeDataSet(cds);
@@ -877,6 +1007,7 @@ void vtkPVDataInformation::AddInformation(vtkPVInformation* pvi, int addingParts
     this->SetCompositeDataSetName(info->GetCompositeDataSetName());
     this->CompositeDataSetType = info->CompositeDataSetType;
     this->CompositeDataInformation->AddInformation(info->CompositeDataInformation);
+    this->IsCompact = this->IsCompact || info->IsCompact;
   }
 
   if (info->NumberOfDataSets == 0)
@@ -1422,6 +1553,7 @@ void vtkPVDataInformation::CopyToStream(vtkClientServerStream* css)
   *css << vtkClientServerStream::InsertArray(data, static_cast<int>(length));
 
   *css << vtkClientServerStream::InsertArray(this->TimeSpan, 2);
+  *css << this->IsCompact;
 
   *css << vtkClientServerStream::End;
 }
@@ -1712,6 +1844,12 @@ void vtkPVDataInformation::CopyFromStream(const vtkClientServerStream* css)
     return;
   }
 
+  if (!CSS_GET_NEXT_ARGUMENT(css, 0, &this->IsCompact))
+  {
+    vtkErrorMacro("Error parsing compact flag.");
+    return;
+  }
+
   CSS_ARGUMENT_END();
 }
 
@@ -76,6 +76,32 @@ public:
   vtkGetMacro(PortNumber, int);
   //@}
 
+  //@{
+  /**
+   * When non-zero, information is gathered only for the node with the given
+   * flat (composite) index in a composite dataset rather than for the whole
+   * dataset. This is used to fetch details for blocks of composite datasets
+   * whose information was gathered in compact form.
+   * Default is 0 i.e. the whole dataset.
+   */
+  vtkSetMacro(CompositeIndex, unsigned int);
+  vtkGetMacro(CompositeIndex, unsigned int);
+  //@}
+
+  //@{
+  /**
+   * For composite datasets with more leaf nodes (empty or not) than this
+   * threshold, the information for individual blocks is kept in compact form:
+   * block types, names and counts are preserved while attribute arrays are
+   * dropped, since the union of all arrays is already available on the
+   * information for the whole dataset. Use GetIsCompact() to check if a block's information is
+   * compact and gather it with CompositeIndex set to get the details.
+   * Negative values disable compaction. Default is 10000.
+   */
+  vtkSetMacro(CompactCompositeThreshold, int);
+  vtkGetMacro(CompactCompositeThreshold, int);
+  //@}
+
   /**
    * Transfer information about a single object into this object.
    */
@@ -291,6 +317,12 @@ public:
   vtkGetStringMacro(CompositeDataSetName);
   //@}
 
+  /**
+   * Returns true if this information was gathered in compact form i.e. it
+   * lacks attribute arrays information. See CompactCompositeThreshold.
+   */
+  vtkGetMacro(IsCompact, bool);
+
   /**
    * Allows run time addition of information getters for new classes
    */
@@ -314,6 +346,11 @@ protected:
   void CopyFromSelection(vtkSelection* selection);
   void CopyCommonMetaData(vtkDataObject*, vtkInformation*);
 
+  /**
+   * Drops attribute arrays information and marks this information as compact.
+   */
+  void ClearDetails();
+
   static vtkPVDataInformationHelper* FindHelper(const char* classname);
 
   // Data information collected from remote processes.
@@ -337,6 +374,7 @@ protected:
   double Time = 0.0;
   int HasTime = 0;
   int NumberOfTimeSteps = 0;
+  bool IsCompact = false;
 
   char* DataClassName = nullptr;
   vtkSetStringMacro(DataClassName);
@@ -369,6 +407,8 @@ private:
   void operator=(const vtkPVDataInformation&) = delete;
 
   int PortNumber = -1;
+  unsigned int CompositeIndex = 0;
+  int CompactCompositeThreshold = 10000;
 };
 
 #endif
@@ -15,6 +15,7 @@
 
 #include "vtkLogger.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
 #include "vtkPVOptionsXMLParser.h"
 #include "vtkProcessModule.h"
 
@@ -385,26 +386,34 @@ static void UpdateThreadName()
   {
     tname_suffix = "." + std::to_string(pm->GetPartitionId());
   }
+  std::string tname;
   switch (vtkProcessModule::GetProcessType())
   {
     case vtkProcessModule::PROCESS_CLIENT:
-      vtkLogger::SetThreadName("paraview" + tname_suffix);
+      tname = "paraview" + tname_suffix;
       break;
     case vtkProcessModule::PROCESS_SERVER:
-      vtkLogger::SetThreadName("pvserver" + tname_suffix);
+      tname = "pvserver" + tname_suffix;
       break;
     case vtkProcessModule::PROCESS_DATA_SERVER:
-      vtkLogger::SetThreadName("pvdatserver" + tname_suffix);
+      tname = "pvdatserver" + tname_suffix;
       break;
     case vtkProcessModule::PROCESS_RENDER_SERVER:
-      vtkLogger::SetThreadName("pvrenderserver" + tname_suffix);
+      tname = "pvrenderserver" + tname_suffix;
       break;
     case vtkProcessModule::PROCESS_BATCH:
-      vtkLogger::SetThreadName("pvbatch" + tname_suffix);
+      tname = "pvbatch" + tname_suffix;
       break;
     default:
-      break;
+      return;
   }
+  vtkLogger::SetThreadName(tname);
+
+  // trace events from all processes may end up in the same trace, hence we
+  // need a unique id per process type and rank.
+  const int pid = 100000 * static_cast<int>(vtkProcessModule::GetProcessType()) +
+    pm->GetPartitionId();
+  vtkPVLogger::SetTraceEventsProcess(pid, tname.c_str());
 }
 }
 
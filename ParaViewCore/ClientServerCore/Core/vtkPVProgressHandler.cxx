@@ -27,10 +27,12 @@
 #include "vtkPVOptions.h"
 #include "vtkPVSession.h"
 #include "vtkProcessModule.h"
-#include "vtkTimerLog.h"
 
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <string>
+#include <thread>
 
 // define this variable to disable progress all together. This may be useful to
 // doing really large runs.
@@ -100,10 +102,29 @@ public:
   // between calls to PrepareProgress() and CleanupPendingProgress().
   bool EnableProgress;
 
-  vtkNew<vtkTimerLog> ProgressTimer;
+  // Progress events are dispatched only on the thread that called
+  // PrepareProgress(); events from other threads (e.g. vtkSMPTools workers)
+  // are dropped since observers and controllers are not thread-safe. Atomic
+  // since workers of a previous request may still be reading it while
+  // PrepareProgress() sets it.
+  std::atomic<std::thread::id> OwnerThread;
+
+  // Earliest time (in steady-clock ticks) at which the next progress event may
+  // be reported. Checking this is a single atomic load, so algorithms calling
+  // UpdateProgress() in their inner loops are not throttled by the handler.
+  std::atomic<std::chrono::steady_clock::rep> NextProgressTime;
+
+  // Set on processes whose progress is never reported anywhere, i.e.
+  // satellites of a parallel server. Those skip all progress work. Read by
+  // any thread reporting progress, hence atomic.
+  std::atomic<bool> IgnoreProgress;
+
   vtkInternals()
+    : OwnerThread(std::thread::id())
+    , NextProgressTime(0)
   {
     this->EnableProgress = false;
+    this->IgnoreProgress = false;
 
 #ifdef PV_DISABLE_PROGRESS_HANDLING
     this->DisableProgressHandling = true;
@@ -227,6 +248,14 @@ void vtkPVProgressHandler::PrepareProgress()
 {
   SKIP_IF_DISABLED();
   this->InvokeEvent(vtkCommand::StartEvent, this);
+
+  // Only the root of a parallel server reports progress to the client.
+  vtkMultiProcessController* mpiController = vtkMultiProcessController::GetGlobalController();
+  this->Internals->IgnoreProgress = mpiController &&
+    mpiController->GetNumberOfProcesses() > 1 && mpiController->GetLocalProcessId() > 0 &&
+    this->Session->GetController(vtkPVSession::CLIENT) == nullptr;
+  this->Internals->OwnerThread.store(std::this_thread::get_id());
+  this->Internals->NextProgressTime.store(0, std::memory_order_relaxed);
   this->Internals->EnableProgress = true;
 }
 
@@ -316,21 +345,28 @@ void vtkPVProgressHandler::LocalCleanupPendingProgress()
 void vtkPVProgressHandler::OnProgressEvent(vtkObject* caller, unsigned long eventid, void* calldata)
 {
   SKIP_IF_DISABLED();
-  if (!this->Internals->EnableProgress || eventid != vtkCommand::ProgressEvent)
+  if (!this->Internals->EnableProgress || this->Internals->IgnoreProgress ||
+    eventid != vtkCommand::ProgressEvent)
   {
     return;
   }
 
-  // Try to clamp frequent progress events.
-  this->Internals->ProgressTimer->StopTimer();
-  // cout <<"Elapsed: " << this->Internals->ProgressTimer->GetElapsedTime() <<
-  //  endl;
-  if (this->Internals->ProgressTimer->GetElapsedTime() < this->ProgressInterval)
+  // Try to clamp frequent progress events. Only one thread can win the
+  // exchange for a given interval, and it must be the owner thread.
+  using clock = std::chrono::steady_clock;
+  const auto now = clock::now().time_since_epoch().count();
+  auto next = this->Internals->NextProgressTime.load(std::memory_order_relaxed);
+  if (now < next || std::this_thread::get_id() != this->Internals->OwnerThread.load())
+  {
+    return;
+  }
+  const auto interval = std::chrono::duration_cast<clock::duration>(
+    std::chrono::duration<double>(this->ProgressInterval));
+  if (!this->Internals->NextProgressTime.compare_exchange_strong(
+        next, now + interval.count(), std::memory_order_relaxed))
   {
     return;
   }
-
-  this->Internals->ProgressTimer->StartTimer();
 
   double progress = *reinterpret_cast<double*>(calldata);
   if (progress < 0 || progress > 1.0)
@@ -24,6 +24,12 @@
  * may not faithfully report the progress, this avoid nasty MPI issues that can
  * be painful to debug and diagnose.
  *
+ * Progress events are rate-limited using ProgressInterval. The check is a
+ * single atomic comparison, so algorithms may call UpdateProgress() from tight
+ * loops without being slowed down. Only progress events fired on the thread
+ * that called PrepareProgress() are reported; for threaded algorithms, use
+ * vtkPVProgressAccumulator to accumulate work across threads.
+ *
  * Progress events are currently not supported in multi-clients mode.
  *
  * @par Events:
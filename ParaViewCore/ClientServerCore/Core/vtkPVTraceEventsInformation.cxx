@@ -0,0 +1,119 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTraceEventsInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVTraceEventsInformation.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
+
+vtkStandardNewMacro(vtkPVTraceEventsInformation);
+//----------------------------------------------------------------------------
+vtkPVTraceEventsInformation::vtkPVTraceEventsInformation()
+  : ClearEvents(true)
+{
+  this->RootOnly = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkPVTraceEventsInformation::~vtkPVTraceEventsInformation()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventsInformation::CopyFromObject(vtkObject*)
+{
+  this->Chunks.clear();
+  this->Chunks.push_back(vtkPVLogger::GetTraceEvents(this->ClearEvents));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventsInformation::AddInformation(vtkPVInformation* pvinfo)
+{
+  if (auto other = vtkPVTraceEventsInformation::SafeDownCast(pvinfo))
+  {
+    this->Chunks.insert(this->Chunks.end(), other->Chunks.begin(), other->Chunks.end());
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventsInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << static_cast<int>(this->Chunks.size());
+  for (const auto& chunk : this->Chunks)
+  {
+    *css << chunk.c_str();
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventsInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  this->Chunks.clear();
+
+  int count = 0;
+  if (!css->GetArgument(0, 0, &count))
+  {
+    vtkErrorMacro("Error parsing number of chunks from message.");
+    return;
+  }
+  this->Chunks.reserve(count);
+  for (int cc = 0; cc < count; ++cc)
+  {
+    const char* chunk = nullptr;
+    if (!css->GetArgument(0, cc + 1, &chunk))
+    {
+      vtkErrorMacro("Error parsing trace events from message.");
+      return;
+    }
+    this->Chunks.push_back(chunk ? chunk : "");
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventsInformation::CopyParametersToStream(vtkMultiProcessStream& str)
+{
+  str << 828794 << (this->ClearEvents ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventsInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
+{
+  int magic_number, clear;
+  str >> magic_number >> clear;
+  if (magic_number != 828794)
+  {
+    vtkErrorMacro("Magic number mismatch.");
+  }
+  this->ClearEvents = (clear != 0);
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVTraceEventsInformation::GetChunk(int index) const
+{
+  return (index >= 0 && index < static_cast<int>(this->Chunks.size()))
+    ? this->Chunks[index].c_str()
+    : nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventsInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ClearEvents: " << this->ClearEvents << endl;
+  os << indent << "NumberOfChunks: " << this->Chunks.size() << endl;
+}
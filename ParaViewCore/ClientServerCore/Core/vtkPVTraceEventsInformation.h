@@ -0,0 +1,103 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTraceEventsInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVTraceEventsInformation
+ * @brief   gathers trace events recorded by vtkPVLogger from all processes.
+ *
+ * vtkPVTraceEventsInformation is used to collect trace events recorded using
+ * vtkPVLogger::TraceScope on all ranks. Each rank contributes a single chunk of
+ * comma-separated JSON objects in the Chrome trace-event format (see
+ * vtkPVLogger::GetTraceEvents). Chunks from all ranks are concatenated, in
+ * rank order, when the information is merged.
+ *
+ * @sa vtkPVLogger, vtkSMSession::SaveTraceEvents
+ */
+
+#ifndef vtkPVTraceEventsInformation_h
+#define vtkPVTraceEventsInformation_h
+
+#include "vtkPVClientServerCoreCoreModule.h" //needed for exports
+#include "vtkPVInformation.h"
+
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class VTKPVCLIENTSERVERCORECORE_EXPORT vtkPVTraceEventsInformation : public vtkPVInformation
+{
+public:
+  static vtkPVTraceEventsInformation* New();
+  vtkTypeMacro(vtkPVTraceEventsInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * When set to true (default), events are cleared on each of the processes
+   * once they have been collected. This must be set before calling
+   * GatherInformation().
+   */
+  vtkSetMacro(ClearEvents, bool);
+  vtkGetMacro(ClearEvents, bool);
+  vtkBooleanMacro(ClearEvents, bool);
+  //@}
+
+  /**
+   * Transfer information about a single object into this object. The object
+   * is ignored, and events recorded by the local process are used.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  //@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  //@}
+
+  //@{
+  /**
+   * Serialize/Deserialize the parameters that control how/what information is
+   * gathered.
+   */
+  void CopyParametersToStream(vtkMultiProcessStream&) override;
+  void CopyParametersFromStream(vtkMultiProcessStream&) override;
+  //@}
+
+  //@{
+  /**
+   * Access the collected events, one chunk per process.
+   */
+  int GetNumberOfChunks() const { return static_cast<int>(this->Chunks.size()); }
+  const char* GetChunk(int index) const;
+  //@}
+
+protected:
+  vtkPVTraceEventsInformation();
+  ~vtkPVTraceEventsInformation() override;
+
+  bool ClearEvents;
+  std::vector<std::string> Chunks;
+
+private:
+  vtkPVTraceEventsInformation(const vtkPVTraceEventsInformation&) = delete;
+  void operator=(const vtkPVTraceEventsInformation&) = delete;
+};
+
+#endif
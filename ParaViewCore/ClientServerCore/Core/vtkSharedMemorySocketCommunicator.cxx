@@ -0,0 +1,421 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkSharedMemorySocketCommunicator.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSharedMemorySocketCommunicator.h"
+
+#include "vtkDataArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdio>
+#include <cstring>
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#define VTK_SHARED_MEMORY_SUPPORTED 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Messages of at least this many bytes go through shared memory. Must be the
+// same on both ends of the connection.
+const vtkIdType vtkSharedMemoryThreshold = 1 << 20;
+
+// Size of the message sent through the socket in place of a message of at
+// least vtkSharedMemoryThreshold bytes: the size of the message, how the
+// message is sent, and for segments the null terminated name of the segment.
+const int vtkSharedMemoryDescriptorSize = 1024;
+const size_t vtkSharedMemoryModeOffset = sizeof(vtkTypeUInt64);
+const size_t vtkSharedMemoryNameOffset = vtkSharedMemoryModeOffset + 1;
+
+// How a large message is sent: through a segment, or through the socket
+// right after the descriptor when the segment could not be written.
+const char vtkSharedMemoryInline = 0;
+const char vtkSharedMemorySegment = 1;
+
+// Tag used by NegotiateSharedMemory().
+const int vtkSharedMemoryNegotiationTag = 99992;
+
+#if VTK_SHARED_MEMORY_SUPPORTED
+// Prefix of the names of all segments.
+const char vtkSharedMemoryPrefix[] = "pvshm-";
+
+bool vtkSharedMemoryEnabled()
+{
+  return !vtksys::SystemTools::HasEnv("PV_DISABLE_SHARED_MEMORY");
+}
+
+std::string vtkSharedMemoryDirectory()
+{
+  std::string directory;
+  if (!vtksys::SystemTools::GetEnv("PV_SHARED_MEMORY_DIRECTORY", directory))
+  {
+    if (vtksys::SystemTools::FileIsDirectory("/dev/shm"))
+    {
+      directory = "/dev/shm";
+    }
+    else if (!vtksys::SystemTools::GetEnv("TMPDIR", directory))
+    {
+      directory = "/tmp";
+    }
+  }
+  return directory;
+}
+
+// Returns the name of a new segment. Only the name is sent to the other end.
+std::string vtkSharedMemoryNewSegmentName()
+{
+  static unsigned int counter = 0;
+  char name[64];
+  snprintf(name, sizeof(name), "%s%lx-%x-%08x", vtkSharedMemoryPrefix,
+    static_cast<unsigned long>(getpid()), ++counter,
+    static_cast<unsigned int>(vtkTimerLog::GetUniversalTime() * 1e6));
+  return name;
+}
+
+// Returns true if `name` could have been returned by
+// vtkSharedMemoryNewSegmentName(). Names received from the other end are
+// checked with this before being looked up in the segment directory, so that
+// they cannot designate any other file.
+bool vtkSharedMemoryIsSegmentName(const std::string& name)
+{
+  const size_t prefix = sizeof(vtkSharedMemoryPrefix) - 1;
+  if (name.size() <= prefix || name.size() >= 64 ||
+    name.compare(0, prefix, vtkSharedMemoryPrefix) != 0)
+  {
+    return false;
+  }
+  for (size_t cc = prefix; cc < name.size(); ++cc)
+  {
+    const char c = name[cc];
+    if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || c == '-'))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string vtkSharedMemoryPath(const std::string& name)
+{
+  return vtkSharedMemoryDirectory() + "/" + name;
+}
+
+// Writes `size` bytes to a new segment.
+bool vtkSharedMemoryWrite(const std::string& path, const void* data, size_t size)
+{
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+  if (fd < 0)
+  {
+    return false;
+  }
+#if defined(__APPLE__)
+  bool success = ftruncate(fd, static_cast<off_t>(size)) == 0;
+#else
+  // Allocate the pages up front: with ftruncate() alone, running out of space
+  // (e.g. on a small tmpfs) raises SIGBUS while writing through the mapping.
+  bool success = size > 0 && posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0;
+#endif
+  if (success && size > 0)
+  {
+    void* segment = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    success = segment != MAP_FAILED;
+    if (success)
+    {
+      memcpy(segment, data, size);
+      munmap(segment, size);
+    }
+  }
+  close(fd);
+  if (!success)
+  {
+    unlink(path.c_str());
+  }
+  return success;
+}
+
+// Reads `size` bytes from the segment, which is then removed. Only regular
+// files of the expected size owned by this user are read and removed.
+bool vtkSharedMemoryRead(const std::string& path, void* data, size_t size)
+{
+  int fd = open(path.c_str(), O_RDONLY | O_NOFOLLOW);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat info;
+  bool success = fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_uid == getuid() &&
+    static_cast<size_t>(info.st_size) == size;
+  if (success)
+  {
+    unlink(path.c_str());
+  }
+  if (success && size > 0)
+  {
+    void* segment = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    success = segment != MAP_FAILED;
+    if (success)
+    {
+      memcpy(data, segment, size);
+      munmap(segment, size);
+    }
+  }
+  close(fd);
+  return success;
+}
+#endif
+}
+
+vtkStandardNewMacro(vtkSharedMemorySocketCommunicator);
+//----------------------------------------------------------------------------
+vtkSharedMemorySocketCommunicator::vtkSharedMemorySocketCommunicator()
+{
+  this->UseSharedMemory = false;
+}
+
+//----------------------------------------------------------------------------
+vtkSharedMemorySocketCommunicator::~vtkSharedMemorySocketCommunicator()
+{
+#if VTK_SHARED_MEMORY_SUPPORTED
+  // remove segments the other end never received.
+  for (const auto& path : this->SentSegments)
+  {
+    unlink(path.c_str());
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool vtkSharedMemorySocketCommunicator::NegotiateSharedMemory(bool server_side)
+{
+  this->UseSharedMemory = false;
+  const int tag = vtkSharedMemoryNegotiationTag;
+  int accepted = 0;
+
+#if VTK_SHARED_MEMORY_SUPPORTED
+  // The client writes a random token to a probe segment, and the server
+  // checks it can read it back.
+  if (server_side)
+  {
+    int length = 0;
+    if (!this->Receive(&length, 1, 1, tag))
+    {
+      return false;
+    }
+    if (length < 0 || length > vtkSharedMemoryDescriptorSize)
+    {
+      return false;
+    }
+    if (length > 0)
+    {
+      std::vector<char> buffer(length);
+      if (!this->Receive(&buffer[0], length, 1, tag))
+      {
+        return false;
+      }
+      // buffer holds the segment name and the token, both null terminated.
+      buffer.push_back('\0');
+      const std::string name(&buffer[0]);
+      const std::string token(name.size() < buffer.size() - 1 ? &buffer[name.size() + 1] : "");
+      std::vector<char> probe(token.size());
+      accepted = vtkSharedMemoryEnabled() && !token.empty() &&
+        vtkSharedMemoryIsSegmentName(name) &&
+        vtkSharedMemoryRead(vtkSharedMemoryPath(name), probe.data(), probe.size()) &&
+        token.compare(0, token.size(), probe.data(), probe.size()) == 0;
+    }
+    this->Send(&accepted, 1, 1, tag);
+  }
+  else
+  {
+    std::string name, path;
+    char token[32];
+    snprintf(token, sizeof(token), "%08x%08x",
+      static_cast<unsigned int>(reinterpret_cast<size_t>(this)),
+      static_cast<unsigned int>(vtkTimerLog::GetUniversalTime() * 1e6));
+    if (vtkSharedMemoryEnabled())
+    {
+      name = vtkSharedMemoryNewSegmentName();
+      path = vtkSharedMemoryPath(name);
+      if (!vtkSharedMemoryWrite(path, token, strlen(token)))
+      {
+        path.clear();
+      }
+    }
+    std::string buffer;
+    if (!path.empty())
+    {
+      buffer = name;
+      buffer.push_back('\0');
+      buffer += token;
+      buffer.push_back('\0');
+    }
+    int length = static_cast<int>(buffer.size());
+    bool success = this->Send(&length, 1, 1, tag) != 0;
+    if (success && length > 0)
+    {
+      success = this->Send(buffer.c_str(), length, 1, tag) != 0;
+    }
+    success = success && this->Receive(&accepted, 1, 1, tag) != 0;
+    if (!path.empty())
+    {
+      // no-op if the server read it.
+      unlink(path.c_str());
+    }
+    if (!success)
+    {
+      return false;
+    }
+  }
+#else
+  // Tell the other end we cannot use shared memory.
+  if (server_side)
+  {
+    int length = 0;
+    if (!this->Receive(&length, 1, 1, tag) || length < 0 || length > vtkSharedMemoryDescriptorSize)
+    {
+      return false;
+    }
+    if (length > 0)
+    {
+      std::vector<char> buffer(length);
+      this->Receive(&buffer[0], length, 1, tag);
+    }
+    this->Send(&accepted, 1, 1, tag);
+  }
+  else
+  {
+    int length = 0;
+    if (!this->Send(&length, 1, 1, tag) || !this->Receive(&accepted, 1, 1, tag))
+    {
+      return false;
+    }
+    accepted = 0;
+  }
+#endif
+
+  this->UseSharedMemory = accepted != 0;
+  return this->UseSharedMemory;
+}
+
+//----------------------------------------------------------------------------
+int vtkSharedMemorySocketCommunicator::SendVoidArray(
+  const void* data, vtkIdType length, int type, int remoteHandle, int tag)
+{
+#if VTK_SHARED_MEMORY_SUPPORTED
+  const vtkIdType size = length * vtkDataArray::GetDataTypeSize(type);
+  if (this->UseSharedMemory && size >= vtkSharedMemoryThreshold)
+  {
+    char descriptor[vtkSharedMemoryDescriptorSize];
+    memset(descriptor, 0, sizeof(descriptor));
+    const vtkTypeUInt64 size64 = static_cast<vtkTypeUInt64>(size);
+    memcpy(descriptor, &size64, sizeof(size64));
+
+    const std::string name = vtkSharedMemoryNewSegmentName();
+    const std::string path = vtkSharedMemoryPath(name);
+    const bool shared = vtkSharedMemoryWrite(path, data, static_cast<size_t>(size));
+    if (shared)
+    {
+      descriptor[vtkSharedMemoryModeOffset] = vtkSharedMemorySegment;
+      memcpy(descriptor + vtkSharedMemoryNameOffset, name.c_str(), name.size());
+      this->SentSegments.push_back(path);
+      if (this->SentSegments.size() > 1024)
+      {
+        // forget about the segments already received.
+        std::vector<std::string> remaining;
+        for (const auto& sent : this->SentSegments)
+        {
+          if (vtksys::SystemTools::FileExists(sent))
+          {
+            remaining.push_back(sent);
+          }
+        }
+        this->SentSegments.swap(remaining);
+      }
+    }
+    else
+    {
+      // e.g. the segment directory is full: send the message through the
+      // socket instead.
+      descriptor[vtkSharedMemoryModeOffset] = vtkSharedMemoryInline;
+      vtkDebugMacro("Sending message inline, failed to write segment " << path.c_str());
+    }
+
+    if (!this->Superclass::SendVoidArray(
+          descriptor, vtkSharedMemoryDescriptorSize, VTK_CHAR, remoteHandle, tag))
+    {
+      return 0;
+    }
+    return shared ? 1 : this->Superclass::SendVoidArray(data, length, type, remoteHandle, tag);
+  }
+#endif
+  return this->Superclass::SendVoidArray(data, length, type, remoteHandle, tag);
+}
+
+//----------------------------------------------------------------------------
+int vtkSharedMemorySocketCommunicator::ReceiveVoidArray(
+  void* data, vtkIdType length, int type, int remoteHandle, int tag)
+{
+#if VTK_SHARED_MEMORY_SUPPORTED
+  const vtkIdType size = length * vtkDataArray::GetDataTypeSize(type);
+  if (this->UseSharedMemory && size >= vtkSharedMemoryThreshold)
+  {
+    char descriptor[vtkSharedMemoryDescriptorSize];
+    if (!this->Superclass::ReceiveVoidArray(
+          descriptor, vtkSharedMemoryDescriptorSize, VTK_CHAR, remoteHandle, tag))
+    {
+      return 0;
+    }
+    vtkTypeUInt64 size64;
+    memcpy(&size64, descriptor, sizeof(size64));
+    if (size64 != static_cast<vtkTypeUInt64>(size))
+    {
+      vtkErrorMacro("Unexpected size of shared memory message: " << size64);
+      return 0;
+    }
+    if (descriptor[vtkSharedMemoryModeOffset] == vtkSharedMemoryInline)
+    {
+      return this->Superclass::ReceiveVoidArray(data, length, type, remoteHandle, tag);
+    }
+
+    descriptor[vtkSharedMemoryDescriptorSize - 1] = '\0';
+    const std::string name(descriptor + vtkSharedMemoryNameOffset);
+    if (descriptor[vtkSharedMemoryModeOffset] != vtkSharedMemorySegment ||
+      !vtkSharedMemoryIsSegmentName(name))
+    {
+      vtkErrorMacro("Invalid shared memory segment name.");
+      return 0;
+    }
+    const std::string path = vtkSharedMemoryPath(name);
+    if (!vtkSharedMemoryRead(path, data, static_cast<size_t>(size)))
+    {
+      vtkErrorMacro("Failed to read shared memory segment " << path.c_str());
+      return 0;
+    }
+    return 1;
+  }
+#endif
+  return this->Superclass::ReceiveVoidArray(data, length, type, remoteHandle, tag);
+}
+
+//----------------------------------------------------------------------------
+void vtkSharedMemorySocketCommunicator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseSharedMemory: " << this->UseSharedMemory << endl;
+}
@@ -0,0 +1,100 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkSharedMemorySocketCommunicator.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSharedMemorySocketCommunicator
+ * @brief   socket communicator handing large messages over through shared memory.
+ *
+ * vtkSharedMemorySocketCommunicator is a vtkSocketCommunicator that, once
+ * NegotiateSharedMemory() has established that both ends of the connection run
+ * on the same host, writes messages of 1 MiB or more to a memory-mapped segment
+ * and only sends the name of the segment through the socket. The receiving end
+ * copies the message out of the segment and removes it. This avoids pushing
+ * large messages (geometry, images) through the TCP stack when the client and
+ * the server run on the same host.
+ *
+ * Both ends decide whether a message goes through shared memory from its size
+ * alone. This works since messages must be received with the exact length
+ * they were sent with.
+ *
+ * Segments are created in the directory given by the
+ * PV_SHARED_MEMORY_DIRECTORY environment variable, /dev/shm if it exists, or
+ * the temporary directory. Only the name of a segment is sent: the receiving
+ * end looks it up in its own segment directory, and only accepts names
+ * following the pattern of the names it generates and regular files owned by
+ * the same user. When a segment cannot be written, e.g. when the directory is
+ * full, the message is sent through the socket after all. Shared memory is
+ * not used on Windows, nor when the PV_DISABLE_SHARED_MEMORY environment
+ * variable is set.
+ *
+ * @sa
+ * vtkTCPNetworkAccessManager
+ */
+
+#ifndef vtkSharedMemorySocketCommunicator_h
+#define vtkSharedMemorySocketCommunicator_h
+
+#include "vtkPVClientServerCoreCoreModule.h" //needed for exports
+#include "vtkSocketCommunicator.h"
+
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class VTKPVCLIENTSERVERCORECORE_EXPORT vtkSharedMemorySocketCommunicator
+  : public vtkSocketCommunicator
+{
+public:
+  static vtkSharedMemorySocketCommunicator* New();
+  vtkTypeMacro(vtkSharedMemorySocketCommunicator, vtkSocketCommunicator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Checks whether the other end of the connection can read segments created
+   * by this end and enables shared memory if it can. Must be called by both
+   * ends once the connection is established, with `server_side` set on exactly
+   * one of them. Returns true if shared memory is used.
+   */
+  bool NegotiateSharedMemory(bool server_side);
+
+  /**
+   * Returns true if messages of 1 MiB or more go through shared memory.
+   */
+  vtkGetMacro(UseSharedMemory, bool);
+
+  //@{
+  /**
+   * Overridden to send or receive large messages through shared memory.
+   */
+  int SendVoidArray(
+    const void* data, vtkIdType length, int type, int remoteHandle, int tag) override;
+  int ReceiveVoidArray(
+    void* data, vtkIdType length, int type, int remoteHandle, int tag) override;
+  //@}
+
+protected:
+  vtkSharedMemorySocketCommunicator();
+  ~vtkSharedMemorySocketCommunicator() override;
+
+  bool UseSharedMemory;
+
+  // Segments sent to the other end. They are removed by the other end once
+  // received, the remaining ones are removed on destruction.
+  std::vector<std::string> SentSegments;
+
+private:
+  vtkSharedMemorySocketCommunicator(const vtkSharedMemorySocketCommunicator&) = delete;
+  void operator=(const vtkSharedMemorySocketCommunicator&) = delete;
+};
+
+#endif
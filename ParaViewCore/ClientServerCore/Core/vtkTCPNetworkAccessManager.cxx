@@ -18,6 +18,7 @@
 #include "vtkCommand.h"
 #include "vtkObjectFactory.h"
 #include "vtkServerSocket.h"
+#include "vtkSharedMemorySocketCommunicator.h"
 #include "vtkSmartPointer.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
@@ -403,7 +404,9 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::ConnectToRemote(
   }
 
   vtkSocketController* controller = vtkSocketController::New();
-  vtkSocketCommunicator* comm = vtkSocketCommunicator::SafeDownCast(controller->GetCommunicator());
+  vtkSharedMemorySocketCommunicator* comm = vtkSharedMemorySocketCommunicator::New();
+  controller->SetCommunicator(comm);
+  comm->FastDelete();
 #if GENERATE_DEBUG_LOG
   std::ostringstream mystr;
   mystr << "/tmp/client." << getpid() << ".log";
@@ -419,6 +422,8 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::ConnectToRemote(
     this->PrintHandshakeError(errorcode, false);
     return NULL;
   }
+  // large messages go through shared memory if the server runs on this host.
+  comm->NegotiateSharedMemory(false);
   this->Internals->Controllers.push_back(controller);
   return controller;
 }
@@ -478,8 +483,9 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::WaitForConnection(
     }
 
     controller = vtkSocketController::New();
-    vtkSocketCommunicator* comm =
-      vtkSocketCommunicator::SafeDownCast(controller->GetCommunicator());
+    vtkSharedMemorySocketCommunicator* comm = vtkSharedMemorySocketCommunicator::New();
+    controller->SetCommunicator(comm);
+    comm->FastDelete();
     comm->SetSocket(client_socket);
     client_socket->FastDelete();
     int errorcode = HANDSHAKE_SOCKET_COMMUNICATOR_DIFFERENT;
@@ -494,6 +500,11 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::WaitForConnection(
         break;
       }
     }
+    else
+    {
+      // large messages go through shared memory if the client runs on this host.
+      comm->NegotiateSharedMemory(true);
+    }
   }
 
   if (controller)
@@ -63,6 +63,7 @@
 #include "vtkPVSynchronizedRenderer.h"
 #include "vtkPVTemporalDataInformation.h"
 #include "vtkPVTimerInformation.h"
+#include "vtkPVTraceEventsInformation.h"
 #include "vtkPVView.h"
 #include "vtkPVXYChartView.h"
 #include "vtkProcessModule.h"
@@ -154,6 +155,7 @@ int ParaViewCoreClientServerCorePrintSelf(int, char* [])
   // PRINT_SELF(vtkPVSynchronizedRenderer);
   PRINT_SELF(vtkPVTemporalDataInformation);
   PRINT_SELF(vtkPVTimerInformation);
+  PRINT_SELF(vtkPVTraceEventsInformation);
   // PRINT_SELF(vtkPVView);
   // PRINT_SELF(vtkPVXYChartView);
   PRINT_SELF(vtkProcessModule);
@@ -0,0 +1,204 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSharedMemorySocketCommunicator.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkNew.h"
+#include "vtkServerSocket.h"
+#include "vtkSharedMemorySocketCommunicator.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const int TAG = 4242;
+
+// Number of ints in the messages exchanged: below, at and above the 1 MiB
+// threshold above which messages go through shared memory.
+const vtkIdType Lengths[] = { 1000, (1 << 18) - 1, 1 << 18, (3 << 18) + 5 };
+
+std::vector<int> MakeMessage(vtkIdType length)
+{
+  std::vector<int> message(length);
+  for (vtkIdType cc = 0; cc < length; ++cc)
+  {
+    message[cc] = static_cast<int>(cc * 7 + length);
+  }
+  return message;
+}
+
+// Echoes every message back.
+void RunEchoClient(int port, bool* negotiated)
+{
+  vtkNew<vtkSharedMemorySocketCommunicator> comm;
+  if (!comm->ConnectTo("localhost", port))
+  {
+    return;
+  }
+  *negotiated = comm->NegotiateSharedMemory(false);
+  for (int round = 0; round < 2; ++round)
+  {
+    for (vtkIdType length : Lengths)
+    {
+      std::vector<int> message(length);
+      if (!comm->Receive(message.data(), length, 1, TAG) ||
+        !comm->Send(message.data(), length, 1, TAG))
+      {
+        return;
+      }
+    }
+  }
+  comm->CloseConnection();
+}
+
+// Negotiates shared memory like vtkSharedMemorySocketCommunicator does, then
+// sends a descriptor naming a file outside of the segment directory.
+void RunHostileClient(int port, const std::string& directory)
+{
+  vtkNew<vtkSocketCommunicator> comm;
+  if (!comm->ConnectTo("localhost", port))
+  {
+    return;
+  }
+  const char name[] = "pvshm-1-2-3";
+  std::ofstream(directory + "/" + name) << "token";
+  const char buffer[] = "pvshm-1-2-3\0token";
+  int length = static_cast<int>(sizeof(buffer));
+  int accepted = 0;
+  comm->Send(&length, 1, 1, 99992);
+  comm->Send(buffer, length, 1, 99992);
+  comm->Receive(&accepted, 1, 1, 99992);
+
+  char descriptor[1024];
+  memset(descriptor, 0, sizeof(descriptor));
+  const vtkTypeUInt64 size = (1 << 18) * sizeof(int);
+  memcpy(descriptor, &size, sizeof(size));
+  descriptor[sizeof(size)] = 1;
+  strcpy(descriptor + sizeof(size) + 1, "../victim");
+  comm->Send(descriptor, static_cast<vtkIdType>(sizeof(descriptor)), 1, TAG);
+  comm->CloseConnection();
+}
+
+bool Accept(vtkServerSocket* server, vtkSocketCommunicator* comm)
+{
+  return comm->WaitForConnection(server, 60000) != 0;
+}
+
+bool RoundTrip(vtkSocketCommunicator* comm)
+{
+  for (vtkIdType length : Lengths)
+  {
+    const std::vector<int> message = MakeMessage(length);
+    std::vector<int> echo(length);
+    if (!comm->Send(message.data(), length, 1, TAG) ||
+      !comm->Receive(echo.data(), length, 1, TAG) || echo != message)
+    {
+      std::cerr << "Failed to round trip a message of " << length << " ints." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestSharedMemorySocketCommunicator(int, char* [])
+{
+  vtksys::SystemTools::UnPutEnv("PV_DISABLE_SHARED_MEMORY");
+  const std::string directory =
+    vtksys::SystemTools::GetCurrentWorkingDirectory() + "/TestSharedMemorySocketCommunicator";
+  vtksys::SystemTools::RemoveADirectory(directory);
+  vtksys::SystemTools::MakeDirectory(directory + "/segments");
+  vtksys::SystemTools::PutEnv("PV_SHARED_MEMORY_DIRECTORY=" + directory + "/segments");
+
+  vtkNew<vtkServerSocket> server;
+  if (server->CreateServer(0) != 0)
+  {
+    std::cerr << "Failed to create a server socket." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const int port = server->GetServerPort();
+  bool success = true;
+
+  // Messages of all sizes make it through, first through shared memory, then
+  // through the socket when segments cannot be written.
+  {
+    bool clientNegotiated = false;
+    std::thread client(RunEchoClient, port, &clientNegotiated);
+    vtkNew<vtkSharedMemorySocketCommunicator> comm;
+    if (Accept(server, comm))
+    {
+      const bool negotiated = comm->NegotiateSharedMemory(true);
+#if !defined(_WIN32) || defined(__CYGWIN__)
+      if (!negotiated)
+      {
+        std::cerr << "Shared memory was not negotiated." << std::endl;
+        success = false;
+      }
+#endif
+      success &= RoundTrip(comm);
+      vtksys::SystemTools::PutEnv("PV_SHARED_MEMORY_DIRECTORY=" + directory + "/missing");
+      success &= RoundTrip(comm);
+      vtksys::SystemTools::PutEnv("PV_SHARED_MEMORY_DIRECTORY=" + directory + "/segments");
+      success &= negotiated == clientNegotiated;
+    }
+    else
+    {
+      std::cerr << "Failed to accept the connection." << std::endl;
+      success = false;
+    }
+    client.join();
+    comm->CloseConnection();
+  }
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  // Names sent by the other end cannot designate files outside of the segment
+  // directory.
+  {
+    const std::string victim = directory + "/victim";
+    std::ofstream(victim) << "keep";
+    std::thread client(RunHostileClient, port, directory + "/segments");
+    vtkNew<vtkSharedMemorySocketCommunicator> comm;
+    if (Accept(server, comm) && comm->NegotiateSharedMemory(true))
+    {
+      std::vector<int> message(1 << 18);
+      if (comm->Receive(message.data(), static_cast<vtkIdType>(message.size()), 1, TAG))
+      {
+        std::cerr << "A segment outside of the segment directory was accepted." << std::endl;
+        success = false;
+      }
+    }
+    else
+    {
+      std::cerr << "Failed to set up the connection." << std::endl;
+      success = false;
+    }
+    client.join();
+    comm->CloseConnection();
+    if (!vtksys::SystemTools::FileExists(victim))
+    {
+      std::cerr << "A file outside of the segment directory was removed." << std::endl;
+      success = false;
+    }
+  }
+#endif
+
+  server->CloseSocket();
+  vtksys::SystemTools::RemoveADirectory(directory);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -233,6 +233,8 @@ vtkSmartPointer<vtkDataObject> vtkChartRepresentation::ReduceDataToRoot(vtkDataO
   vtkNew<vtkReductionFilter> reductionFilter;
   vtkNew<vtkPVMergeTablesMultiBlock> algo;
   reductionFilter->SetPostGatherHelper(algo.GetPointer());
+  // merging tables is associative.
+  reductionFilter->TreeReductionOn();
   reductionFilter->SetInputConnection(preprocessor->GetOutputPort());
   reductionFilter->Update();
 
@@ -32,7 +32,8 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
 
-#include <sstream>
+#include <string>
+#include <vector>
 
 vtkStandardNewMacro(vtkClientServerMoveData);
 vtkCxxSetObjectMacro(vtkClientServerMoveData, Controller, vtkMultiProcessController);
@@ -186,11 +187,10 @@ int vtkClientServerMoveData::RequestData(
 int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessController* controller)
 {
   // This is a server root node.
-  // If it is a selection, use the XML serializer.
+  // If it is a selection, use the selection serializer.
   // Otherwise, use the communicator.
   if (this->OutputDataType == VTK_SELECTION)
   {
-    // Convert to XML.
     vtkSelection* sel = vtkSelection::SafeDownCast(input);
     if (!sel)
     {
@@ -199,15 +199,15 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
     }
     else
     {
-      std::ostringstream res;
-      vtkSelectionSerializer::PrintXML(res, vtkIndent(), 1, sel);
+      std::string res;
+      vtkSelectionSerializer::SaveBinary(res, sel);
 
-      // Send the size of the string.
-      int size = static_cast<int>(res.str().size());
+      // Send the size of the buffer.
+      int size = static_cast<int>(res.size());
       controller->Send(&size, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
-      // Send the XML string.
+      // Send the serialized selection.
       return controller->Send(
-        res.str().c_str(), size, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+        res.c_str(), size, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
     }
   }
 
@@ -220,22 +220,22 @@ vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* c
   vtkDataObject* data = NULL;
   if (this->OutputDataType == VTK_SELECTION)
   {
-    // Get the size of the string.
+    // Get the size of the buffer.
     int size = 0;
     controller->Receive(&size, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
     if (size == 0)
     {
       return NULL;
     }
-    char* xml = new char[size + 1];
-    // Get the string itself.
-    controller->Receive(xml, size, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
-    xml[size] = 0;
+    std::vector<char> buffer(size);
+    // Get the serialized selection itself.
+    controller->Receive(&buffer[0], size, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
 
-    // Parse the XML.
     vtkSelection* sel = vtkSelection::New();
-    vtkSelectionSerializer::Parse(xml, sel);
-    delete[] xml;
+    if (!vtkSelectionSerializer::LoadBinary(&buffer[0], buffer.size(), sel))
+    {
+      vtkErrorMacro("Failed to parse the selection received.");
+    }
     data = sel;
   }
   else
@@ -16,13 +16,19 @@
 #include "vtkGeometryRepresentationInternal.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkAppendPolyData.h"
 #include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCamera.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkCommand.h"
 #include "vtkCompositeDataDisplayAttributes.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositePolyDataMapper2.h"
+#include "vtkDataObjectTreeIterator.h"
 #include "vtkHyperTreeGrid.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -40,6 +46,8 @@
 #include "vtkPVTrivialProducer.h"
 #include "vtkPVUpdateSuppressor.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkProperty.h"
 #include "vtkRenderer.h"
@@ -48,7 +56,9 @@
 #include "vtkSelectionConverter.h"
 #include "vtkSelectionNode.h"
 #include "vtkShaderProperty.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingPriorityQueue.h"
 #include "vtkTexture.h"
 #include "vtkTransform.h"
 #include "vtkUnstructuredGrid.h"
@@ -60,8 +70,13 @@
 #include <vtk_jsoncpp.h>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <set>
 #include <tuple>
 #include <vector>
 
@@ -105,6 +120,492 @@ protected:
 };
 vtkStandardNewMacro(vtkGeometryRepresentationMultiBlockMaker);
 
+//*****************************************************************************
+namespace vtkGeometryRepresentation_detail
+{
+// Decimated geometry for each level of the LOD pyramid. Level 0 is the
+// coarsest while the last level uses the maximum LOD resolution. Levels are
+// only valid for the data object they were generated from.
+class LODPyramid
+{
+public:
+  std::vector<vtkSmartPointer<vtkDataObject> > Levels;
+  vtkDataObject* Input = nullptr;
+  vtkMTimeType InputTime = 0;
+
+  void Reset(vtkDataObject* input, int numLevels)
+  {
+    this->Levels.clear();
+    this->Levels.resize(numLevels);
+    this->Input = input;
+    this->InputTime = input ? input->GetMTime() : 0;
+  }
+
+  bool IsValid(vtkDataObject* input, int numLevels) const
+  {
+    return this->Input == input && input != nullptr && this->InputTime == input->GetMTime() &&
+      static_cast<int>(this->Levels.size()) == numLevels;
+  }
+
+  static double GetLODFactor(int level, int numLevels)
+  {
+    return numLevels > 1 ? static_cast<double>(level) / (numLevels - 1) : 1.0;
+  }
+};
+
+// Splits the polydata leaves of the geometry into spatial chunks and hands
+// them out in priority order for streaming. The same class is used on the
+// rendering nodes to accumulate the streamed chunks.
+class GeometryStreamer
+{
+public:
+  struct Chunk
+  {
+    // cell ids for each leaf, keyed by the leaf's flat index.
+    std::map<unsigned int, std::vector<vtkIdType> > CellIds;
+    vtkBoundingBox Bounds;
+  };
+
+  vtkSmartPointer<vtkMultiBlockDataSet> Input;
+  std::vector<Chunk> Chunks;
+  vtkStreamingPriorityQueue<> Queue;
+
+  // Chunks delivered up front for the current Input. Popped once per
+  // execution since the delivery manager keeps the first piece it was given
+  // until the representation re-executes.
+  vtkSmartPointer<vtkMultiBlockDataSet> FirstPiece;
+
+  // Data accumulated on the rendering nodes and the delivered data object it
+  // was started from.
+  vtkSmartPointer<vtkMultiBlockDataSet> Accumulated;
+  vtkDataObject* AccumulatedSource = nullptr;
+  vtkMTimeType AccumulatedSourceTime = 0;
+
+  // Streamed leaves not merged into Accumulated yet, keyed by flat index, and
+  // the leaves of Accumulated that are private copies which can be grown in
+  // place.
+  std::map<unsigned int, std::vector<vtkSmartPointer<vtkPolyData> > > Pending;
+  std::set<unsigned int> OwnedLeaves;
+
+  void Reset()
+  {
+    this->Input = nullptr;
+    this->Chunks.clear();
+    this->Queue = vtkStreamingPriorityQueue<>();
+    this->FirstPiece = nullptr;
+  }
+
+  // Starts accumulating streamed pieces on top of the delivered `data`.
+  void ResetAccumulated(vtkDataObject* data)
+  {
+    this->Accumulated.TakeReference(vtkMultiBlockDataSet::New());
+    this->Accumulated->ShallowCopy(data);
+    this->AccumulatedSource = data;
+    this->AccumulatedSourceTime = data->GetMTime();
+    this->Pending.clear();
+    this->OwnedLeaves.clear();
+  }
+
+  bool IsStreaming() const { return !this->Chunks.empty(); }
+
+  static vtkIdType GetNumberOfCells(vtkMultiBlockDataSet* input)
+  {
+    vtkIdType numCells = 0;
+    vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+    iter.TakeReference(input->NewTreeIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+      {
+        numCells += ds->GetNumberOfCells();
+      }
+    }
+    return numCells;
+  }
+
+  // Bins cells of all polydata leaves in `input` into a regular grid of about
+  // `numChunks` chunks using the cell centers.
+  void Initialize(vtkMultiBlockDataSet* input, int numChunks)
+  {
+    this->Reset();
+    double bounds[6];
+    input->GetBounds(bounds);
+    if (!vtkMath::AreBoundsInitialized(bounds))
+    {
+      return;
+    }
+
+    const int res = std::max(1, static_cast<int>(std::cbrt(static_cast<double>(numChunks)) + 0.5));
+    std::vector<Chunk> chunks(res * res * res);
+    vtkNew<vtkIdList> ptIds;
+    vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+    iter.TakeReference(input->NewTreeIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkPolyData* pd = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject());
+      if (pd == nullptr || pd->GetNumberOfCells() == 0)
+      {
+        continue;
+      }
+      const unsigned int flatIndex = iter->GetCurrentFlatIndex();
+      for (vtkIdType cellId = 0, max = pd->GetNumberOfCells(); cellId < max; ++cellId)
+      {
+        pd->GetCellPoints(cellId, ptIds);
+        const vtkIdType npts = ptIds->GetNumberOfIds();
+        if (npts == 0)
+        {
+          continue;
+        }
+        vtkBoundingBox cellBounds;
+        double center[3] = { 0, 0, 0 };
+        for (vtkIdType cc = 0; cc < npts; ++cc)
+        {
+          double pt[3];
+          pd->GetPoint(ptIds->GetId(cc), pt);
+          cellBounds.AddPoint(pt);
+          center[0] += pt[0] / npts;
+          center[1] += pt[1] / npts;
+          center[2] += pt[2] / npts;
+        }
+        int ijk[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          const double length = bounds[2 * axis + 1] - bounds[2 * axis];
+          ijk[axis] = length > 0
+            ? static_cast<int>((center[axis] - bounds[2 * axis]) / length * res)
+            : 0;
+          ijk[axis] = vtkMath::ClampValue(ijk[axis], 0, res - 1);
+        }
+        Chunk& chunk = chunks[(ijk[2] * res + ijk[1]) * res + ijk[0]];
+        chunk.CellIds[flatIndex].push_back(cellId);
+        chunk.Bounds.AddBox(cellBounds);
+      }
+    }
+
+    for (auto& chunk : chunks)
+    {
+      if (!chunk.CellIds.empty())
+      {
+        this->Chunks.push_back(std::move(chunk));
+      }
+    }
+    if (!this->Chunks.empty())
+    {
+      this->Input = input;
+      this->Restart();
+    }
+  }
+
+  // Puts all chunks back in the queue.
+  void Restart()
+  {
+    this->Queue = vtkStreamingPriorityQueue<>();
+    for (size_t cc = 0; cc < this->Chunks.size(); ++cc)
+    {
+      vtkStreamingPriorityQueueItem item;
+      item.Identifier = static_cast<unsigned int>(cc);
+      item.Priority = static_cast<double>(this->Chunks.size() - cc);
+      item.Bounds = this->Chunks[cc].Bounds;
+      this->Queue.push(item);
+    }
+  }
+
+  // Pops up to `count` chunks and returns them as a dataset with the same
+  // structure as the input.
+  vtkSmartPointer<vtkMultiBlockDataSet> Pop(int count)
+  {
+    std::map<unsigned int, std::vector<vtkIdType> > cellIds;
+    for (int cc = 0; cc < count && !this->Queue.empty(); ++cc)
+    {
+      const Chunk& chunk = this->Chunks[this->Queue.top().Identifier];
+      this->Queue.pop();
+      for (const auto& pair : chunk.CellIds)
+      {
+        auto& ids = cellIds[pair.first];
+        ids.insert(ids.end(), pair.second.begin(), pair.second.end());
+      }
+    }
+
+    vtkNew<vtkMultiBlockDataSet> piece;
+    piece->CopyStructure(this->Input);
+    vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+    iter.TakeReference(this->Input->NewTreeIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkPolyData* pd = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject());
+      if (pd == nullptr)
+      {
+        continue;
+      }
+      vtkNew<vtkPolyData> subset;
+      auto ids = cellIds.find(iter->GetCurrentFlatIndex());
+      if (ids != cellIds.end())
+      {
+        // keep cells in input order so cells of different types stay grouped
+        // the way vtkPolyData expects.
+        std::sort(ids->second.begin(), ids->second.end());
+        GeometryStreamer::ExtractCells(pd, ids->second, subset);
+      }
+      piece->SetDataSet(iter, subset);
+    }
+    return piece;
+  }
+
+  // Queues the leaves of a streamed `piece` to be merged into the accumulated
+  // data by Flush().
+  void Append(vtkMultiBlockDataSet* piece)
+  {
+    vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+    iter.TakeReference(piece->NewTreeIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkPolyData* pd = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject());
+      if (pd != nullptr && pd->GetNumberOfCells() > 0)
+      {
+        this->Pending[iter->GetCurrentFlatIndex()].push_back(pd);
+      }
+    }
+  }
+
+  // Merges the queued leaves into the accumulated data. Leaves are grown in
+  // place when their layouts match so that each streamed cell is only copied
+  // once, rather than re-copying the accumulated leaf for every piece.
+  void Flush()
+  {
+    if (this->Pending.empty() || !this->Accumulated)
+    {
+      return;
+    }
+    vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+    iter.TakeReference(this->Accumulated->NewTreeIterator());
+    iter->SkipEmptyNodesOff();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      const unsigned int flatIndex = iter->GetCurrentFlatIndex();
+      auto pending = this->Pending.find(flatIndex);
+      if (pending == this->Pending.end())
+      {
+        continue;
+      }
+      vtkPolyData* current = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject());
+      std::vector<vtkPolyData*> remaining;
+      for (const auto& pd : pending->second)
+      {
+        if (current == nullptr || current->GetNumberOfCells() == 0)
+        {
+          current = pd;
+          this->Accumulated->SetDataSet(iter, current);
+          this->OwnedLeaves.erase(flatIndex);
+          continue;
+        }
+        if (this->OwnedLeaves.count(flatIndex) == 0)
+        {
+          // the leaf is shared with the delivered data or a streamed piece,
+          // copy it once before growing it.
+          vtkNew<vtkPolyData> copy;
+          copy->DeepCopy(current);
+          this->Accumulated->SetDataSet(iter, copy);
+          this->OwnedLeaves.insert(flatIndex);
+          current = copy;
+        }
+        if (!GeometryStreamer::AppendInPlace(current, pd))
+        {
+          remaining.push_back(pd);
+        }
+      }
+      if (!remaining.empty())
+      {
+        vtkNew<vtkAppendPolyData> appender;
+        appender->AddInputData(current);
+        for (vtkPolyData* pd : remaining)
+        {
+          appender->AddInputData(pd);
+        }
+        appender->Update();
+        this->Accumulated->SetDataSet(iter, appender->GetOutputDataObject(0));
+        this->OwnedLeaves.insert(flatIndex);
+      }
+    }
+    this->Pending.clear();
+    this->Accumulated->Modified();
+  }
+
+  // Returns the cell array of `pd` for category 0-3 (verts, lines, polys,
+  // strips), or nullptr if it has no such cells.
+  static vtkCellArray* GetCells(vtkPolyData* pd, int category)
+  {
+    switch (category)
+    {
+      case 0:
+        return pd->GetNumberOfVerts() > 0 ? pd->GetVerts() : nullptr;
+      case 1:
+        return pd->GetNumberOfLines() > 0 ? pd->GetLines() : nullptr;
+      case 2:
+        return pd->GetNumberOfPolys() > 0 ? pd->GetPolys() : nullptr;
+      default:
+        return pd->GetNumberOfStrips() > 0 ? pd->GetStrips() : nullptr;
+    }
+  }
+
+  static bool HaveSameArrays(vtkFieldData* fd1, vtkFieldData* fd2)
+  {
+    if (fd1->GetNumberOfArrays() != fd2->GetNumberOfArrays())
+    {
+      return false;
+    }
+    for (int cc = 0, max = fd1->GetNumberOfArrays(); cc < max; ++cc)
+    {
+      vtkAbstractArray* array1 = fd1->GetAbstractArray(cc);
+      vtkAbstractArray* array2 = fd2->GetAbstractArray(cc);
+      const char* name1 = array1->GetName() ? array1->GetName() : "";
+      const char* name2 = array2->GetName() ? array2->GetName() : "";
+      if (array1->GetDataType() != array2->GetDataType() ||
+        array1->GetNumberOfComponents() != array2->GetNumberOfComponents() ||
+        strcmp(name1, name2) != 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Appends `pd` to the end of `acc`, growing the arrays of `acc`. This is
+  // only possible when the arrays match and the cells of `pd` can follow
+  // those of `acc` without reordering, i.e. `acc` has no cells of a category
+  // that comes after the first category used by `pd`. Returns false if `acc`
+  // was left untouched.
+  static bool AppendInPlace(vtkPolyData* acc, vtkPolyData* pd)
+  {
+    int accLast = -1;
+    int pdFirst = 4;
+    for (int category = 0; category < 4; ++category)
+    {
+      if (GeometryStreamer::GetCells(acc, category))
+      {
+        accLast = category;
+      }
+      if (pdFirst == 4 && GeometryStreamer::GetCells(pd, category))
+      {
+        pdFirst = category;
+      }
+    }
+    if (pdFirst == 4)
+    {
+      return true;
+    }
+    vtkPoints* accPoints = acc->GetPoints();
+    vtkPoints* pdPoints = pd->GetPoints();
+    if (accLast > pdFirst || accPoints == nullptr || pdPoints == nullptr ||
+      accPoints->GetDataType() != pdPoints->GetDataType() ||
+      !GeometryStreamer::HaveSameArrays(acc->GetPointData(), pd->GetPointData()) ||
+      !GeometryStreamer::HaveSameArrays(acc->GetCellData(), pd->GetCellData()))
+    {
+      return false;
+    }
+
+    // the arrays grow geometrically, so the copies are amortized linear.
+    const vtkIdType ptOffset = acc->GetNumberOfPoints();
+    const vtkIdType numPts = pd->GetNumberOfPoints();
+    accPoints->GetData()->InsertTuples(ptOffset, numPts, 0, pdPoints->GetData());
+    accPoints->Modified();
+    for (int cc = 0, max = acc->GetPointData()->GetNumberOfArrays(); cc < max; ++cc)
+    {
+      vtkAbstractArray* array = acc->GetPointData()->GetAbstractArray(cc);
+      array->InsertTuples(ptOffset, numPts, 0, pd->GetPointData()->GetAbstractArray(cc));
+      array->Modified();
+    }
+    const vtkIdType cellOffset = acc->GetNumberOfCells();
+    const vtkIdType numCells = pd->GetNumberOfCells();
+    for (int cc = 0, max = acc->GetCellData()->GetNumberOfArrays(); cc < max; ++cc)
+    {
+      vtkAbstractArray* array = acc->GetCellData()->GetAbstractArray(cc);
+      array->InsertTuples(cellOffset, numCells, 0, pd->GetCellData()->GetAbstractArray(cc));
+      array->Modified();
+    }
+
+    std::vector<vtkIdType> ids;
+    for (int category = pdFirst; category < 4; ++category)
+    {
+      vtkCellArray* source = GeometryStreamer::GetCells(pd, category);
+      if (source == nullptr)
+      {
+        continue;
+      }
+      vtkCellArray* target = GeometryStreamer::GetCells(acc, category);
+      if (target == nullptr)
+      {
+        // GetVerts() and friends return a shared dummy array when empty.
+        vtkNew<vtkCellArray> cells;
+        switch (category)
+        {
+          case 0:
+            acc->SetVerts(cells);
+            break;
+          case 1:
+            acc->SetLines(cells);
+            break;
+          case 2:
+            acc->SetPolys(cells);
+            break;
+          default:
+            acc->SetStrips(cells);
+            break;
+        }
+        target = cells;
+      }
+      vtkIdType npts;
+      vtkIdType* pts;
+      for (source->InitTraversal(); source->GetNextCell(npts, pts);)
+      {
+        ids.resize(npts);
+        for (vtkIdType cc = 0; cc < npts; ++cc)
+        {
+          ids[cc] = pts[cc] + ptOffset;
+        }
+        target->InsertNextCell(npts, ids.data());
+      }
+      target->Modified();
+    }
+    // the cell type and link tables are rebuilt on demand.
+    acc->DeleteCells();
+    acc->Modified();
+    return true;
+  }
+
+  static void ExtractCells(vtkPolyData* input, const std::vector<vtkIdType>& cellIds,
+    vtkPolyData* output)
+  {
+    const vtkIdType numCells = static_cast<vtkIdType>(cellIds.size());
+    vtkNew<vtkPoints> points;
+    points->SetDataType(input->GetPoints()->GetDataType());
+    output->SetPoints(points);
+    output->Allocate(input, numCells);
+    output->GetPointData()->CopyAllocate(input->GetPointData());
+    output->GetCellData()->CopyAllocate(input->GetCellData(), numCells);
+
+    std::vector<vtkIdType> pointMap(input->GetNumberOfPoints(), -1);
+    vtkNew<vtkIdList> ptIds;
+    for (vtkIdType cellId : cellIds)
+    {
+      input->GetCellPoints(cellId, ptIds);
+      for (vtkIdType cc = 0, max = ptIds->GetNumberOfIds(); cc < max; ++cc)
+      {
+        const vtkIdType inPtId = ptIds->GetId(cc);
+        if (pointMap[inPtId] == -1)
+        {
+          pointMap[inPtId] = points->InsertNextPoint(input->GetPoint(inPtId));
+          output->GetPointData()->CopyData(input->GetPointData(), inPtId, pointMap[inPtId]);
+        }
+        ptIds->SetId(cc, pointMap[inPtId]);
+      }
+      const vtkIdType outCellId = output->InsertNextCell(input->GetCellType(cellId), ptIds);
+      output->GetCellData()->CopyData(input->GetCellData(), cellId, outCellId);
+    }
+    output->Squeeze();
+  }
+};
+}
+
 //*****************************************************************************
 
 vtkStandardNewMacro(vtkGeometryRepresentation);
@@ -148,6 +649,12 @@ vtkGeometryRepresentation::vtkGeometryRepresentation()
   this->GeometryFilter = vtkPVGeometryFilter::New();
   this->MultiBlockMaker = vtkGeometryRepresentationMultiBlockMaker::New();
   this->Decimator = vtkGeometryRepresentation_detail::DecimationFilterType::New();
+  this->LODPyramid = new vtkGeometryRepresentation_detail::LODPyramid();
+  this->NumberOfLODLevels = 5;
+  this->Streamer = new vtkGeometryRepresentation_detail::GeometryStreamer();
+  this->StreamingCellThreshold = 1000000;
+  this->NumberOfStreamingChunks = 64;
+  this->StreamingRequestSize = 4;
   this->LODOutlineFilter = vtkPVGeometryFilter::New();
 
   // connect progress bar
@@ -210,6 +717,8 @@ vtkGeometryRepresentation::~vtkGeometryRepresentation()
   this->GeometryFilter->Delete();
   this->MultiBlockMaker->Delete();
   this->Decimator->Delete();
+  delete this->LODPyramid;
+  delete this->Streamer;
   this->LODOutlineFilter->Delete();
   this->Mapper->Delete();
   this->LODMapper->Delete();
@@ -217,6 +726,40 @@ vtkGeometryRepresentation::~vtkGeometryRepresentation()
   this->Property->Delete();
 }
 
+//----------------------------------------------------------------------------
+vtkDataObject* vtkGeometryRepresentation::GetLODLevel(vtkDataObject* data, int level)
+{
+  auto& pyramid = *this->LODPyramid;
+  const int numLevels = this->NumberOfLODLevels;
+  if (!pyramid.IsValid(data, numLevels))
+  {
+    pyramid.Reset(data, numLevels);
+  }
+
+  level = vtkMath::ClampValue(level, 0, numLevels - 1);
+  if (pyramid.Levels[level] == nullptr)
+  {
+    vtkDataObject* source = data;
+    for (int cc = level + 1; cc < numLevels; ++cc)
+    {
+      if (pyramid.Levels[cc] != nullptr)
+      {
+        source = pyramid.Levels[cc];
+        break;
+      }
+    }
+
+    this->Decimator->SetLODFactor(pyramid.GetLODFactor(level, numLevels));
+    this->Decimator->SetInputDataObject(source);
+    this->Decimator->Update();
+
+    vtkDataObject* output = this->Decimator->GetOutputDataObject(0);
+    pyramid.Levels[level].TakeReference(output->NewInstance());
+    pyramid.Levels[level]->ShallowCopy(output);
+  }
+  return pyramid.Levels[level];
+}
+
 //----------------------------------------------------------------------------
 void vtkGeometryRepresentation::SetupDefaults()
 {
@@ -297,8 +840,52 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   if (request_type == vtkPVView::REQUEST_UPDATE())
   {
     // provide the "geometry" to the view so the view can delivery it to the
-    // rendering nodes as and when needed.
-    vtkPVView::SetPiece(inInfo, this, this->MultiBlockMaker->GetOutputDataObject(0));
+    // rendering nodes as and when needed. When streaming, only the chunks most
+    // relevant to the current view are delivered now and the rest are
+    // delivered in REQUEST_STREAMING_UPDATE passes.
+    const bool streaming = this->Streamer->IsStreaming() && !this->NeedsOrderedCompositing();
+    if (streaming)
+    {
+      // SetPiece() ignores new pieces until the representation re-executes,
+      // so only pop the first chunks once per execution. Popping on every
+      // view update would drop those chunks and stream the rest again.
+      if (this->Streamer->FirstPiece == nullptr)
+      {
+        vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(inInfo->Get(vtkPVRenderView::VIEW()));
+        vtkRenderer* ren = view ? view->GetRenderer() : nullptr;
+        if (ren)
+        {
+          double view_planes[24];
+          ren->GetActiveCamera()->GetFrustumPlanes(ren->GetTiledAspectRatio(), view_planes);
+          double clamp_bounds[6];
+          vtkMath::UninitializeBounds(clamp_bounds);
+          this->Streamer->Queue.UpdatePriorities(view_planes, clamp_bounds);
+        }
+        this->Streamer->FirstPiece = this->Streamer->Pop(this->StreamingRequestSize);
+      }
+      // report the size of the full geometry so the view's rendering
+      // decisions account for all the data that will be streamed.
+      vtkPVView::SetPiece(inInfo, this, this->Streamer->FirstPiece,
+        this->Streamer->Input->GetActualMemorySize());
+    }
+    else
+    {
+      if (this->Streamer->IsStreaming())
+      {
+        // ordered compositing needs all the geometry; stop streaming until
+        // the representation re-executes. If some of the chunks were already
+        // set as the piece, drop it so that SetPiece() replaces it with all
+        // the geometry even though the representation did not re-execute.
+        const bool partial = this->Streamer->FirstPiece != nullptr;
+        this->Streamer->Reset();
+        if (partial)
+        {
+          vtkPVView::ClearPiece(inInfo, this);
+        }
+      }
+      vtkPVView::SetPiece(inInfo, this, this->MultiBlockMaker->GetOutputDataObject(0));
+    }
+    vtkPVRenderView::SetStreamable(inInfo, this, streaming);
 
     // Since we are rendering polydata, it can be redistributed when ordered
     // compositing is needed. So let the view know that it can feel free to
@@ -333,7 +920,13 @@ int vtkGeometryRepresentation::ProcessViewRequest(
     // Called to generate and provide the LOD data to the view.
     // If SuppressLOD is true, we tell the view we have no LOD data to provide,
     // otherwise we provide the decimated data.
-    auto data = vtkPVView::GetPiece(inInfo, this);
+    vtkDataObject* data = vtkPVView::GetPiece(inInfo, this);
+    if (data != nullptr && this->Streamer->IsStreaming())
+    {
+      // the piece only has the chunks delivered up front, decimate all the
+      // geometry instead.
+      data = this->Streamer->Input;
+    }
     if (data != nullptr && !this->SuppressLOD)
     {
       if (inInfo->Has(vtkPVRenderView::USE_OUTLINE_FOR_LOD()))
@@ -346,26 +939,85 @@ int vtkGeometryRepresentation::ProcessViewRequest(
       }
       else
       {
-        if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
+        // Pick the pyramid level closest to the requested LOD resolution. We
+        // handle this number differently depending on decimator
+        // implementation, see DecimationFilterType::SetLODFactor.
+        const double factor = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+          ? vtkMath::ClampValue(inInfo->Get(vtkPVRenderView::LOD_RESOLUTION()), 0.0, 1.0)
+          : 0.5;
+        int level = static_cast<int>(factor * (this->NumberOfLODLevels - 1) + 0.5);
+        vtkDataObject* lod = this->GetLODLevel(data, level);
+
+        // If the LOD geometry is still larger than the budget, fall back to
+        // coarser levels. The view compares the budget with the size summed
+        // over all ranks, so do the same here. All ranks go through this loop
+        // the same number of times since the decision is made on the sum.
+        const double budget = inInfo->Has(vtkPVRenderView::LOD_BUDGET())
+          ? inInfo->Get(vtkPVRenderView::LOD_BUDGET()) * 1024.0 // in KiB.
+          : 0.0;
+        auto controller = vtkMultiProcessController::GetGlobalController();
+        while (budget > 0.0 && level > 0)
         {
-          // We handle this number differently depending on decimator
-          // implementation.
-          const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
-          this->Decimator->SetLODFactor(factor);
+          vtkTypeUInt64 lsize = lod ? static_cast<vtkTypeUInt64>(lod->GetActualMemorySize()) : 0;
+          vtkTypeUInt64 gsize = lsize;
+          if (controller && controller->GetNumberOfProcesses() > 1)
+          {
+            controller->AllReduce(&lsize, &gsize, 1, vtkCommunicator::SUM_OP);
+          }
+          if (static_cast<double>(gsize) <= budget)
+          {
+            break;
+          }
+          lod = this->GetLODLevel(data, --level);
         }
-
-        this->Decimator->SetInputDataObject(data);
-        this->Decimator->Update();
+        vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: using LOD level %d of %d",
+          this->GetLogName().c_str(), level, this->NumberOfLODLevels);
 
         // Pass along the LOD geometry to the view so that it can deliver it to
         // the rendering node as and when needed.
-        vtkPVView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
+        vtkPVView::SetPieceLOD(inInfo, this, lod);
       }
     }
   }
-  else if (request_type == vtkPVView::REQUEST_RENDER())
+  else if (request_type == vtkPVRenderView::REQUEST_STREAMING_UPDATE())
+  {
+    if (this->Streamer->IsStreaming() && !this->Streamer->Queue.empty())
+    {
+      double view_planes[24];
+      inInfo->Get(vtkPVRenderView::VIEW_PLANES(), view_planes);
+      double clamp_bounds[6];
+      vtkMath::UninitializeBounds(clamp_bounds);
+      this->Streamer->Queue.UpdatePriorities(view_planes, clamp_bounds);
+      vtkPVRenderView::SetNextStreamedPiece(
+        inInfo, this, this->Streamer->Pop(this->StreamingRequestSize));
+    }
+  }
+  else if (request_type == vtkPVRenderView::REQUEST_PROCESS_STREAMED_PIECE())
   {
     auto data = vtkPVView::GetDeliveredPiece(inInfo, this);
+    auto piece =
+      vtkMultiBlockDataSet::SafeDownCast(vtkPVRenderView::GetCurrentStreamedPiece(inInfo, this));
+    auto& streamer = *this->Streamer;
+    if (data && piece)
+    {
+      if (streamer.AccumulatedSource != data || streamer.AccumulatedSourceTime != data->GetMTime())
+      {
+        streamer.ResetAccumulated(data);
+      }
+      streamer.Append(piece);
+    }
+  }
+  else if (request_type == vtkPVView::REQUEST_RENDER())
+  {
+    vtkDataObject* data = vtkPVView::GetDeliveredPiece(inInfo, this);
+    auto& streamer = *this->Streamer;
+    if (data && streamer.Accumulated && streamer.AccumulatedSource == data &&
+      streamer.AccumulatedSourceTime == data->GetMTime())
+    {
+      // render the streamed chunks received so far.
+      streamer.Flush();
+      data = streamer.Accumulated;
+    }
     // vtkLogF(INFO, "%p: %s", (void*)data, this->GetLogName().c_str());
     auto dataLOD = vtkPVView::GetDeliveredPieceLOD(inInfo, this);
     this->Mapper->SetInputDataObject(data);
@@ -452,6 +1104,21 @@ int vtkGeometryRepresentation::RequestData(
 
   this->MultiBlockMaker->Modified();
   this->MultiBlockMaker->Update();
+
+  // The LOD levels were generated from the previous output, release them.
+  this->LODPyramid->Reset(nullptr, 0);
+
+  // Split large geometry into chunks for streaming.
+  this->Streamer->Reset();
+  auto output = vtkMultiBlockDataSet::SafeDownCast(this->MultiBlockMaker->GetOutputDataObject(0));
+  if (vtkPVView::GetEnableStreaming() && output &&
+    vtkGeometryRepresentation_detail::GeometryStreamer::GetNumberOfCells(output) >
+      this->StreamingCellThreshold)
+  {
+    this->Streamer->Initialize(output, this->NumberOfStreamingChunks);
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: split geometry into %d chunks for streaming",
+      this->GetLogName().c_str(), static_cast<int>(this->Streamer->Chunks.size()));
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
@@ -49,6 +49,8 @@ namespace vtkGeometryRepresentation_detail
 // This is defined to either vtkQuadricClustering or vtkmLevelOfDetail in the
 // implementation file:
 class DecimationFilterType;
+class LODPyramid;
+class GeometryStreamer;
 }
 
 class VTKPVCLIENTSERVERCORERENDERING_EXPORT vtkGeometryRepresentation
@@ -89,6 +91,36 @@ public:
    */
   virtual void SetSuppressLOD(bool suppress) { this->SuppressLOD = suppress; }
 
+  //@{
+  /**
+   * Get/Set the number of levels in the LOD pyramid. The LOD resolution
+   * requested by the view is rounded to the nearest level. Decimated geometry
+   * is cached for each level so that changing the LOD resolution, or falling
+   * back to a coarser level to fit in the view's LOD budget, does not require
+   * decimating the data again. Default is 5.
+   */
+  vtkSetClampMacro(NumberOfLODLevels, int, 1, 16);
+  vtkGetMacro(NumberOfLODLevels, int);
+  //@}
+
+  //@{
+  /**
+   * When streaming is enabled (see vtkPVView::GetEnableStreaming) and the
+   * geometry on a rank has more than StreamingCellThreshold cells, the
+   * geometry is split into NumberOfStreamingChunks spatial chunks. Only the
+   * chunks most relevant to the current view are delivered on update and the
+   * rest are delivered progressively, StreamingRequestSize chunks at a time,
+   * in order of their screen coverage. Streaming is not used when the
+   * representation needs ordered compositing.
+   */
+  vtkSetClampMacro(StreamingCellThreshold, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(StreamingCellThreshold, vtkIdType);
+  vtkSetClampMacro(NumberOfStreamingChunks, int, 1, 4096);
+  vtkGetMacro(NumberOfStreamingChunks, int);
+  vtkSetClampMacro(StreamingRequestSize, int, 1, 4096);
+  vtkGetMacro(StreamingRequestSize, int);
+  //@}
+
   //@{
   /**
    * Set the lighting properties of the object. vtkGeometryRepresentation
@@ -387,6 +419,13 @@ protected:
    */
   void UpdateShaderReplacements();
 
+  /**
+   * Returns the decimated geometry for the given level of the LOD pyramid,
+   * generating it if needed. Levels are generated from the nearest finer level
+   * already available, if any, rather than the full resolution `data`.
+   */
+  vtkDataObject* GetLODLevel(vtkDataObject* data, int level);
+
   /**
    * Returns true if this representation has translucent geometry. Unlike
    * `vtkActor::HasTranslucentPolygonalGeometry` which cannot be called in
@@ -398,6 +437,12 @@ protected:
   vtkAlgorithm* GeometryFilter;
   vtkAlgorithm* MultiBlockMaker;
   vtkGeometryRepresentation_detail::DecimationFilterType* Decimator;
+  vtkGeometryRepresentation_detail::LODPyramid* LODPyramid;
+  int NumberOfLODLevels;
+  vtkGeometryRepresentation_detail::GeometryStreamer* Streamer;
+  vtkIdType StreamingCellThreshold;
+  int NumberOfStreamingChunks;
+  int StreamingRequestSize;
   vtkPVGeometryFilter* LODOutlineFilter;
 
   vtkMapper* Mapper;
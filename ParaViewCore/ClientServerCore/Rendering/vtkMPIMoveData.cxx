@@ -651,6 +651,7 @@ void vtkMPIMoveData::DataServerGatherAll(vtkDataObject* input, vtkDataObject* ou
 
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "gather-all");
+  vtkPVLogger::TraceScope traceScope("data-movement", "gather-all");
 
   int idx;
   vtkMPICommunicator* com = vtkMPICommunicator::SafeDownCast(this->Controller->GetCommunicator());
@@ -692,6 +693,7 @@ void vtkMPIMoveData::DataServerGatherAll(vtkDataObject* input, vtkDataObject* ou
   this->Buffers = new char[this->BufferTotalLength];
   com->AllGatherV(
     inBuffer, this->Buffers, inBufferLength, this->BufferLengths, this->BufferOffsets);
+  traceScope.SetNumberOfBytes(this->BufferTotalLength);
 
   this->ReconstructDataFromBuffer(output);
 
@@ -727,6 +729,7 @@ void vtkMPIMoveData::DataServerGatherToZero(vtkDataObject* input, vtkDataObject*
 
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "gather-to-0");
+  vtkPVLogger::TraceScope traceScope("data-movement", "gather-to-0");
   int idx;
   int myId = this->Controller->GetLocalProcessId();
   vtkMPICommunicator* com = vtkMPICommunicator::SafeDownCast(this->Controller->GetCommunicator());
@@ -774,6 +777,7 @@ void vtkMPIMoveData::DataServerGatherToZero(vtkDataObject* input, vtkDataObject*
   com->GatherV(
     inBuffer, this->Buffers, inBufferLength, this->BufferLengths, this->BufferOffsets, 0);
   this->NumberOfBuffers = numProcs;
+  traceScope.SetNumberOfBytes(myId == 0 ? this->BufferTotalLength : inBufferLength);
 
   if (myId == 0)
   {
@@ -803,11 +807,13 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-renderserver");
+  vtkPVLogger::TraceScope traceScope("data-movement", "send-to-renderserver");
 
   // int fixme;
   // We might be able to eliminate this marshal.
   this->ClearBuffer();
   this->MarshalDataToBuffer(output);
+  traceScope.SetNumberOfBytes(this->BufferTotalLength);
 
   com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
   com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
@@ -826,6 +832,7 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
+  vtkPVLogger::TraceScope traceScope("data-movement", "receive-from-dataserver");
 
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
@@ -841,6 +848,7 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
   }
   this->Buffers = new char[this->BufferTotalLength];
   com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
+  traceScope.SetNumberOfBytes(this->BufferTotalLength);
 
   // int fixme;  // Can we avoid this?
   this->ReconstructDataFromBuffer(output);
@@ -864,11 +872,13 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
     }
 
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-renderserver-root");
+    vtkPVLogger::TraceScope traceScope("data-movement", "send-to-renderserver-root");
 
     // int fixme;
     // We might be able to eliminate this marshal.
     this->ClearBuffer();
     this->MarshalDataToBuffer(data);
+    traceScope.SetNumberOfBytes(this->BufferTotalLength);
     com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
     com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
     com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
@@ -892,6 +902,7 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
     }
 
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver-root");
+    vtkPVLogger::TraceScope traceScope("data-movement", "receive-from-dataserver-root");
 
     this->ClearBuffer();
     com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
@@ -907,6 +918,7 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
     }
     this->Buffers = new char[this->BufferTotalLength];
     com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
+    traceScope.SetNumberOfBytes(this->BufferTotalLength);
 
     // int fixme;  // Can we avoid this?
     this->ReconstructDataFromBuffer(data);
@@ -927,9 +939,11 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
   if (myId == 0)
   {
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-client");
+    vtkPVLogger::TraceScope traceScope("data-movement", "send-to-client");
     vtkTimerLog::MarkStartEvent("Dataserver sending to client");
     this->ClearBuffer();
     this->MarshalDataToBuffer(output);
+    traceScope.SetNumberOfBytes(this->BufferTotalLength);
     this->ClientDataServerSocketController->Send(&(this->NumberOfBuffers), 1, 1, 23490);
     this->ClientDataServerSocketController->Send(
       this->BufferLengths, this->NumberOfBuffers, 1, 23491);
@@ -951,6 +965,7 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
+  vtkPVLogger::TraceScope traceScope("data-movement", "receive-from-dataserver");
 
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
@@ -966,6 +981,7 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
   }
   this->Buffers = new char[this->BufferTotalLength];
   com->Receive(this->Buffers, this->BufferTotalLength, 1, 23492);
+  traceScope.SetNumberOfBytes(this->BufferTotalLength);
   this->ReconstructDataFromBuffer(output);
   this->ClearBuffer();
 }
@@ -982,6 +998,7 @@ void vtkMPIMoveData::RenderServerZeroBroadcast(vtkDataObject* data)
 
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "broadcast");
+  vtkPVLogger::TraceScope traceScope("data-movement", "broadcast");
   int myId = this->Controller->GetLocalProcessId();
 
   vtkMPICommunicator* com = vtkMPICommunicator::SafeDownCast(this->Controller->GetCommunicator());
@@ -1002,6 +1019,7 @@ void vtkMPIMoveData::RenderServerZeroBroadcast(vtkDataObject* data)
 
   // Broadcast the size of the buffer.
   com->Broadcast(&bufferLength, 1, 0);
+  traceScope.SetNumberOfBytes(bufferLength);
 
   // Allocate buffers for all receiving nodes.
   if (myId != 0)
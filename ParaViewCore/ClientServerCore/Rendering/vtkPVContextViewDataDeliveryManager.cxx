@@ -26,6 +26,8 @@
 #include "vtkSelectionSerializer.h"
 
 #include <cassert>
+#include <string>
+#include <vector>
 
 vtkStandardNewMacro(vtkPVContextViewDataDeliveryManager);
 //----------------------------------------------------------------------------
@@ -75,30 +77,28 @@ void vtkPVContextViewDataDeliveryManager::MoveData(
     {
       if (pm->GetPartitionId() == 0)
       {
-        std::ostringstream res;
-        vtkSelectionSerializer::PrintXML(res, vtkIndent(), 1, selection);
+        std::string res;
+        vtkSelectionSerializer::SaveBinary(res, selection);
 
-        // Send the size of the string.
-        int size = static_cast<int>(res.str().size());
+        // Send the size of the buffer.
+        int size = static_cast<int>(res.size());
         controller->Broadcast(&size, 1, 0);
 
-        // Send the XML string.
-        controller->Broadcast(const_cast<char*>(res.str().c_str()), size, 0);
+        // Send the serialized selection.
+        controller->Broadcast(&res[0], size, 0);
       }
       else
       {
         int size = 0;
         controller->Broadcast(&size, 1, 0);
-        char* xml = new char[size + 1];
-
-        // Get the string itself.
-        controller->Broadcast(xml, size, 0);
-        xml[size] = 0;
-
-        // Parse the XML.
-        selection->Initialize();
-        vtkSelectionSerializer::Parse(xml, selection);
-        delete[] xml;
+        std::vector<char> buffer(size + 1);
+
+        // Get the serialized selection itself.
+        controller->Broadcast(&buffer[0], size, 0);
+        if (!vtkSelectionSerializer::LoadBinary(&buffer[0], static_cast<size_t>(size), selection))
+        {
+          vtkErrorMacro("Failed to parse the selection received from process 0.");
+        }
       }
     }
     item->SetDeliveredDataObject(this->GetDeliveredDataKey(low_res), cacheKey, selection);
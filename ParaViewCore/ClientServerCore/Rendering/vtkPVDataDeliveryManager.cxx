@@ -135,6 +135,19 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::ClearPiece(vtkPVDataRepresentation* repr, bool low_res, int port)
+{
+  vtkInternals::vtkItem* item =
+    this->Internals->GetItem(repr, low_res, port, /*create_if_needed=*/false);
+  if (item)
+  {
+    const auto cacheKey = this->GetCacheKey(repr);
+    vtkLogF(TRACE, "ClearPiece %s (key=%g)", repr->GetLogName().c_str(), cacheKey);
+    item->SetDataObject(nullptr, this->Internals, cacheKey);
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkDataObject* vtkPVDataDeliveryManager::GetPiece(
   vtkPVDataRepresentation* repr, bool low_res, int port)
@@ -261,6 +274,8 @@ void vtkPVDataDeliveryManager::Deliver(int low_res, unsigned int size, unsigned
       }
       vtkVLogScopeF(
         PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "move-data: %s", repr->GetLogName().c_str());
+      vtkPVLogger::TraceScope traceScope(
+        "data-movement", "move-data: ", repr->GetLogName().c_str());
       this->MoveData(repr, low_res != 0, port);
     }
   }
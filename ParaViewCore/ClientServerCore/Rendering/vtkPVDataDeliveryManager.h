@@ -92,6 +92,14 @@ public:
   bool HasPiece(vtkPVDataRepresentation* repr, bool low_res = false, int port = 0);
   //@}
 
+  /**
+   * Drops the data object set by calling `SetPiece`. `SetPiece` only replaces
+   * a data object when the representation re-executed; representations that
+   * replace a piece without re-executing (e.g. to deliver all the geometry
+   * after delivering part of it) call this first.
+   */
+  void ClearPiece(vtkPVDataRepresentation* repr, bool low_res, int port = 0);
+
   /**
    * Returns the local data object set by calling `SetPiece` (or from the
    * cache). This is the data object pre-delivery.
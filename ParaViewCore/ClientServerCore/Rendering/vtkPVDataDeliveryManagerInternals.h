@@ -16,6 +16,7 @@
 #define vtkPVDataDeliveryManagerInternals_h
 #ifndef __WRAP__
 
+#include "vtkAlgorithm.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
 #include "vtkNew.h"
@@ -89,9 +90,16 @@ public:
 
     vtkMTimeType TimeStamp{ 0 };
 
+    // Filter used to redistribute data for ordered compositing. Kept around so
+    // that it can reuse its redistribution plan when only attributes change.
+    vtkSmartPointer<vtkAlgorithm> Redistributor;
+
   public:
     vtkItem() {}
 
+    vtkAlgorithm* GetRedistributor() const { return this->Redistributor; }
+    void SetRedistributor(vtkAlgorithm* algo) { this->Redistributor = algo; }
+
     void ClearCache() { this->Data.clear(); }
 
     void SetDataObject(vtkDataObject* data, vtkInternals* helper, double cacheKey)
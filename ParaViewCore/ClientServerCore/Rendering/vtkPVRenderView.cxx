@@ -312,6 +312,7 @@ vtkStandardNewMacro(vtkPVRenderView);
 vtkInformationKeyMacro(vtkPVRenderView, USE_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, USE_OUTLINE_FOR_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, LOD_RESOLUTION, Double);
+vtkInformationKeyMacro(vtkPVRenderView, LOD_BUDGET, Double);
 vtkInformationKeyMacro(vtkPVRenderView, NEED_ORDERED_COMPOSITING, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, RENDER_EMPTY_IMAGES, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, REQUEST_STREAMING_UPDATE, Request);
@@ -1304,6 +1305,7 @@ void vtkPVRenderView::UpdateLOD()
   // Update LOD geometry.
 
   this->RequestInformation->Set(LOD_RESOLUTION(), this->LODResolution);
+  this->RequestInformation->Set(LOD_BUDGET(), this->LODRenderingThreshold);
   if (this->UseOutlineForLODRendering)
   {
     this->RequestInformation->Set(USE_OUTLINE_FOR_LOD(), 1);
@@ -1340,6 +1342,7 @@ void vtkPVRenderView::UpdateLOD()
 void vtkPVRenderView::StillRender()
 {
   vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: StillRender", this->GetLogName().c_str());
+  vtkPVLogger::TraceScope traceScope("rendering", this->GetLogName().c_str(), ": StillRender");
 
   vtkTimerLog::MarkStartEvent("Still Render");
   this->GetRenderWindow()->SetDesiredUpdateRate(0.002);
@@ -1356,6 +1359,8 @@ void vtkPVRenderView::InteractiveRender()
 {
   vtkVLogScopeF(
     PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: InteractiveRender", this->GetLogName().c_str());
+  vtkPVLogger::TraceScope traceScope(
+    "rendering", this->GetLogName().c_str(), ": InteractiveRender");
 
   vtkTimerLog::MarkStartEvent("Interactive Render");
   this->GetRenderWindow()->SetDesiredUpdateRate(5.0);
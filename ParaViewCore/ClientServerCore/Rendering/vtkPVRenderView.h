@@ -312,6 +312,14 @@ public:
    */
   static vtkInformationDoubleKey* LOD_RESOLUTION();
 
+  /**
+   * Indicates the size in megabytes the LOD geometry should fit in, if
+   * possible, in REQUEST_UPDATE_LOD() pass. This is the LOD rendering
+   * threshold. Representations that can generate LOD geometry at multiple
+   * levels may use this to pick a coarser level.
+   */
+  static vtkInformationDoubleKey* LOD_BUDGET();
+
   /**
    * Indicates the LOD must use outline if possible in REQUEST_UPDATE_LOD()
    * pass.
@@ -317,7 +317,13 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
       {
         item.SetDeliveredDataObject(REDISTRIBUTED_DATA_KEY, cacheKey, nullptr);
         vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "redistribute: %s", debugName.c_str());
-        vtkNew<vtkOrderedCompositeDistributor> redistributor;
+        auto redistributor = vtkOrderedCompositeDistributor::SafeDownCast(item.GetRedistributor());
+        if (redistributor == nullptr)
+        {
+          redistributor = vtkOrderedCompositeDistributor::New();
+          item.SetRedistributor(redistributor);
+          redistributor->FastDelete();
+        }
         redistributor->SetController(vtkMultiProcessController::GetGlobalController());
         redistributor->SetInputData(deliveredDataObject);
         redistributor->SetPKdTree(this->KdTree);
@@ -326,8 +332,17 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
             ? info->Get(vtkPVRVDMKeys::REDISTRIBUTION_MODE())
             : vtkOrderedCompositeDistributor::SPLIT_BOUNDARY_CELLS);
         redistributor->Update();
-        item.SetDeliveredDataObject(
-          REDISTRIBUTED_DATA_KEY, cacheKey, redistributor->GetOutputDataObject(0));
+
+        // the redistributor is reused for subsequent updates, hence we save a
+        // shallow copy of its output.
+        vtkDataObject* redistributedOutput = redistributor->GetOutputDataObject(0);
+        vtkSmartPointer<vtkDataObject> clone;
+        clone.TakeReference(redistributedOutput->NewInstance());
+        clone->ShallowCopy(redistributedOutput);
+        item.SetDeliveredDataObject(REDISTRIBUTED_DATA_KEY, cacheKey, clone);
+        vtkVLogIfF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+          redistributor->GetRedistributionPlanReused(), "reused redistribution plan: %s",
+          debugName.c_str());
         anything_moved = true;
       }
     }
@@ -466,6 +481,15 @@ void vtkPVRenderViewDataDeliveryManager::DeliverStreamedPieces(
     vtkDataObject* data = item->GetDataObject(cacheKey);
     vtkDataObject* piece = item->GetDeliveredDataObject(STREAMING_DATA_KEY, cacheKey);
 
+    // processes that have no piece to stream still need to participate in
+    // the delivery, so give them an empty dataset.
+    vtkSmartPointer<vtkDataObject> emptyPiece;
+    if (piece == nullptr && data != nullptr)
+    {
+      emptyPiece.TakeReference(data->NewInstance());
+      piece = emptyPiece;
+    }
+
     vtkNew<vtkMPIMoveData> dataMover;
     dataMover->InitializeForCommunicationForParaView();
     dataMover->SetOutputDataType(data->GetDataObjectType());
@@ -23,7 +23,8 @@
 #include "vtkSelectionNode.h"
 #include "vtkSelectionSerializer.h"
 #include "vtkSmartPointer.h"
-#include <sstream>
+#include <string>
+#include <vector>
 
 vtkStandardNewMacro(vtkPVSelectionInformation);
 
@@ -108,10 +109,10 @@ void vtkPVSelectionInformation::CopyToStream(vtkClientServerStream* css)
   css->Reset();
   *css << vtkClientServerStream::Reply;
 
-  std::ostringstream res;
-  vtkSelectionSerializer::PrintXML(res, vtkIndent(), 1, this->Selection);
-  res << ends;
-  *css << res.str().c_str();
+  std::string res;
+  vtkSelectionSerializer::SaveBinary(res, this->Selection);
+  *css << vtkClientServerStream::InsertArray(
+    reinterpret_cast<const unsigned char*>(res.c_str()), static_cast<int>(res.size()));
 
   *css << vtkClientServerStream::End;
 }
@@ -121,11 +122,18 @@ void vtkPVSelectionInformation::CopyFromStream(const vtkClientServerStream* css)
 {
   this->Initialize();
 
-  const char* xml = 0;
-  if (!css->GetArgument(0, 0, &xml))
+  vtkTypeUInt32 length;
+  std::vector<unsigned char> data;
+  if (!css->GetArgumentLength(0, 0, &length))
   {
-    vtkErrorMacro("Error parsing selection xml from message.");
+    vtkErrorMacro("Error parsing length of selection from message.");
     return;
   }
-  vtkSelectionSerializer::Parse(xml, this->Selection);
+  data.resize(length + 1);
+  if (!css->GetArgument(0, 0, &data[0], length) ||
+    !vtkSelectionSerializer::LoadBinary(
+      reinterpret_cast<const char*>(&data[0]), length, this->Selection))
+  {
+    vtkErrorMacro("Error parsing selection from message.");
+  }
 }
@@ -938,6 +938,15 @@ vtkDataObject* vtkPVView::GetPiece(vtkInformation* info, vtkPVDataRepresentation
   return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+void vtkPVView::ClearPiece(vtkInformation* info, vtkPVDataRepresentation* repr, int port)
+{
+  if (auto dm = vtkPVView::GetDeliveryManager(info))
+  {
+    dm->ClearPiece(repr, false, port);
+  }
+}
+
 //-----------------------------------------------------------------------------
 vtkDataObject* vtkPVView::GetDeliveredPiece(
   vtkInformation* info, vtkPVDataRepresentation* repr, int port)
@@ -257,6 +257,7 @@ public:
   static void SetPiece(vtkInformation* info, vtkPVDataRepresentation* repr, vtkDataObject* data,
     unsigned long trueSize = 0, int port = 0);
   static vtkDataObject* GetPiece(vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
+  static void ClearPiece(vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
   static vtkDataObject* GetDeliveredPiece(
     vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
 
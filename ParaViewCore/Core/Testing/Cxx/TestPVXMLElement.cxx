@@ -0,0 +1,241 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVXMLElement.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkNew.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace
+{
+bool Check(bool condition, const char* what)
+{
+  if (!condition)
+  {
+    std::cerr << "Failed: " << what << std::endl;
+  }
+  return condition;
+}
+
+template <class T>
+bool CheckScalar(const char* text, int expectedStatus, T expectedValue)
+{
+  vtkNew<vtkPVXMLElement> element;
+  element->AddAttribute("value", text);
+  T value = T();
+  const int status = element->GetScalarAttribute("value", &value);
+  if (status != expectedStatus || (status && value != expectedValue))
+  {
+    std::cerr << "Failed: parsing \"" << text << "\" gave " << status << ", " << value
+              << " instead of " << expectedStatus << ", " << expectedValue << std::endl;
+    return false;
+  }
+  // the second query is answered from the parsed value cache.
+  value = T();
+  return element->GetScalarAttribute("value", &value) == status &&
+    (!status || value == expectedValue);
+}
+
+// Returns the element decoded from `buffer`, checking that all of it was used.
+vtkSmartPointer<vtkPVXMLElement> LoadBinary(const std::string& buffer, int maxDepth = 256)
+{
+  const char* data = buffer.data();
+  const char* end = data + buffer.size();
+  vtkSmartPointer<vtkPVXMLElement> element;
+  element.TakeReference(vtkPVXMLElement::NewFromBinary(data, end, maxDepth));
+  if (element && data != end)
+  {
+    std::cerr << "Failed: " << (end - data) << " bytes left after decoding" << std::endl;
+    return nullptr;
+  }
+  return element;
+}
+
+bool CheckBinary()
+{
+  bool success = true;
+
+  vtkNew<vtkPVXMLParser> parser;
+  if (!Check(parser->Parse("<Root id=\"root-id\" name=\"value\" empty=\"\">"
+                           "<Child index=\"1\">some text with &lt;markup&gt; &amp; \"quotes\""
+                           "<GrandChild values=\"1 2 3\"/>"
+                           "</Child>"
+                           "<Sibling/>"
+                           "</Root>") != 0,
+        "parse"))
+  {
+    return false;
+  }
+  vtkPVXMLElement* root = parser->GetRootElement();
+  vtkPVXMLElement* child = root->FindNestedElementByName("Child");
+
+  std::string buffer;
+  root->SaveBinary(buffer);
+  vtkSmartPointer<vtkPVXMLElement> loaded = LoadBinary(buffer);
+  success &= Check(loaded && loaded->Equals(root), "binary round trip");
+  if (loaded)
+  {
+    vtkPVXMLElement* loadedChild = loaded->FindNestedElementByName("Child");
+    success &= Check(child && loadedChild &&
+        std::string(loadedChild->GetCharacterData()) == child->GetCharacterData(),
+      "binary character data");
+    success &= Check(loaded->GetId() && strcmp(loaded->GetId(), "root-id") == 0, "binary id");
+    success &= Check(loaded->GetAttribute("empty") && !*loaded->GetAttribute("empty"),
+      "binary empty attribute");
+  }
+
+  // truncated data is rejected wherever it is cut.
+  for (size_t length = 0; length < buffer.size(); ++length)
+  {
+    if (LoadBinary(buffer.substr(0, length)))
+    {
+      std::cerr << "Failed: data truncated to " << length << " bytes was accepted" << std::endl;
+      success = false;
+      break;
+    }
+  }
+
+  // a length larger than the data left is rejected.
+  std::string corrupt = buffer;
+  const vtkTypeUInt32 huge = 0x7fffffff;
+  memcpy(&corrupt[0], &huge, sizeof(huge));
+  success &= Check(!LoadBinary(corrupt), "corrupt length");
+
+  // so is nesting deeper than allowed.
+  success &= Check(!LoadBinary(buffer, 2), "nesting deeper than allowed");
+  success &= Check(LoadBinary(buffer, 3) != nullptr, "nesting as deep as allowed");
+  return success;
+}
+}
+
+int TestPVXMLElement(int, char* [])
+{
+  bool success = true;
+
+  // integers follow `istream >> int`: leading spaces and a sign are accepted,
+  // parsing stops at the first character that is not a digit.
+  success &= CheckScalar<int>("12", 1, 12);
+  success &= CheckScalar<int>("  -7", 1, -7);
+  success &= CheckScalar<int>("+3", 1, 3);
+  success &= CheckScalar<int>("1e3", 1, 1);
+  success &= CheckScalar<int>("0x10", 1, 0);
+  success &= CheckScalar<int>("2.5", 1, 2);
+  success &= CheckScalar<int>("-2147483648", 1, VTK_INT_MIN);
+  success &= CheckScalar<int>("2147483648", 0, 0);
+  success &= CheckScalar<int>("", 0, 0);
+  success &= CheckScalar<int>("abc", 0, 0);
+  success &= CheckScalar<int>(".5", 0, 0);
+  success &= CheckScalar<int>("- 1", 0, 0);
+
+  // floating values follow `istream >> double`, which does not accept "nan",
+  // "inf" or hexadecimal values, and fails on overflow.
+  success &= CheckScalar<double>("1e3", 1, 1000.0);
+  success &= CheckScalar<double>(".5", 1, 0.5);
+  success &= CheckScalar<double>("-2.25xyz", 1, -2.25);
+  success &= CheckScalar<double>("0x1p3", 1, 0.0);
+  success &= CheckScalar<double>("1e400", 0, 0.0);
+  success &= CheckScalar<double>("nan", 0, 0.0);
+  success &= CheckScalar<double>("inf", 0, 0.0);
+  success &= CheckScalar<double>("-", 0, 0.0);
+  success &= CheckScalar<float>("1e39", 0, 0.0f);
+  success &= CheckScalar<float>("0.25", 1, 0.25f);
+#if defined(VTK_USE_64BIT_IDS)
+  success &= CheckScalar<vtkIdType>("5000000000", 1, 5000000000LL);
+  success &= CheckScalar<vtkIdType>("99999999999999999999", 0, 0);
+#endif
+
+  // vector attributes return the number of values parsed.
+  vtkNew<vtkPVXMLElement> vector;
+  vector->AddAttribute("values", "1 2 x 4");
+  int values[4] = { 0, 0, 0, 0 };
+  success &= Check(vector->GetVectorAttribute("values", 4, values) == 2, "partial vector");
+  success &= Check(values[0] == 1 && values[1] == 2, "partial vector values");
+  double dvalues[3];
+  vector->SetAttribute("values", "0.5\n-1e2\t3");
+  success &= Check(vector->GetVectorAttribute("values", 3, dvalues) == 3 && dvalues[0] == 0.5 &&
+      dvalues[1] == -100.0 && dvalues[2] == 3.0,
+    "vector with mixed whitespace");
+
+  // lookups by name work with any pointer, including names never used for
+  // an attribute.
+  vtkNew<vtkPVXMLElement> element;
+  element->AddAttribute("alpha", "a");
+  element->AddAttribute("beta", 2);
+  const std::string name("beta");
+  success &= Check(strcmp(element->GetAttributeOrEmpty(name.c_str()), "2") == 0, "lookup");
+  success &= Check(element->GetAttribute("never-used-attribute-name") == nullptr, "unknown");
+  success &= Check(element->GetAttribute(nullptr) == nullptr, "null name");
+
+  // the parsed value cache is dropped when attributes change.
+  int beta = 0;
+  element->GetScalarAttribute("beta", &beta);
+  element->SetAttribute("beta", "5");
+  success &= Check(element->GetScalarAttribute("beta", &beta) && beta == 5, "cache reset");
+
+  // values live in a shared buffer that is compacted as values are replaced.
+  // Grow values many times, in place and out of place, and check none of the
+  // other values are damaged.
+  std::string expected[3];
+  const char* names[3] = { "first", "second", "third" };
+  vtkNew<vtkPVXMLElement> grown;
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    expected[cc] = names[cc];
+    grown->AddAttribute(names[cc], names[cc]);
+  }
+  for (int iteration = 0; iteration < 500; ++iteration)
+  {
+    const int cc = iteration % 3;
+    expected[cc] = iteration % 7 == 0 ? std::string("s") : expected[cc] + "0123456789";
+    grown->SetAttribute(names[cc], expected[cc].c_str());
+    for (int kk = 0; kk < 3; ++kk)
+    {
+      const char* value = grown->GetAttribute(names[kk]);
+      if (!value || expected[kk] != value)
+      {
+        std::cerr << "Failed: value of " << names[kk] << " after " << iteration
+                  << " updates is " << (value ? value : "(null)") << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // setting a value from another value of the same element must not read
+  // from a buffer that moved.
+  grown->SetAttribute("first", grown->GetAttribute("second"));
+  grown->SetAttribute("third", grown->GetAttribute("first"));
+  success &= Check(expected[1] == grown->GetAttribute("first") &&
+      expected[1] == grown->GetAttribute("third"),
+    "self assignment");
+
+  // removing attributes compacts the buffer too.
+  grown->RemoveAttribute("second");
+  success &= Check(grown->GetAttribute("second") == nullptr, "removed attribute");
+  success &= Check(expected[1] == grown->GetAttribute("first"), "value kept after removal");
+
+  // copies are independent.
+  vtkNew<vtkPVXMLElement> copy;
+  grown->CopyAttributesTo(copy);
+  copy->SetAttribute("first", "changed");
+  success &= Check(expected[1] == grown->GetAttribute("first"), "copy is independent");
+
+  success &= CheckBinary();
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
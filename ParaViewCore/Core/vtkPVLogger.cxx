@@ -16,7 +16,14 @@
 
 #include "vtkObjectFactory.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace
@@ -78,6 +85,85 @@ static const int DataMovementVerbosityKey = 3;
 static const int RenderingVerbosityKey = 4;
 static const int ApplicationVerbosityKey = 5;
 static const int ExecutionVerbosityKey = 6;
+
+//----------------------------------------------------------------------------
+// Trace events support.
+struct TraceEvent
+{
+  std::string Category;
+  std::string Name;
+  double StartTime;
+  double EndTime;
+  vtkTypeInt64 NumberOfBytes;
+  int ThreadId;
+};
+
+class TraceEventsRecorder
+{
+public:
+  TraceEventsRecorder()
+    : ProcessId(0)
+    , ProcessLabel("process")
+  {
+    const char* envval = vtksys::SystemTools::GetEnv("PARAVIEW_LOG_TRACE_EVENTS");
+    this->Enabled = (envval != nullptr && std::atoi(envval) != 0);
+  }
+
+  std::atomic<bool> Enabled;
+  std::mutex Mutex;
+  std::vector<TraceEvent> Events;
+  std::map<std::thread::id, int> ThreadIds;
+  int ProcessId;
+  std::string ProcessLabel;
+
+  // Must be called with Mutex locked.
+  int GetThreadId(const std::thread::id& tid)
+  {
+    auto iter = this->ThreadIds.find(tid);
+    if (iter == this->ThreadIds.end())
+    {
+      iter = this->ThreadIds.insert(std::make_pair(tid, static_cast<int>(this->ThreadIds.size())))
+               .first;
+    }
+    return iter->second;
+  }
+};
+
+static TraceEventsRecorder& get_recorder()
+{
+  static TraceEventsRecorder recorder;
+  return recorder;
+}
+
+static void write_json_string(std::ostream& os, const std::string& str)
+{
+  os << '"';
+  for (const char ch : str)
+  {
+    switch (ch)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(ch) >= 0x20)
+        {
+          os << ch;
+        }
+        break;
+    }
+  }
+  os << '"';
+}
 }
 
 //----------------------------------------------------------------------------
@@ -216,6 +302,151 @@ void vtkPVLogger::SetApplicationVerbosity(vtkLogger::Verbosity value)
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVLogger::GetTraceEventsEnabled()
+{
+  return get_recorder().Enabled;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogger::SetTraceEventsEnabled(bool value)
+{
+  get_recorder().Enabled = value;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogger::SetTraceEventsProcess(int pid, const char* label)
+{
+  auto& recorder = get_recorder();
+  std::lock_guard<std::mutex> lock(recorder.Mutex);
+  recorder.ProcessId = pid;
+  recorder.ProcessLabel = label ? label : "";
+}
+
+//----------------------------------------------------------------------------
+double vtkPVLogger::GetTraceEventsTime()
+{
+  using namespace std::chrono;
+  return duration_cast<duration<double> >(system_clock::now().time_since_epoch()).count();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogger::AddTraceEvent(const char* category, const char* name, double startTime,
+  double endTime, vtkTypeInt64 numberOfBytes)
+{
+  auto& recorder = get_recorder();
+  if (!recorder.Enabled)
+  {
+    return;
+  }
+
+  TraceEvent event;
+  event.Category = category ? category : "";
+  event.Name = name ? name : "";
+  event.StartTime = startTime;
+  event.EndTime = endTime;
+  event.NumberOfBytes = numberOfBytes;
+
+  std::lock_guard<std::mutex> lock(recorder.Mutex);
+  event.ThreadId = recorder.GetThreadId(std::this_thread::get_id());
+  recorder.Events.push_back(std::move(event));
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVLogger::GetNumberOfTraceEvents()
+{
+  auto& recorder = get_recorder();
+  std::lock_guard<std::mutex> lock(recorder.Mutex);
+  return static_cast<vtkIdType>(recorder.Events.size());
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVLogger::GetTraceEvents(bool clear)
+{
+  auto& recorder = get_recorder();
+  std::lock_guard<std::mutex> lock(recorder.Mutex);
+
+  std::ostringstream stream;
+  stream.precision(3);
+  stream << std::fixed;
+
+  // metadata event so the process shows up with a readable name.
+  stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << recorder.ProcessId
+         << ",\"args\":{\"name\":";
+  write_json_string(stream, recorder.ProcessLabel);
+  stream << "}}";
+
+  for (const auto& event : recorder.Events)
+  {
+    // timestamps are in microseconds.
+    stream << ",\n{\"name\":";
+    write_json_string(stream, event.Name);
+    stream << ",\"cat\":";
+    write_json_string(stream, event.Category);
+    stream << ",\"ph\":\"X\",\"ts\":" << (event.StartTime * 1.0e6)
+           << ",\"dur\":" << ((event.EndTime - event.StartTime) * 1.0e6)
+           << ",\"pid\":" << recorder.ProcessId << ",\"tid\":" << event.ThreadId;
+    if (event.NumberOfBytes >= 0)
+    {
+      stream << ",\"args\":{\"bytes\":" << event.NumberOfBytes << "}";
+    }
+    stream << "}";
+  }
+
+  if (clear)
+  {
+    recorder.Events.clear();
+  }
+  return stream.str();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogger::ClearTraceEvents()
+{
+  auto& recorder = get_recorder();
+  std::lock_guard<std::mutex> lock(recorder.Mutex);
+  recorder.Events.clear();
+}
+
+//----------------------------------------------------------------------------
+vtkPVLogger::TraceScope::TraceScope(const char* category, const char* name)
+  : Enabled(vtkPVLogger::GetTraceEventsEnabled())
+  , Category(category)
+  , StartTime(0.0)
+  , NumberOfBytes(-1)
+{
+  if (this->Enabled)
+  {
+    this->Name = name ? name : "";
+    this->StartTime = vtkPVLogger::GetTraceEventsTime();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkPVLogger::TraceScope::TraceScope(const char* category, const char* prefix, const char* suffix)
+  : Enabled(vtkPVLogger::GetTraceEventsEnabled())
+  , Category(category)
+  , StartTime(0.0)
+  , NumberOfBytes(-1)
+{
+  if (this->Enabled)
+  {
+    this->Name = prefix ? prefix : "";
+    this->Name += suffix ? suffix : "";
+    this->StartTime = vtkPVLogger::GetTraceEventsTime();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkPVLogger::TraceScope::~TraceScope()
+{
+  if (this->Enabled)
+  {
+    vtkPVLogger::AddTraceEvent(this->Category, this->Name.c_str(), this->StartTime,
+      vtkPVLogger::GetTraceEventsTime(), this->NumberOfBytes);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVLogger::PrintSelf(ostream& os, vtkIndent indent)
 {
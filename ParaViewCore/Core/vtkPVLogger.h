@@ -41,6 +41,29 @@
  * When not changed using the APIs or environment variables, all categories
  * default to vtkLogger::VERBOSITY_TRACE. To change the default used, use
  * `vtkPVLogger::SetDefaultVerbosity`.
+ *
+ * @section TraceEvents Trace events
+ *
+ * In addition to text log messages, vtkPVLogger can record timed, scoped
+ * events (optionally annotated with a byte count) that can be exported in the
+ * Chrome trace-event JSON format understood by `chrome://tracing` and
+ * Perfetto. Recording is disabled by default and can be enabled using
+ * `vtkPVLogger::SetTraceEventsEnabled` or by setting the environment variable
+ * `PARAVIEW_LOG_TRACE_EVENTS` to `1`. Events are recorded using
+ * vtkPVLogger::TraceScope or the convenience macro `PARAVIEW_TRACE_SCOPE()`:
+ *
+ * @code{cpp}
+ * PARAVIEW_TRACE_SCOPE("rendering", "still-render");
+ *
+ * vtkPVLogger::TraceScope scope("data-movement", "gather-to-0");
+ * ...
+ * scope.SetNumberOfBytes(length);
+ * @endcode
+ *
+ * Each process only records its own events. `vtkPVTraceEventsInformation`
+ * can be used to collect events from all ranks of the server processes and
+ * `vtkSMSession::SaveTraceEvents` writes out a single trace combining the
+ * client and all server processes.
  */
 
 #ifndef vtkPVLogger_h
@@ -49,6 +72,8 @@
 #include "vtkLogger.h"
 #include "vtkPVCoreModule.h" // needed for export macro
 
+#include <string> // needed for std::string
+
 class VTKPVCORE_EXPORT vtkPVLogger : public vtkLogger
 {
 public:
@@ -144,6 +169,97 @@ public:
   static Verbosity GetDefaultVerbosity();
   static void SetDefaultVerbosity(Verbosity value);
   //@}
+
+  //@{
+  /**
+   * Enable/disable recording of trace events. When disabled, which is the
+   * default, vtkPVLogger::TraceScope does not record anything.
+   *
+   * Unless overridden by calling `SetTraceEventsEnabled`, recording is enabled
+   * if the environment variable `PARAVIEW_LOG_TRACE_EVENTS` is set to a
+   * non-zero value.
+   */
+  static bool GetTraceEventsEnabled();
+  static void SetTraceEventsEnabled(bool value);
+  //@}
+
+  /**
+   * Set the process identifier and label used for all trace events recorded
+   * by this process. The identifier is used as the `pid` for the events and
+   * must be unique across all processes whose events are to be combined in a
+   * single trace e.g. client, data-server ranks and render-server ranks.
+   * vtkPVOptions sets these up from the process type and rank when the
+   * command line is processed, see vtkPVOptions::PostProcess.
+   */
+  static void SetTraceEventsProcess(int pid, const char* label);
+
+  /**
+   * Returns the current time, in seconds, used to timestamp trace events. This
+   * is wall-clock time so that events recorded on different processes can be
+   * combined in the same trace.
+   */
+  static double GetTraceEventsTime();
+
+  /**
+   * Record a complete event in the trace. `startTime` and `endTime` are as
+   * returned by `GetTraceEventsTime`. `numberOfBytes` is added to the event
+   * arguments when non-negative. This method is thread safe. It is a no-op if
+   * trace events are not enabled.
+   */
+  static void AddTraceEvent(const char* category, const char* name, double startTime,
+    double endTime, vtkTypeInt64 numberOfBytes = -1);
+
+  /**
+   * Returns the number of trace events currently recorded by this process.
+   */
+  static vtkIdType GetNumberOfTraceEvents();
+
+  /**
+   * Returns all trace events recorded by this process as a comma separated
+   * list of JSON objects in Chrome trace-event format. The result can be
+   * concatenated (with a comma) with the events from other processes to
+   * generate the `traceEvents` array of a trace file. If `clear` is true, the
+   * recorded events are cleared.
+   */
+  static std::string GetTraceEvents(bool clear = false);
+
+  /**
+   * Clear all trace events recorded by this process.
+   */
+  static void ClearTraceEvents();
+
+  /**
+   * Helper to record a trace event for the lifetime of the instance. Use the
+   * `PARAVIEW_TRACE_SCOPE()` macro when the byte count is not needed.
+   */
+  class VTKPVCORE_EXPORT TraceScope
+  {
+  public:
+    TraceScope(const char* category, const char* name);
+    ~TraceScope();
+
+    /**
+     * Same as above, with the event named `prefix` followed by `suffix`. The
+     * name is only built when trace events are enabled.
+     */
+    TraceScope(const char* category, const char* prefix, const char* suffix);
+
+    /**
+     * Set the number of bytes processed or moved in this scope.
+     */
+    void SetNumberOfBytes(vtkTypeInt64 value) { this->NumberOfBytes = value; }
+
+  private:
+    TraceScope(const TraceScope&) = delete;
+    void operator=(const TraceScope&) = delete;
+
+    bool Enabled;
+    const char* Category;
+    std::string Name;
+    double StartTime;
+    vtkTypeInt64 NumberOfBytes;
+  };
+
 protected:
   vtkPVLogger();
   ~vtkPVLogger() override;
@@ -213,4 +329,17 @@ private:
  */
 #define PARAVIEW_LOG_APPLICATION_VERBOSITY() vtkPVLogger::GetApplicationVerbosity()
 
+/**
+ * Macro to record a trace event for the rest of the current scope. Same as
+ * creating a vtkPVLogger::TraceScope instance e.g.
+ *
+ * @code{cpp}
+ *  PARAVIEW_TRACE_SCOPE("rendering", "still-render");
+ * @endcode
+ */
+#define PARAVIEW_TRACE_SCOPE(category, name)                                                       \
+  vtkPVLogger::TraceScope _vtkPVTraceConcat(__pvTraceScope, __LINE__)(category, name)
+#define _vtkPVTraceConcatImpl(s1, s2) s1##s2
+#define _vtkPVTraceConcat(s1, s2) _vtkPVTraceConcatImpl(s1, s2)
+
 #endif
@@ -20,9 +20,18 @@
 
 vtkStandardNewMacro(vtkPVXMLElement);
 
+#include <algorithm>
+#include <cerrno>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <ctype.h>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #if defined(_WIN32) && !defined(__CYGWIN__)
 #define SNPRINTF _snprintf
@@ -30,13 +39,175 @@ vtkStandardNewMacro(vtkPVXMLElement);
 #define SNPRINTF snprintf
 #endif
 
+namespace
+{
+// Attribute names are interned when attributes are added: every distinct
+// name is stored once for the lifetime of the process. The set of names is
+// bounded by the XML schemas in use. Lookups don't touch the table, so they
+// take no lock.
+struct vtkPVXMLNameTable
+{
+  std::mutex Mutex;
+  std::unordered_set<std::string> Names;
+
+  static vtkPVXMLNameTable& GetInstance()
+  {
+    static vtkPVXMLNameTable* instance = new vtkPVXMLNameTable;
+    return *instance;
+  }
+};
+
+const char* vtkPVXMLInternName(const char* name)
+{
+  auto& table = vtkPVXMLNameTable::GetInstance();
+  std::lock_guard<std::mutex> lock(table.Mutex);
+  return table.Names.insert(name).first->c_str();
+}
+}
+
 struct vtkPVXMLElementInternals
 {
-  std::vector<std::string> AttributeNames;
-  std::vector<std::string> AttributeValues;
+  // Attribute values of an element are kept back to back, null terminated, in
+  // a single buffer rather than in one string each. Overwritten values are
+  // left in place until the buffer is compacted.
+  struct Attribute
+  {
+    const char* Name;
+    size_t Value;
+  };
+  std::vector<Attribute> Attributes;
+  std::string AttributeValues;
+  size_t UsedValueSize = 0;
+
+  // Scalar attribute values already parsed by GetScalarAttribute(), indexed
+  // like Attributes. Cleared whenever attributes change.
+  struct ScalarValue
+  {
+    unsigned char Parsed = 0;
+    unsigned char Valid = 0;
+    int Int = 0;
+    float Float = 0;
+    double Double = 0;
+    vtkIdType IdType = 0;
+  };
+  std::vector<ScalarValue> ScalarValues;
+
   typedef std::vector<vtkSmartPointer<vtkPVXMLElement> > VectorOfElements;
   VectorOfElements NestedElements;
   std::string CharacterData;
+
+  const char* GetValue(size_t index) const
+  {
+    return this->AttributeValues.c_str() + this->Attributes[index].Value;
+  }
+
+  int FindAttribute(const char* name) const
+  {
+    if (!name)
+    {
+      return -1;
+    }
+    // elements have a handful of attributes and names mostly differ in their
+    // first characters, so comparing them is cheaper than a hashed lookup.
+    for (size_t cc = 0; cc < this->Attributes.size(); ++cc)
+    {
+      const char* key = this->Attributes[cc].Name;
+      if (key == name || strcmp(key, name) == 0)
+      {
+        return static_cast<int>(cc);
+      }
+    }
+    return -1;
+  }
+
+  // Appends `value` to the buffer and returns its offset.
+  size_t AppendValue(const char* value, size_t length)
+  {
+    const char* buffer = this->AttributeValues.data();
+    if (value >= buffer && value < buffer + this->AttributeValues.size())
+    {
+      // value is one of our own, copy it before the buffer may move.
+      return this->AppendValue(std::string(value, length).c_str(), length);
+    }
+    const size_t offset = this->AttributeValues.size();
+    this->AttributeValues.append(value, length);
+    this->AttributeValues.push_back('\0');
+    this->UsedValueSize += length + 1;
+    return offset;
+  }
+
+  void AddAttribute(const char* name, const char* value, size_t length)
+  {
+    Attribute attribute;
+    attribute.Name = vtkPVXMLInternName(name);
+    attribute.Value = this->AppendValue(value, length);
+    this->Attributes.push_back(attribute);
+    this->ScalarValues.clear();
+  }
+
+  void SetValue(size_t index, const char* value)
+  {
+    const size_t length = strlen(value);
+    char* current = &this->AttributeValues[this->Attributes[index].Value];
+    const size_t currentLength = strlen(current);
+    if (length <= currentLength)
+    {
+      memmove(current, value, length);
+      current[length] = '\0';
+      this->UsedValueSize -= currentLength - length;
+    }
+    else
+    {
+      this->UsedValueSize -= currentLength + 1;
+      this->Attributes[index].Value = this->AppendValue(value, length);
+      this->CompactValues();
+    }
+    this->ScalarValues.clear();
+  }
+
+  void RemoveAttribute(size_t index)
+  {
+    this->UsedValueSize -= strlen(this->GetValue(index)) + 1;
+    this->Attributes.erase(this->Attributes.begin() + index);
+    this->ScalarValues.clear();
+    this->CompactValues();
+  }
+
+  void CopyAttributes(const vtkPVXMLElementInternals* other)
+  {
+    this->Attributes = other->Attributes;
+    this->AttributeValues = other->AttributeValues;
+    this->UsedValueSize = other->UsedValueSize;
+    this->ScalarValues.clear();
+  }
+
+  void ClearAttributes()
+  {
+    this->Attributes.clear();
+    this->AttributeValues.clear();
+    this->UsedValueSize = 0;
+    this->ScalarValues.clear();
+  }
+
+  // Drops overwritten values once they make up most of the buffer.
+  void CompactValues()
+  {
+    if (this->AttributeValues.size() < 256 ||
+      this->AttributeValues.size() < 2 * this->UsedValueSize)
+    {
+      return;
+    }
+    std::string values;
+    values.reserve(this->UsedValueSize);
+    for (auto& attribute : this->Attributes)
+    {
+      const char* value = this->AttributeValues.c_str() + attribute.Value;
+      attribute.Value = values.size();
+      values.append(value, strlen(value) + 1);
+    }
+    this->AttributeValues.swap(values);
+    this->UsedValueSize = this->AttributeValues.size();
+  }
 };
 
 // Function to check if a string is full of whitespace characters.
@@ -144,8 +315,7 @@ void vtkPVXMLElement::AddAttribute(const char* attrName, const char* attrValue)
     return;
   }
 
-  this->Internal->AttributeNames.push_back(attrName);
-  this->Internal->AttributeValues.push_back(attrValue);
+  this->Internal->AddAttribute(attrName, attrValue, strlen(attrValue));
 }
 
 //----------------------------------------------------------------------------
@@ -156,16 +326,12 @@ void vtkPVXMLElement::SetAttribute(const char* attrName, const char* attrValue)
     return;
   }
 
-  // iterate over the names, and find if the attribute name exists.
-  size_t numAttributes = this->Internal->AttributeNames.size();
-  size_t i;
-  for (i = 0; i < numAttributes; ++i)
+  // find if the attribute name exists.
+  int index = this->Internal->FindAttribute(attrName);
+  if (index >= 0)
   {
-    if (strcmp(this->Internal->AttributeNames[i].c_str(), attrName) == 0)
-    {
-      this->Internal->AttributeValues[i] = attrValue;
-      return;
-    }
+    this->Internal->SetValue(index, attrValue);
+    return;
   }
   // add the attribute.
   this->AddAttribute(attrName, attrValue);
@@ -174,8 +340,7 @@ void vtkPVXMLElement::SetAttribute(const char* attrName, const char* attrValue)
 //----------------------------------------------------------------------------
 void vtkPVXMLElement::ReadXMLAttributes(const char** atts)
 {
-  this->Internal->AttributeNames.clear();
-  this->Internal->AttributeValues.clear();
+  this->Internal->ClearAttributes();
 
   if (atts)
   {
@@ -186,6 +351,7 @@ void vtkPVXMLElement::ReadXMLAttributes(const char** atts)
       ++count;
     }
     unsigned int numberOfAttributes = count / 2;
+    this->Internal->Attributes.reserve(numberOfAttributes);
 
     unsigned int i;
     for (i = 0; i < numberOfAttributes; ++i)
@@ -255,16 +421,8 @@ void vtkPVXMLElement::AddCharacterData(const char* data, int length)
 //----------------------------------------------------------------------------
 const char* vtkPVXMLElement::GetAttributeOrDefault(const char* name, const char* notFound)
 {
-  size_t numAttributes = this->Internal->AttributeNames.size();
-  size_t i;
-  for (i = 0; i < numAttributes; ++i)
-  {
-    if (strcmp(this->Internal->AttributeNames[i].c_str(), name) == 0)
-    {
-      return this->Internal->AttributeValues[i].c_str();
-    }
-  }
-  return notFound;
+  int index = this->Internal->FindAttribute(name);
+  return index >= 0 ? this->Internal->GetValue(index) : notFound;
 }
 //----------------------------------------------------------------------------
 const char* vtkPVXMLElement::GetCharacterData()
@@ -282,12 +440,12 @@ void vtkPVXMLElement::PrintXML()
 void vtkPVXMLElement::PrintXML(ostream& os, vtkIndent indent)
 {
   os << indent << "<" << (this->Name ? this->Name : "NoName");
-  size_t numAttributes = this->Internal->AttributeNames.size();
+  size_t numAttributes = this->Internal->Attributes.size();
   size_t i;
   for (i = 0; i < numAttributes; ++i)
   {
-    const char* aName = this->Internal->AttributeNames[i].c_str();
-    const char* aValue = this->Internal->AttributeValues[i].c_str();
+    const char* aName = this->Internal->Attributes[i].Name;
+    const char* aValue = this->Internal->GetValue(i);
 
     // we always print the encoded value. The expat parser processes encoded
     // values when reading them, hence we don't need any decoding when reading
@@ -454,30 +612,93 @@ vtkPVXMLElement* vtkPVXMLElement::LookupElementUpScope(const char* id)
 }
 
 //----------------------------------------------------------------------------
-int vtkPVXMLElement::GetScalarAttribute(const char* name, int* value)
+// Parses one number the way `istream >> value` does, without the cost of
+// setting up a stream for every attribute.
+static bool vtkPVXMLParseNumber(const char*& str, bool floating)
 {
-  return this->GetVectorAttribute(name, 1, value);
+  while (isspace(*str))
+  {
+    ++str;
+  }
+  const char* digits = (*str == '+' || *str == '-') ? str + 1 : str;
+  // streams do not accept "nan" or "inf", nor hexadecimal floating values.
+  return isdigit(*digits) || (floating && *digits == '.');
 }
 
-//----------------------------------------------------------------------------
-int vtkPVXMLElement::GetScalarAttribute(const char* name, float* value)
+static bool vtkPVXMLParseValue(const char*& str, int& value)
 {
-  return this->GetVectorAttribute(name, 1, value);
+  if (!vtkPVXMLParseNumber(str, false))
+  {
+    return false;
+  }
+  char* end;
+  errno = 0;
+  long result = strtol(str, &end, 10);
+  if (errno == ERANGE || result < VTK_INT_MIN || result > VTK_INT_MAX)
+  {
+    return false;
+  }
+  value = static_cast<int>(result);
+  str = end;
+  return true;
 }
 
-//----------------------------------------------------------------------------
-int vtkPVXMLElement::GetScalarAttribute(const char* name, double* value)
+#if defined(VTK_USE_64BIT_IDS)
+static bool vtkPVXMLParseValue(const char*& str, vtkIdType& value)
 {
-  return this->GetVectorAttribute(name, 1, value);
+  if (!vtkPVXMLParseNumber(str, false))
+  {
+    return false;
+  }
+  char* end;
+  errno = 0;
+  long long result = strtoll(str, &end, 10);
+  if (errno == ERANGE)
+  {
+    return false;
+  }
+  value = static_cast<vtkIdType>(result);
+  str = end;
+  return true;
 }
+#endif
 
-#if defined(VTK_USE_64BIT_IDS)
-//----------------------------------------------------------------------------
-int vtkPVXMLElement::GetScalarAttribute(const char* name, vtkIdType* value)
+static bool vtkPVXMLParseValue(const char*& str, double& value)
 {
-  return this->GetVectorAttribute(name, 1, value);
+  if (!vtkPVXMLParseNumber(str, true))
+  {
+    return false;
+  }
+  const char* digits = (*str == '+' || *str == '-') ? str + 1 : str;
+  if (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X'))
+  {
+    // strtod() reads hexadecimal values, streams stop after the "0".
+    value = *str == '-' ? -0.0 : 0.0;
+    str = digits + 1;
+    return true;
+  }
+  char* end;
+  errno = 0;
+  double result = strtod(str, &end);
+  if (end == str || (errno == ERANGE && std::abs(result) == HUGE_VAL))
+  {
+    return false;
+  }
+  value = result;
+  str = end;
+  return true;
+}
+
+static bool vtkPVXMLParseValue(const char*& str, float& value)
+{
+  double result;
+  if (!vtkPVXMLParseValue(str, result) || std::abs(result) > FLT_MAX)
+  {
+    return false;
+  }
+  value = static_cast<float>(result);
+  return true;
 }
-#endif
 
 //----------------------------------------------------------------------------
 template <class T>
@@ -487,13 +708,9 @@ int vtkPVXMLVectorAttributeParse(const char* str, int length, T* data)
   {
     return 0;
   }
-  std::stringstream vstr;
-  vstr << str << ends;
-  int i;
-  for (i = 0; i < length; ++i)
+  for (int i = 0; i < length; ++i)
   {
-    vstr >> data[i];
-    if (!vstr)
+    if (!vtkPVXMLParseValue(str, data[i]))
     {
       return i;
     }
@@ -501,6 +718,97 @@ int vtkPVXMLVectorAttributeParse(const char* str, int length, T* data)
   return length;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+typedef vtkPVXMLElementInternals::ScalarValue vtkPVXMLScalarValue;
+
+int& vtkPVXMLGetScalarSlot(vtkPVXMLScalarValue& scalar, int*, unsigned char& bit)
+{
+  bit = 0x1;
+  return scalar.Int;
+}
+
+float& vtkPVXMLGetScalarSlot(vtkPVXMLScalarValue& scalar, float*, unsigned char& bit)
+{
+  bit = 0x2;
+  return scalar.Float;
+}
+
+double& vtkPVXMLGetScalarSlot(vtkPVXMLScalarValue& scalar, double*, unsigned char& bit)
+{
+  bit = 0x4;
+  return scalar.Double;
+}
+
+#if defined(VTK_USE_64BIT_IDS)
+vtkIdType& vtkPVXMLGetScalarSlot(vtkPVXMLScalarValue& scalar, vtkIdType*, unsigned char& bit)
+{
+  bit = 0x8;
+  return scalar.IdType;
+}
+#endif
+
+// Parses a scalar attribute once per type and serves later queries from the
+// cache, since state loading asks for the same attributes over and over.
+template <class T>
+int vtkPVXMLGetScalarAttribute(vtkPVXMLElementInternals* internal, const char* name, T* value)
+{
+  const int index = internal->FindAttribute(name);
+  if (index < 0)
+  {
+    return 0;
+  }
+  if (internal->ScalarValues.size() != internal->Attributes.size())
+  {
+    internal->ScalarValues.assign(internal->Attributes.size(), vtkPVXMLScalarValue());
+  }
+  vtkPVXMLScalarValue& scalar = internal->ScalarValues[index];
+  unsigned char bit;
+  T& slot = vtkPVXMLGetScalarSlot(scalar, value, bit);
+  if ((scalar.Parsed & bit) == 0)
+  {
+    scalar.Parsed |= bit;
+    if (vtkPVXMLVectorAttributeParse(internal->GetValue(index), 1, &slot) == 1)
+    {
+      scalar.Valid |= bit;
+    }
+  }
+  if ((scalar.Valid & bit) == 0)
+  {
+    return 0;
+  }
+  *value = slot;
+  return 1;
+}
+}
+
+//----------------------------------------------------------------------------
+int vtkPVXMLElement::GetScalarAttribute(const char* name, int* value)
+{
+  return vtkPVXMLGetScalarAttribute(this->Internal, name, value);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVXMLElement::GetScalarAttribute(const char* name, float* value)
+{
+  return vtkPVXMLGetScalarAttribute(this->Internal, name, value);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVXMLElement::GetScalarAttribute(const char* name, double* value)
+{
+  return vtkPVXMLGetScalarAttribute(this->Internal, name, value);
+}
+
+#if defined(VTK_USE_64BIT_IDS)
+//----------------------------------------------------------------------------
+int vtkPVXMLElement::GetScalarAttribute(const char* name, vtkIdType* value)
+{
+  return vtkPVXMLGetScalarAttribute(this->Internal, name, value);
+}
+#endif
+
 //----------------------------------------------------------------------------
 int vtkPVXMLElement::GetVectorAttribute(const char* name, int length, int* data)
 {
@@ -660,25 +968,25 @@ void vtkPVXMLElement::Merge(vtkPVXMLElement* element, const char* attributeName)
   }
 
   // add attributes from element to this, or override attribute values on this
-  size_t numAttributes = element->Internal->AttributeNames.size();
-  size_t numAttributes2 = this->Internal->AttributeNames.size();
+  size_t numAttributes = element->Internal->Attributes.size();
+  size_t numAttributes2 = this->Internal->Attributes.size();
 
   for (size_t i = 0; i < numAttributes; ++i)
   {
     bool found = false;
     for (size_t j = 0; !found && j < numAttributes2; ++j)
     {
-      if (element->Internal->AttributeNames[i] == this->Internal->AttributeNames[j])
+      // names are interned, comparing the pointers is enough.
+      if (element->Internal->Attributes[i].Name == this->Internal->Attributes[j].Name)
       {
-        this->Internal->AttributeValues[j] = element->Internal->AttributeValues[i];
+        this->Internal->SetValue(j, element->Internal->GetValue(i));
         found = true;
       }
     }
     // if not found, add it
     if (!found)
     {
-      this->AddAttribute(element->Internal->AttributeNames[i].c_str(),
-        element->Internal->AttributeValues[i].c_str());
+      this->AddAttribute(element->Internal->Attributes[i].Name, element->Internal->GetValue(i));
     }
   }
 
@@ -709,8 +1017,7 @@ void vtkPVXMLElement::Merge(vtkPVXMLElement* element, const char* attributeName)
       vtkSmartPointer<vtkPVXMLElement> newElement = vtkSmartPointer<vtkPVXMLElement>::New();
       newElement->SetName((*iter)->GetName());
       newElement->SetId((*iter)->GetId());
-      newElement->Internal->AttributeNames = (*iter)->Internal->AttributeNames;
-      newElement->Internal->AttributeValues = (*iter)->Internal->AttributeValues;
+      newElement->Internal->CopyAttributes((*iter)->Internal);
       this->AddNestedElement(newElement);
       newElement->Merge(*iter, attributeName);
     }
@@ -722,8 +1029,7 @@ void vtkPVXMLElement::CopyTo(vtkPVXMLElement* other)
 {
   other->SetName(GetName());
   other->SetId(GetId());
-  other->Internal->AttributeNames = this->Internal->AttributeNames;
-  other->Internal->AttributeValues = this->Internal->AttributeValues;
+  other->Internal->CopyAttributes(this->Internal);
   other->AddCharacterData(
     this->Internal->CharacterData.c_str(), static_cast<int>(this->Internal->CharacterData.size()));
 
@@ -743,12 +1049,163 @@ void vtkPVXMLElement::CopyAttributesTo(vtkPVXMLElement* other)
 {
   other->SetName(GetName());
   other->SetId(GetId());
-  other->Internal->AttributeNames = this->Internal->AttributeNames;
-  other->Internal->AttributeValues = this->Internal->AttributeValues;
+  other->Internal->CopyAttributes(this->Internal);
   other->AddCharacterData(
     this->Internal->CharacterData.c_str(), static_cast<int>(this->Internal->CharacterData.size()));
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Strings are saved as their 32-bit length followed by their characters. A
+// length of ~0 stands for a null string.
+const vtkTypeUInt32 vtkPVXMLNullString = ~static_cast<vtkTypeUInt32>(0);
+
+void vtkPVXMLSaveBinary(std::string& buffer, vtkTypeUInt32 value)
+{
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void vtkPVXMLSaveBinary(std::string& buffer, const char* str, size_t length)
+{
+  vtkPVXMLSaveBinary(buffer, str ? static_cast<vtkTypeUInt32>(length) : vtkPVXMLNullString);
+  if (str)
+  {
+    buffer.append(str, length);
+  }
+}
+
+bool vtkPVXMLLoadBinary(const char*& data, const char* end, vtkTypeUInt32& value)
+{
+  if (end - data < static_cast<std::ptrdiff_t>(sizeof(value)))
+  {
+    return false;
+  }
+  memcpy(&value, data, sizeof(value));
+  data += sizeof(value);
+  return true;
+}
+
+// `str` points into the buffer and is not null terminated.
+bool vtkPVXMLLoadBinary(
+  const char*& data, const char* end, const char*& str, vtkTypeUInt32& length)
+{
+  if (!vtkPVXMLLoadBinary(data, end, length))
+  {
+    return false;
+  }
+  if (length == vtkPVXMLNullString)
+  {
+    str = nullptr;
+    length = 0;
+    return true;
+  }
+  if (end - data < static_cast<std::ptrdiff_t>(length))
+  {
+    return false;
+  }
+  str = data;
+  data += length;
+  return true;
+}
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElement::SaveBinary(std::string& buffer)
+{
+  vtkPVXMLSaveBinary(buffer, this->Name, this->Name ? strlen(this->Name) : 0);
+  vtkPVXMLSaveBinary(buffer, this->Id, this->Id ? strlen(this->Id) : 0);
+
+  const auto& attributes = this->Internal->Attributes;
+  vtkPVXMLSaveBinary(buffer, static_cast<vtkTypeUInt32>(attributes.size()));
+  for (size_t cc = 0; cc < attributes.size(); ++cc)
+  {
+    const char* value = this->Internal->GetValue(cc);
+    vtkPVXMLSaveBinary(buffer, attributes[cc].Name, strlen(attributes[cc].Name));
+    vtkPVXMLSaveBinary(buffer, value, strlen(value));
+  }
+
+  const auto& data = this->Internal->CharacterData;
+  vtkPVXMLSaveBinary(buffer, data.c_str(), data.size());
+
+  vtkPVXMLSaveBinary(buffer, static_cast<vtkTypeUInt32>(this->Internal->NestedElements.size()));
+  for (auto& nested : this->Internal->NestedElements)
+  {
+    nested->SaveBinary(buffer);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkPVXMLElement::NewFromBinary(
+  const char*& data, const char* end, int maxDepth)
+{
+  if (maxDepth <= 0)
+  {
+    return nullptr;
+  }
+  const char* str;
+  vtkTypeUInt32 length;
+  vtkSmartPointer<vtkPVXMLElement> element = vtkSmartPointer<vtkPVXMLElement>::New();
+  if (!vtkPVXMLLoadBinary(data, end, str, length))
+  {
+    return nullptr;
+  }
+  element->SetName(str ? std::string(str, length).c_str() : nullptr);
+  if (!vtkPVXMLLoadBinary(data, end, str, length))
+  {
+    return nullptr;
+  }
+  element->SetId(str ? std::string(str, length).c_str() : nullptr);
+
+  vtkTypeUInt32 count;
+  if (!vtkPVXMLLoadBinary(data, end, count))
+  {
+    return nullptr;
+  }
+  // every attribute takes at least 8 bytes, don't trust `count` further.
+  element->Internal->Attributes.reserve(
+    std::min(static_cast<size_t>(count), static_cast<size_t>(end - data) / 8));
+  for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+  {
+    const char* value;
+    vtkTypeUInt32 valueLength;
+    if (!vtkPVXMLLoadBinary(data, end, str, length) ||
+      !vtkPVXMLLoadBinary(data, end, value, valueLength))
+    {
+      return nullptr;
+    }
+    element->Internal->AddAttribute(
+      std::string(str ? str : "", length).c_str(), value ? value : "", valueLength);
+  }
+
+  if (!vtkPVXMLLoadBinary(data, end, str, length))
+  {
+    return nullptr;
+  }
+  element->Internal->CharacterData.assign(str ? str : "", length);
+
+  if (!vtkPVXMLLoadBinary(data, end, count))
+  {
+    return nullptr;
+  }
+  // every element takes at least 20 bytes.
+  element->Internal->NestedElements.reserve(
+    std::min(static_cast<size_t>(count), static_cast<size_t>(end - data) / 20));
+  for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+  {
+    vtkPVXMLElement* nested = vtkPVXMLElement::NewFromBinary(data, end, maxDepth - 1);
+    if (!nested)
+    {
+      return nullptr;
+    }
+    element->AddNestedElement(nested);
+    nested->Delete();
+  }
+
+  element->Register(nullptr);
+  return element;
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVXMLElement::Equals(vtkPVXMLElement* other)
 {
@@ -770,18 +1227,10 @@ bool vtkPVXMLElement::Equals(vtkPVXMLElement* other)
 //----------------------------------------------------------------------------
 void vtkPVXMLElement::RemoveAttribute(const char* name)
 {
-  std::vector<std::string>::iterator nameIterator = this->Internal->AttributeNames.begin();
-  std::vector<std::string>::iterator valueIterator = this->Internal->AttributeValues.begin();
-  while (nameIterator != this->Internal->AttributeNames.end())
+  int index = this->Internal->FindAttribute(name);
+  if (index >= 0)
   {
-    if (strcmp(nameIterator->c_str(), name) == 0)
-    {
-      this->Internal->AttributeNames.erase(nameIterator);
-      this->Internal->AttributeValues.erase(valueIterator);
-      return;
-    }
-    nameIterator++;
-    valueIterator++;
+    this->Internal->RemoveAttribute(index);
   }
 }
 
@@ -26,6 +26,8 @@
 #include "vtkPVCoreModule.h" // needed for export macro
 #include "vtkStdString.h"    // needed for vtkStdString.
 
+#include <string> // needed for std::string
+
 class vtkCollection;
 class vtkPVXMLParser;
 
@@ -262,6 +264,18 @@ public:
    */
   void CopyAttributesTo(vtkPVXMLElement* other);
 
+  //@{
+  /**
+   * Append this element, including all nested elements, to `buffer` in a
+   * compact binary form. NewFromBinary() rebuilds such an element without
+   * parsing any XML, advancing `data` past it; it returns nullptr if the data
+   * is truncated or invalid, including elements nested deeper than
+   * `maxDepth`. This is used to cache parsed XML, e.g. proxy definitions.
+   */
+  void SaveBinary(std::string& buffer);
+  static vtkPVXMLElement* NewFromBinary(const char*& data, const char* end, int maxDepth = 256);
+  //@}
+
 protected:
   vtkPVXMLElement();
   ~vtkPVXMLElement() override;
@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVMultiAlgorithmPortsInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVMultiAlgorithmPortsInformation.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkClientServerStream.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVAlgorithmPortsInformation.h"
+#include "vtkPVSessionBase.h"
+#include "vtkProcessModule.h"
+#include "vtkSIProxy.h"
+
+vtkStandardNewMacro(vtkPVMultiAlgorithmPortsInformation);
+
+//----------------------------------------------------------------------------
+vtkPVMultiAlgorithmPortsInformation::vtkPVMultiAlgorithmPortsInformation()
+{
+  this->RootOnly = 1;
+}
+
+//----------------------------------------------------------------------------
+vtkPVMultiAlgorithmPortsInformation::~vtkPVMultiAlgorithmPortsInformation()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMultiAlgorithmPortsInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfGlobalIDs: " << this->GlobalIDs.size() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMultiAlgorithmPortsInformation::AddGlobalID(vtkTypeUInt32 gid)
+{
+  this->GlobalIDs.push_back(gid);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMultiAlgorithmPortsInformation::RemoveAllGlobalIDs()
+{
+  this->GlobalIDs.clear();
+  this->NumberOfOutputs.clear();
+  this->NumberOfRequiredInputs.clear();
+}
+
+//----------------------------------------------------------------------------
+unsigned int vtkPVMultiAlgorithmPortsInformation::GetNumberOfGlobalIDs()
+{
+  return static_cast<unsigned int>(this->GlobalIDs.size());
+}
+
+//----------------------------------------------------------------------------
+int vtkPVMultiAlgorithmPortsInformation::GetNumberOfOutputs(unsigned int index)
+{
+  return index < this->NumberOfOutputs.size() ? this->NumberOfOutputs[index] : -1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVMultiAlgorithmPortsInformation::GetNumberOfRequiredInputs(unsigned int index)
+{
+  return index < this->NumberOfRequiredInputs.size() ? this->NumberOfRequiredInputs[index] : -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMultiAlgorithmPortsInformation::CopyFromObject(vtkObject*)
+{
+  this->NumberOfOutputs.assign(this->GlobalIDs.size(), -1);
+  this->NumberOfRequiredInputs.assign(this->GlobalIDs.size(), -1);
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkPVSessionBase* session = vtkPVSessionBase::SafeDownCast(pm ? pm->GetSession() : NULL);
+  if (!session)
+  {
+    vtkErrorMacro("No session to look the proxies up from.");
+    return;
+  }
+
+  vtkNew<vtkPVAlgorithmPortsInformation> ports;
+  for (size_t cc = 0; cc < this->GlobalIDs.size(); ++cc)
+  {
+    vtkSIProxy* siProxy = vtkSIProxy::SafeDownCast(session->GetSIObject(this->GlobalIDs[cc]));
+    vtkAlgorithm* algorithm =
+      vtkAlgorithm::SafeDownCast(siProxy ? siProxy->GetVTKObject() : NULL);
+    if (algorithm)
+    {
+      ports->CopyFromObject(algorithm);
+      this->NumberOfOutputs[cc] = ports->GetNumberOfOutputs();
+      this->NumberOfRequiredInputs[cc] = ports->GetNumberOfRequiredInputs();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMultiAlgorithmPortsInformation::AddInformation(vtkPVInformation* info)
+{
+  if (vtkPVMultiAlgorithmPortsInformation* other =
+        vtkPVMultiAlgorithmPortsInformation::SafeDownCast(info))
+  {
+    this->NumberOfOutputs = other->NumberOfOutputs;
+    this->NumberOfRequiredInputs = other->NumberOfRequiredInputs;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMultiAlgorithmPortsInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << static_cast<int>(this->NumberOfOutputs.size());
+  for (size_t cc = 0; cc < this->NumberOfOutputs.size(); ++cc)
+  {
+    *css << this->NumberOfOutputs[cc] << this->NumberOfRequiredInputs[cc];
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMultiAlgorithmPortsInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  int count = 0;
+  css->GetArgument(0, 0, &count);
+  this->NumberOfOutputs.assign(count, -1);
+  this->NumberOfRequiredInputs.assign(count, -1);
+  for (int cc = 0; cc < count; ++cc)
+  {
+    css->GetArgument(0, 1 + 2 * cc, &this->NumberOfOutputs[cc]);
+    css->GetArgument(0, 2 + 2 * cc, &this->NumberOfRequiredInputs[cc]);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMultiAlgorithmPortsInformation::CopyParametersToStream(vtkMultiProcessStream& str)
+{
+  str << 828793 << static_cast<unsigned int>(this->GlobalIDs.size());
+  for (auto gid : this->GlobalIDs)
+  {
+    str << gid;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMultiAlgorithmPortsInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
+{
+  int magic_number;
+  unsigned int count;
+  str >> magic_number >> count;
+  if (magic_number != 828793)
+  {
+    vtkErrorMacro("Magic number mismatch.");
+    return;
+  }
+  this->GlobalIDs.resize(count);
+  for (unsigned int cc = 0; cc < count; ++cc)
+  {
+    str >> this->GlobalIDs[cc];
+  }
+}
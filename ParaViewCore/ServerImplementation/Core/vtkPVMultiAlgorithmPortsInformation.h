@@ -0,0 +1,105 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVMultiAlgorithmPortsInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVMultiAlgorithmPortsInformation
+ * @brief   Holds number of ports of several algorithms
+ *
+ * vtkPVMultiAlgorithmPortsInformation is the equivalent of
+ * vtkPVAlgorithmPortsInformation for several proxies at once. The global ids
+ * of the proxies are passed as parameters and the information must be
+ * gathered with a global id of 0. This lets the client fetch the number of
+ * ports of many source proxies in a single round trip, e.g. when loading a
+ * state file.
+*/
+
+#ifndef vtkPVMultiAlgorithmPortsInformation_h
+#define vtkPVMultiAlgorithmPortsInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkPVServerImplementationCoreModule.h" //needed for exports
+
+#include <vector> // needed for std::vector
+
+class VTKPVSERVERIMPLEMENTATIONCORE_EXPORT vtkPVMultiAlgorithmPortsInformation
+  : public vtkPVInformation
+{
+public:
+  static vtkPVMultiAlgorithmPortsInformation* New();
+  vtkTypeMacro(vtkPVMultiAlgorithmPortsInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set the global ids of the proxies to gather the information from.
+   */
+  void AddGlobalID(vtkTypeUInt32 gid);
+  void RemoveAllGlobalIDs();
+  unsigned int GetNumberOfGlobalIDs();
+  //@}
+
+  //@{
+  /**
+   * Get the number of outputs and the number of required inputs of the
+   * algorithm of the proxy at the given index, in the order the global ids
+   * were added. Both are -1 when the information is not available, e.g. when
+   * the proxy does not exist or its VTK object is not a vtkAlgorithm.
+   */
+  int GetNumberOfOutputs(unsigned int index);
+  int GetNumberOfRequiredInputs(unsigned int index);
+  //@}
+
+  /**
+   * Transfer information about the proxies into this object. Expects NULL,
+   * the proxies are looked up by their global ids.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  //@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  //@}
+
+  //@{
+  /**
+   * Serialize/Deserialize the parameters that control how/what information is
+   * gathered. These are different from the ivars that constitute the gathered
+   * information itself.
+   */
+  void CopyParametersToStream(vtkMultiProcessStream&) override;
+  void CopyParametersFromStream(vtkMultiProcessStream&) override;
+  //@}
+
+protected:
+  vtkPVMultiAlgorithmPortsInformation();
+  ~vtkPVMultiAlgorithmPortsInformation() override;
+
+  std::vector<vtkTypeUInt32> GlobalIDs;
+  std::vector<int> NumberOfOutputs;
+  std::vector<int> NumberOfRequiredInputs;
+
+private:
+  vtkPVMultiAlgorithmPortsInformation(const vtkPVMultiAlgorithmPortsInformation&) = delete;
+  void operator=(const vtkPVMultiAlgorithmPortsInformation&) = delete;
+};
+
+#endif
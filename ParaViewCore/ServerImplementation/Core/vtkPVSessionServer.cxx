@@ -534,25 +534,51 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
   switch (type)
   {
     case vtkPVSessionServer::PUSH:
+    case vtkPVSessionServer::PUSH_BATCH:
     {
-      std::string string;
-      stream >> string;
-      vtkSMMessage msg;
-      msg.ParseFromString(string);
-
-      //      cout << "=================================" << endl;
-      //      msg.PrintDebugString();
-      //      cout << "=================================" << endl;
-
-      // Do we skip the processing ?
-      if (!this->Internal->StoreShareOnly(&msg))
+      // a batch is a sequence of states and streams, processed in order.
+      int count = 1;
+      if (type == vtkPVSessionServer::PUSH_BATCH)
       {
-        this->PushState(&msg);
+        stream >> count;
+      }
+      for (int cc = 0; cc < count; ++cc)
+      {
+        int request = vtkPVSessionServer::PUSH;
+        if (type == vtkPVSessionServer::PUSH_BATCH)
+        {
+          stream >> request;
+        }
+        if (request == vtkPVSessionServer::EXECUTE_STREAM)
+        {
+          int ignore_errors;
+          std::string data;
+          stream >> ignore_errors >> data;
+          vtkClientServerStream cssStream;
+          cssStream.SetData(reinterpret_cast<const unsigned char*>(data.c_str()), data.size());
+          this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
+          continue;
+        }
+
+        std::string string;
+        stream >> string;
+        vtkSMMessage msg;
+        msg.ParseFromString(string);
+
+        //      cout << "=================================" << endl;
+        //      msg.PrintDebugString();
+        //      cout << "=================================" << endl;
+
+        // Do we skip the processing ?
+        if (!this->Internal->StoreShareOnly(&msg))
+        {
+          this->PushState(&msg);
+        }
+
+        // Notify when ProxyManager state has changed
+        // or any other state change
+        this->NotifyOtherClients(&msg);
       }
-
-      // Notify when ProxyManager state has changed
-      // or any other state change
-      this->NotifyOtherClients(&msg);
     }
     break;
 
@@ -35,19 +35,71 @@
 #include "vtkTimerLog.h"
 
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <map>
+#include <memory>
+#include <random>
 #include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <vtksys/Directory.hxx>
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
 //****************************************************************************/
 typedef vtkSmartPointer<vtkPVXMLElement> XMLElement;
-typedef std::map<std::string, XMLElement> StrToXmlMap;
+
+// A proxy definition. Definitions loaded from the definition cache are kept
+// in their binary form until first used.
+class vtkSIProxyDefinition
+{
+public:
+  vtkSIProxyDefinition()
+    : Offset(0)
+    , Size(0)
+  {
+  }
+  vtkSIProxyDefinition(vtkPVXMLElement* element)
+    : Element(element)
+    , Offset(0)
+    , Size(0)
+  {
+  }
+  vtkSIProxyDefinition(const std::shared_ptr<const std::string>& cache, size_t offset, size_t size)
+    : Cache(cache)
+    , Offset(offset)
+    , Size(size)
+  {
+  }
+
+  vtkPVXMLElement* GetPointer() const
+  {
+    if (!this->Element && this->Cache)
+    {
+      const char* data = this->Cache->data() + this->Offset;
+      this->Element.TakeReference(vtkPVXMLElement::NewFromBinary(data, data + this->Size));
+      this->Cache.reset();
+    }
+    return this->Element.GetPointer();
+  }
+  operator vtkPVXMLElement*() const { return this->GetPointer(); }
+  vtkPVXMLElement* operator->() const { return this->GetPointer(); }
+
+private:
+  mutable XMLElement Element;
+  mutable std::shared_ptr<const std::string> Cache;
+  size_t Offset;
+  size_t Size;
+};
+
+typedef std::map<std::string, vtkSIProxyDefinition> StrToXmlMap;
 typedef std::map<std::string, StrToXmlMap> StrToStrToXmlMap;
 
 class vtkSIProxyDefinitionManager::vtkInternals
@@ -765,9 +817,317 @@ bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(const char* xml
 bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(
   const char* xmlContent, bool attachHints)
 {
+  // definitions cached by an earlier run don't need to be parsed again.
+  if (this->LoadDefinitionCache(xmlContent, attachHints))
+  {
+    return true;
+  }
+
   vtkNew<vtkPVXMLParser> parser;
-  return (parser->Parse(xmlContent) != 0) &&
-    this->LoadConfigurationXML(parser->GetRootElement(), attachHints);
+  if (parser->Parse(xmlContent) == 0)
+  {
+    return false;
+  }
+  this->SaveDefinitionCache(xmlContent, attachHints, parser->GetRootElement());
+  return this->LoadConfigurationXML(parser->GetRootElement(), attachHints);
+}
+
+namespace
+{
+// The definition cache has one file per configuration xml string, with a
+// header holding that whole string followed by its proxy definitions, each
+// saved as: group name, proxy name, extension flag, size, binary element and
+// a checksum of all of these. The file name is derived from a hash of the
+// string, so the string itself is compared when loading to rule out
+// collisions; comparing it is still much cheaper than parsing it.
+const vtkTypeUInt32 vtkSIDefinitionCacheMagic = 0x43445650; // "PVDC"
+const vtkTypeUInt32 vtkSIDefinitionCacheVersion = 3;
+const char* vtkSIDefinitionCachePrefix = "pvdefinitions-";
+
+// 64-bit FNV-1a. Checking it is much cheaper than parsing the XML, so all
+// entries are checked up front even though they are decoded lazily.
+vtkTypeUInt64 vtkSIDefinitionCacheChecksum(const char* data, size_t size)
+{
+  vtkTypeUInt64 checksum = 14695981039346656037ull;
+  for (size_t cc = 0; cc < size; ++cc)
+  {
+    checksum ^= static_cast<unsigned char>(data[cc]);
+    checksum *= 1099511628211ull;
+  }
+  return checksum;
+}
+
+std::string vtkSIDefinitionCacheFileName(
+  const char* xmlContent, bool attachHints, vtkTypeUInt64& key)
+{
+  const char* dir = vtksys::SystemTools::GetEnv("PV_PROXY_DEFINITION_CACHE_DIR");
+  if (!dir || !*dir || !xmlContent)
+  {
+    return std::string();
+  }
+  key = static_cast<vtkTypeUInt64>(std::hash<std::string>()(xmlContent));
+  key = key * 2 + (attachHints ? 1 : 0);
+
+  char name[64];
+  snprintf(name, sizeof(name), "%s%016llx.bin", vtkSIDefinitionCachePrefix,
+    static_cast<unsigned long long>(key));
+  return std::string(dir) + "/" + name;
+}
+
+void vtkSIDefinitionCacheWrite(std::string& buffer, vtkTypeUInt64 value)
+{
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void vtkSIDefinitionCacheWrite(std::string& buffer, const std::string& value)
+{
+  vtkSIDefinitionCacheWrite(buffer, static_cast<vtkTypeUInt64>(value.size()));
+  buffer.append(value);
+}
+
+bool vtkSIDefinitionCacheRead(const std::string& buffer, size_t& pos, vtkTypeUInt64& value)
+{
+  if (buffer.size() - pos < sizeof(value))
+  {
+    return false;
+  }
+  memcpy(&value, buffer.data() + pos, sizeof(value));
+  pos += sizeof(value);
+  return true;
+}
+
+bool vtkSIDefinitionCacheRead(const std::string& buffer, size_t& pos, std::string& value)
+{
+  vtkTypeUInt64 size;
+  if (!vtkSIDefinitionCacheRead(buffer, pos, size) || buffer.size() - pos < size)
+  {
+    return false;
+  }
+  value.assign(buffer.data() + pos, static_cast<size_t>(size));
+  pos += static_cast<size_t>(size);
+  return true;
+}
+
+// Removes the cache files in `dir` that were written by another version of
+// the cache format, since they can never be loaded again.
+void vtkSIDefinitionCachePrune(const std::string& dir)
+{
+  vtksys::Directory directory;
+  if (!directory.Load(dir))
+  {
+    return;
+  }
+  const size_t prefixLength = strlen(vtkSIDefinitionCachePrefix);
+  for (unsigned long cc = 0; cc < directory.GetNumberOfFiles(); ++cc)
+  {
+    const std::string name = directory.GetFile(cc);
+    if (name.compare(0, prefixLength, vtkSIDefinitionCachePrefix) != 0 ||
+      vtksys::SystemTools::GetFilenameLastExtension(name) != ".bin")
+    {
+      continue;
+    }
+    const std::string path = dir + "/" + name;
+    vtkTypeUInt64 header[2] = { 0, 0 };
+    {
+      std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+      file.read(reinterpret_cast<char*>(header), sizeof(header));
+    }
+    if (header[0] != vtkSIDefinitionCacheMagic || header[1] != vtkSIDefinitionCacheVersion)
+    {
+      std::remove(path.c_str());
+    }
+  }
+}
+}
+
+//---------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::LoadDefinitionCache(const char* xmlContent, bool attachHints)
+{
+  vtkTypeUInt64 key = 0;
+  const std::string fileName = vtkSIDefinitionCacheFileName(xmlContent, attachHints, key);
+  if (fileName.empty())
+  {
+    return false;
+  }
+
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  auto cache = std::make_shared<std::string>();
+  file.seekg(0, std::ios::end);
+  cache->resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0, std::ios::beg);
+  const bool readFailed = !file.read(&(*cache)[0], cache->size());
+  file.close();
+
+  // validate the whole file before registering anything. On failure, the
+  // stale or damaged file is removed and the caller parses the xml and saves
+  // the cache again.
+  auto prune = [&fileName]() {
+    std::remove(fileName.c_str());
+    return false;
+  };
+  if (readFailed)
+  {
+    return prune();
+  }
+  size_t pos = 0;
+  vtkTypeUInt64 header[3];
+  for (auto& value : header)
+  {
+    if (!vtkSIDefinitionCacheRead(*cache, pos, value))
+    {
+      return prune();
+    }
+  }
+  vtkTypeUInt64 xmlLength;
+  const size_t expectedLength = strlen(xmlContent);
+  if (header[0] != vtkSIDefinitionCacheMagic || header[1] != vtkSIDefinitionCacheVersion ||
+    header[2] != key || !vtkSIDefinitionCacheRead(*cache, pos, xmlLength) ||
+    xmlLength != expectedLength || cache->size() - pos < expectedLength ||
+    memcmp(cache->data() + pos, xmlContent, expectedLength) != 0)
+  {
+    return prune();
+  }
+  pos += expectedLength;
+
+  struct Entry
+  {
+    std::string Group;
+    std::string Name;
+    vtkTypeUInt64 IsExtension;
+    size_t Offset;
+    size_t Size;
+    XMLElement Extension;
+  };
+  std::shared_ptr<const std::string> blobs = cache;
+  std::vector<Entry> entries;
+  while (pos < cache->size())
+  {
+    const size_t start = pos;
+    Entry entry;
+    vtkTypeUInt64 size;
+    vtkTypeUInt64 checksum;
+    if (!vtkSIDefinitionCacheRead(*cache, pos, entry.Group) ||
+      !vtkSIDefinitionCacheRead(*cache, pos, entry.Name) ||
+      !vtkSIDefinitionCacheRead(*cache, pos, entry.IsExtension) ||
+      !vtkSIDefinitionCacheRead(*cache, pos, size) || cache->size() - pos < size)
+    {
+      return prune();
+    }
+    entry.Offset = pos;
+    entry.Size = static_cast<size_t>(size);
+    pos += entry.Size;
+    const size_t length = entry.Offset + entry.Size - start;
+    if (!vtkSIDefinitionCacheRead(*cache, pos, checksum) ||
+      checksum != vtkSIDefinitionCacheChecksum(cache->data() + start, length))
+    {
+      return prune();
+    }
+    if (entry.IsExtension)
+    {
+      // extensions modify an existing definition right away, decode them now
+      // so that a bad one is caught before anything is registered.
+      entry.Extension = vtkSIProxyDefinition(blobs, entry.Offset, entry.Size).GetPointer();
+      if (!entry.Extension)
+      {
+        return prune();
+      }
+    }
+    entries.push_back(entry);
+  }
+
+  for (const auto& entry : entries)
+  {
+    if (entry.IsExtension)
+    {
+      this->AddElement(entry.Group.c_str(), entry.Name.c_str(), entry.Extension);
+    }
+    else
+    {
+      this->Internals->CoreDefinitions[entry.Group][entry.Name] =
+        vtkSIProxyDefinition(blobs, entry.Offset, entry.Size);
+      RegisteredDefinitionInformation info(entry.Group.c_str(), entry.Name.c_str(), false);
+      this->InvokeEvent(vtkCommand::RegisterEvent, &info);
+    }
+  }
+  this->InvokeEvent(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::SaveDefinitionCache(
+  const char* xmlContent, bool attachHints, vtkPVXMLElement* root)
+{
+  vtkTypeUInt64 key = 0;
+  const std::string fileName = vtkSIDefinitionCacheFileName(xmlContent, attachHints, key);
+  while (root && (!root->GetName() || strcmp(root->GetName(), "ServerManagerConfiguration") != 0))
+  {
+    root = root->FindNestedElementByName("ServerManagerConfiguration");
+  }
+  if (fileName.empty() || !root)
+  {
+    return;
+  }
+
+  // save definitions the way LoadConfigurationXML() registers them, before
+  // extensions in the same xml modify any of them.
+  if (attachHints)
+  {
+    this->AttachShowInMenuHintsToProxyFromProxyGroups(root);
+  }
+
+  std::string buffer;
+  vtkSIDefinitionCacheWrite(buffer, static_cast<vtkTypeUInt64>(vtkSIDefinitionCacheMagic));
+  vtkSIDefinitionCacheWrite(buffer, static_cast<vtkTypeUInt64>(vtkSIDefinitionCacheVersion));
+  vtkSIDefinitionCacheWrite(buffer, key);
+  vtkSIDefinitionCacheWrite(buffer, std::string(xmlContent));
+  std::string blob;
+  for (unsigned int i = 0; i < root->GetNumberOfNestedElements(); ++i)
+  {
+    vtkPVXMLElement* group = root->GetNestedElement(i);
+    const std::string groupName = group->GetAttributeOrEmpty("name");
+    for (unsigned int cc = 0; cc < group->GetNumberOfNestedElements(); ++cc)
+    {
+      vtkPVXMLElement* proxy = group->GetNestedElement(cc);
+      const std::string proxyName = proxy->GetAttributeOrEmpty("name");
+      if (!proxyName.empty())
+      {
+        const bool isExtension = proxy->GetName() && strcmp(proxy->GetName(), "Extension") == 0;
+        blob.clear();
+        proxy->SaveBinary(blob);
+        const size_t start = buffer.size();
+        vtkSIDefinitionCacheWrite(buffer, groupName);
+        vtkSIDefinitionCacheWrite(buffer, proxyName);
+        vtkSIDefinitionCacheWrite(buffer, static_cast<vtkTypeUInt64>(isExtension ? 1 : 0));
+        vtkSIDefinitionCacheWrite(buffer, blob);
+        vtkSIDefinitionCacheWrite(
+          buffer, vtkSIDefinitionCacheChecksum(buffer.data() + start, buffer.size() - start));
+      }
+    }
+  }
+
+  // many processes may save the same file at once; each writes its own copy
+  // and renames it in place, so readers never see a partial file.
+  std::random_device random;
+  const std::string tmpName = fileName + "." + std::to_string(random()) + ".tmp";
+  {
+    std::ofstream file(tmpName.c_str(), std::ios::out | std::ios::binary);
+    file.write(buffer.c_str(), buffer.size());
+    if (!file)
+    {
+      file.close();
+      std::remove(tmpName.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmpName.c_str(), fileName.c_str()) != 0)
+  {
+    std::remove(tmpName.c_str());
+  }
+  vtkSIDefinitionCachePrune(vtksys::SystemTools::GetFilenamePath(fileName));
 }
 
 //---------------------------------------------------------------------------
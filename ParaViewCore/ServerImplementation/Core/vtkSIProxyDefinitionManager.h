@@ -37,6 +37,14 @@
  * \li \c vtkCommand::UnRegisterEvent - Fired when a proxy definition is
  * removed. Since this class only support removing custom proxies, this event is
  * fired only when a custom proxy is removed.
+ *
+ * When the environment variable `PV_PROXY_DEFINITION_CACHE_DIR` names a
+ * writable directory, the definitions parsed from each configuration xml
+ * string are also saved there in a binary form. Later runs, and other ranks,
+ * load definitions from that cache instead of parsing the xml, and only
+ * rebuild the vtkPVXMLElement tree of a definition when it is first used.
+ * A cache file is only used if it holds the exact same xml string; files that
+ * don't match, are damaged, or use an older format are removed.
 */
 
 #ifndef vtkSIProxyDefinitionManager_h
@@ -270,6 +278,17 @@ protected:
   bool LoadConfigurationXMLFromString(const char* xmlContent, bool attachShowInMenuHints);
   //@}
 
+  //@{
+  /**
+   * Load/save the definitions of the configuration xml `xmlContent` from/to
+   * the definition cache, if enabled. LoadDefinitionCache() returns false if
+   * the cache is disabled or has no valid entry for that xml.
+   */
+  bool LoadDefinitionCache(const char* xmlContent, bool attachShowInMenuHints);
+  void SaveDefinitionCache(
+    const char* xmlContent, bool attachShowInMenuHints, vtkPVXMLElement* root);
+  //@}
+
   //@{
   /**
    * Callback called when a plugin is loaded.
@@ -227,6 +227,8 @@ void vtkSISourceProxy::UpdatePipeline(int port, double time, bool doTime)
 
   vtkVLogScopeF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), "%s: update pipeline(%d, %f, %s) ",
     this->GetLogNameOrDefault(), port, time, (doTime ? "true" : "false"));
+  vtkPVLogger::TraceScope traceScope(
+    "pipeline", this->GetLogNameOrDefault(), ": update pipeline");
 
   vtkAlgorithm* algo = output_port->GetProducer();
   assert(algo);
@@ -0,0 +1,170 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestProxyDefinitionCache.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkNew.h"
+#include "vtkPVXMLElement.h"
+#include "vtkSIProxyDefinitionManager.h"
+#include "vtkTesting.h"
+
+#include <vtksys/Directory.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Checks that vtkSIProxyDefinitionManager saves proxy definitions to the
+// definition cache, loads them back, and recovers from cache files that are
+// truncated, hold another xml or were written by an older format version.
+
+namespace
+{
+const char* TestXML = "<ServerManagerConfiguration>"
+                      "<ProxyGroup name=\"sources\">"
+                      "<SourceProxy name=\"CachedSource\" class=\"vtkSphereSource\">"
+                      "<IntVectorProperty name=\"Resolution\" command=\"SetThetaResolution\" "
+                      "number_of_elements=\"1\" default_values=\"8\">"
+                      "<Documentation>Resolution &amp; more.</Documentation>"
+                      "</IntVectorProperty>"
+                      "</SourceProxy>"
+                      "</ProxyGroup>"
+                      "</ServerManagerConfiguration>";
+
+std::vector<std::string> ListCacheFiles(const std::string& dir)
+{
+  std::vector<std::string> files;
+  vtksys::Directory directory;
+  directory.Load(dir);
+  for (unsigned long cc = 0; cc < directory.GetNumberOfFiles(); ++cc)
+  {
+    const std::string name = directory.GetFile(cc);
+    if (name.compare(0, 14, "pvdefinitions-") == 0)
+    {
+      files.push_back(dir + "/" + name);
+    }
+  }
+  return files;
+}
+
+std::string ReadFile(const std::string& fname)
+{
+  std::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+void WriteFile(const std::string& fname, const std::string& contents)
+{
+  std::ofstream file(fname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  file.write(contents.data(), contents.size());
+}
+
+// Loads TestXML in a new manager and checks the definition it gets.
+bool Load(vtkPVXMLElement* expected, const char* what)
+{
+  vtkNew<vtkSIProxyDefinitionManager> manager;
+  vtkPVXMLElement* definition =
+    manager->LoadConfigurationXMLFromString(TestXML)
+    ? manager->GetProxyDefinition("sources", "CachedSource", false)
+    : nullptr;
+  if (!definition || (expected && !definition->Equals(expected)))
+  {
+    std::cerr << "Failed: wrong definition " << what << "." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestProxyDefinitionCache(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  if (!testing->GetTempDirectory())
+  {
+    std::cerr << "No temp directory specified." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string dir = std::string(testing->GetTempDirectory()) + "/TestProxyDefinitionCache";
+  vtksys::SystemTools::RemoveADirectory(dir);
+  vtksys::SystemTools::MakeDirectory(dir);
+
+  // a file from an older format version, which can never be loaded.
+  const std::string staleFile = dir + "/pvdefinitions-0000000000000000.bin";
+  const vtkTypeUInt64 staleHeader[2] = { 0x43445650, 1 };
+  WriteFile(staleFile, std::string(reinterpret_cast<const char*>(staleHeader), 16));
+
+  // reference definition, parsed without the cache.
+  vtkNew<vtkSIProxyDefinitionManager> reference;
+  reference->LoadConfigurationXMLFromString(TestXML);
+  vtkPVXMLElement* expected = reference->GetProxyDefinition("sources", "CachedSource", false);
+  if (!expected)
+  {
+    std::cerr << "Failed to parse the test configuration." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtksys::SystemTools::PutEnv("PV_PROXY_DEFINITION_CACHE_DIR=" + dir);
+  bool success = Load(expected, "when saving the cache");
+
+  std::vector<std::string> files = ListCacheFiles(dir);
+  if (files.size() != 1 || files[0] == staleFile)
+  {
+    std::cerr << "Failed: expected a single cache file, and the stale one removed." << std::endl;
+    vtksys::SystemTools::PutEnv("PV_PROXY_DEFINITION_CACHE_DIR=");
+    return EXIT_FAILURE;
+  }
+  const std::string cacheFile = files[0];
+  const std::string cache = ReadFile(cacheFile);
+
+  success &= Load(expected, "from the cache");
+
+  // truncated files are removed and saved again.
+  WriteFile(cacheFile, cache.substr(0, cache.size() / 2));
+  success &= Load(expected, "with a truncated cache");
+  if (ReadFile(cacheFile) != cache)
+  {
+    std::cerr << "Failed: truncated cache was not saved again." << std::endl;
+    success = false;
+  }
+
+  // so are files holding another xml. The xml follows a 32 bytes header.
+  std::string otherXML = cache;
+  otherXML[32 + 1] = 'X';
+  WriteFile(cacheFile, otherXML);
+  success &= Load(expected, "with a cache for another xml");
+  if (ReadFile(cacheFile) != cache)
+  {
+    std::cerr << "Failed: cache for another xml was not replaced." << std::endl;
+    success = false;
+  }
+
+  // and damaged definitions.
+  std::string damaged = cache;
+  damaged[damaged.size() - 12] ^= 0x5a;
+  WriteFile(cacheFile, damaged);
+  success &= Load(expected, "with a damaged cache");
+  if (ReadFile(cacheFile) != cache)
+  {
+    std::cerr << "Failed: damaged cache was not saved again." << std::endl;
+    success = false;
+  }
+
+  vtksys::SystemTools::PutEnv("PV_PROXY_DEFINITION_CACHE_DIR=");
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -339,6 +339,9 @@ void vtkSMCompoundSourceProxy::CreateVTKObjects()
       continue;
     }
 
+    // the output ports of the sub-proxy may have been deferred, see
+    // vtkSMSourceProxy::DeferOutputPorts.
+    subProxy->CreateOutputPorts();
     if (iter->HasPortIndex() ||
       (subProxy->GetOutputPortIndex(iter->PortName.c_str()) == VTK_UNSIGNED_INT_MAX))
     {
@@ -28,10 +28,19 @@
 #include "vtkSMCompoundSourceProxy.h"
 #include "vtkSMMessage.h"
 #include "vtkSMSession.h"
+#include "vtkSmartPointer.h"
 #include "vtkTimerLog.h"
 
+#include <map>
 #include <sstream>
 
+class vtkSMOutputPort::vtkInternals
+{
+public:
+  // Data information for individual blocks, keyed by composite index.
+  std::map<unsigned int, vtkSmartPointer<vtkPVDataInformation> > SubsetDataInformation;
+};
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSMOutputPort);
 
@@ -48,6 +57,7 @@ vtkSMOutputPort::vtkSMOutputPort()
   this->SourceProxy = 0;
   this->CompoundSourceProxy = 0;
   this->ObjectsCreated = 1;
+  this->Internals = new vtkSMOutputPort::vtkInternals();
 }
 
 //----------------------------------------------------------------------------
@@ -57,6 +67,7 @@ vtkSMOutputPort::~vtkSMOutputPort()
   this->ClassNameInformation->Delete();
   this->DataInformation->Delete();
   this->TemporalDataInformation->Delete();
+  delete this->Internals;
 }
 
 //----------------------------------------------------------------------------
@@ -83,6 +94,33 @@ vtkPVTemporalDataInformation* vtkSMOutputPort::GetTemporalDataInformation()
   return this->TemporalDataInformation;
 }
 
+//----------------------------------------------------------------------------
+vtkPVDataInformation* vtkSMOutputPort::GetSubsetDataInformation(unsigned int compositeIndex)
+{
+  if (compositeIndex == 0)
+  {
+    return this->GetDataInformation();
+  }
+
+  auto& info = this->Internals->SubsetDataInformation[compositeIndex];
+  if (!info)
+  {
+    if (!this->SourceProxy)
+    {
+      vtkErrorMacro("Invalid vtkSMOutputPort.");
+      return nullptr;
+    }
+
+    info = vtkSmartPointer<vtkPVDataInformation>::New();
+    info->SetPortNumber(this->PortIndex);
+    info->SetCompositeIndex(compositeIndex);
+    this->SourceProxy->GetSession()->PrepareProgress();
+    this->SourceProxy->GatherInformation(info);
+    this->SourceProxy->GetSession()->CleanupPendingProgress();
+  }
+  return info;
+}
+
 //----------------------------------------------------------------------------
 vtkPVClassNameInformation* vtkSMOutputPort::GetClassNameInformation()
 {
@@ -105,6 +143,7 @@ void vtkSMOutputPort::InvalidateDataInformation()
   this->DataInformationValid = false;
   this->ClassNameInformationValid = false;
   this->TemporalDataInformationValid = false;
+  this->Internals->SubsetDataInformation.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -63,6 +63,15 @@ public:
    */
   virtual vtkPVTemporalDataInformation* GetTemporalDataInformation();
 
+  /**
+   * Returns data information for a single node in a composite dataset
+   * identified by its composite (flat) index. This is useful to get details
+   * for blocks whose information in GetDataInformation() is compact (see
+   * vtkPVDataInformation::GetIsCompact()). The information is gathered on
+   * first request and cached until the data information is invalidated.
+   */
+  virtual vtkPVDataInformation* GetSubsetDataInformation(unsigned int compositeIndex);
+
   /**
    * Returns the classname of the data object on this output port.
    */
@@ -142,6 +151,9 @@ private:
   vtkSMOutputPort(const vtkSMOutputPort&) = delete;
   void operator=(const vtkSMOutputPort&) = delete;
 
+  class vtkInternals;
+  vtkInternals* Internals;
+
   friend class vtkSMSourceProxy;
   friend class vtkSMCompoundSourceProxy;
   void UpdatePipeline();
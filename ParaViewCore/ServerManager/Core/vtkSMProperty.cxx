@@ -29,6 +29,9 @@
 #include "vtkSMProxy.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <cassert>
+#include <map>
 #include <sstream>
 #include <vector>
 
@@ -40,6 +43,103 @@ vtkCxxSetObjectMacro(vtkSMProperty, InformationProperty, vtkSMProperty);
 vtkCxxSetObjectMacro(vtkSMProperty, Documentation, vtkSMDocumentation);
 vtkCxxSetObjectMacro(vtkSMProperty, Hints, vtkPVXMLElement);
 
+namespace
+{
+// Dependent domain updates queued while vtkSMProperty::DeferDomainUpdates is
+// in effect. Each domain is queued at most once: domains update from their
+// required properties, not from the property passed to vtkSMDomain::Update(),
+// so only the last requesting property is kept.
+struct vtkSMPropertyDomainUpdate
+{
+  vtkWeakPointer<vtkSMDomain> Domain;
+  vtkWeakPointer<vtkSMProperty> RequestingProperty;
+  int Depth;
+};
+
+struct vtkSMPropertyDomainUpdateQueue
+{
+  int DeferCount = 0;
+  std::vector<vtkSMPropertyDomainUpdate> Updates;
+  // index in Updates of the update queued for each domain. The domain may have
+  // been deleted and its address reused since, so the weak pointer in Updates
+  // must be checked too.
+  std::map<vtkSMDomain*, size_t> Queued;
+};
+
+vtkSMPropertyDomainUpdateQueue vtkSMPropertyDomainUpdates;
+
+// Returns the length of the longest chain of producers upstream of `proxy`,
+// so that domains on upstream proxies can be updated before those on their
+// consumers, which often depend on them.
+int vtkSMPropertyGetPipelineDepth(vtkSMProxy* proxy, std::map<vtkSMProxy*, int>& depths)
+{
+  if (!proxy)
+  {
+    return 0;
+  }
+  auto iter = depths.find(proxy);
+  if (iter != depths.end())
+  {
+    return iter->second;
+  }
+  depths[proxy] = 0; // in case of cycles.
+  int depth = 0;
+  for (unsigned int cc = 0, max = proxy->GetNumberOfProducers(); cc < max; ++cc)
+  {
+    depth = std::max(depth, vtkSMPropertyGetPipelineDepth(proxy->GetProducerProxy(cc), depths) + 1);
+  }
+  depths[proxy] = depth;
+  return depth;
+}
+}
+
+//---------------------------------------------------------------------------
+vtkSMProperty::DeferDomainUpdates::DeferDomainUpdates()
+{
+  ++vtkSMPropertyDomainUpdates.DeferCount;
+}
+
+//---------------------------------------------------------------------------
+vtkSMProperty::DeferDomainUpdates::~DeferDomainUpdates()
+{
+  auto& queue = vtkSMPropertyDomainUpdates;
+  assert(queue.DeferCount > 0);
+  if (queue.DeferCount > 1)
+  {
+    --queue.DeferCount;
+    return;
+  }
+
+  // Updates are still deferred while processing the queue: updates requested
+  // by the domains being updated are queued and processed in the next pass.
+  while (!queue.Updates.empty())
+  {
+    std::vector<vtkSMPropertyDomainUpdate> updates;
+    updates.swap(queue.Updates);
+    queue.Queued.clear();
+
+    std::map<vtkSMProxy*, int> depths;
+    for (auto& update : updates)
+    {
+      vtkSMProperty* property = update.Domain ? update.Domain->GetProperty() : nullptr;
+      update.Depth = property ? vtkSMPropertyGetPipelineDepth(property->GetParent(), depths) : 0;
+    }
+    std::stable_sort(updates.begin(), updates.end(),
+      [](const vtkSMPropertyDomainUpdate& a, const vtkSMPropertyDomainUpdate& b) {
+        return a.Depth < b.Depth;
+      });
+
+    for (auto& update : updates)
+    {
+      if (update.Domain && update.RequestingProperty)
+      {
+        update.Domain->Update(update.RequestingProperty);
+      }
+    }
+  }
+  --queue.DeferCount;
+}
+
 //---------------------------------------------------------------------------
 vtkSMProperty::vtkSMProperty()
 {
@@ -279,6 +379,32 @@ void vtkSMProperty::RemoveAllDependents()
 //---------------------------------------------------------------------------
 void vtkSMProperty::UpdateDomains()
 {
+  auto& queue = vtkSMPropertyDomainUpdates;
+  if (queue.DeferCount > 0)
+  {
+    for (auto& dependent : this->PInternals->Dependents)
+    {
+      vtkSMDomain* domain = dependent.GetPointer();
+      if (!domain)
+      {
+        continue;
+      }
+      auto iter = queue.Queued.find(domain);
+      if (iter != queue.Queued.end() && queue.Updates[iter->second].Domain == domain)
+      {
+        queue.Updates[iter->second].RequestingProperty = this;
+        continue;
+      }
+      queue.Queued[domain] = queue.Updates.size();
+      vtkSMPropertyDomainUpdate update;
+      update.Domain = domain;
+      update.RequestingProperty = this;
+      update.Depth = 0;
+      queue.Updates.push_back(update);
+    }
+    return;
+  }
+
   // I genuinely doubt when a property changes, its domain should change!!
   //// Update own domains
   // this->DomainIterator->Begin();
@@ -522,6 +522,27 @@ public:
    */
   static const char* CreateNewPrettyLabel(const char* name);
 
+  /**
+   * Helper to defer the update of dependent domains. While any instance of
+   * this class exists, properties queue the update of their dependent domains
+   * instead of doing it when modified. When the last instance is destroyed,
+   * every queued domain is updated once, with the last property that requested
+   * it, domains on upstream proxies first. This avoids updating the same
+   * domains (and gathering the same information from the server) over and
+   * over when the values of many properties are set at once, e.g. when
+   * loading a state file or applying a properties panel.
+   */
+  class VTKPVSERVERMANAGERCORE_EXPORT DeferDomainUpdates
+  {
+  public:
+    DeferDomainUpdates();
+    ~DeferDomainUpdates();
+
+  private:
+    DeferDomainUpdates(const DeferDomainUpdates&) = delete;
+    void operator=(const DeferDomainUpdates&) = delete;
+  };
+
 protected:
   vtkSMProperty();
   ~vtkSMProperty() override;
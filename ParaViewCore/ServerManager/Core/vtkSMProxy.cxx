@@ -569,6 +569,9 @@ void vtkSMProxy::UpdatePropertyInformation(vtkSMProperty* prop)
 //---------------------------------------------------------------------------
 void vtkSMProxy::UpdatePropertyInformation()
 {
+  // update the domains depending on information properties only once all of
+  // them, including those of subproxies, are up to date.
+  vtkSMProperty::DeferDomainUpdates deferDomainUpdates;
   this->UpdatePropertyInformationInternal(NULL);
 
   vtkSMProxyInternals::ProxyMap::iterator it2 = this->Internals->SubProxies.begin();
@@ -849,6 +852,7 @@ bool vtkSMProxy::GatherInformation(vtkPVInformation* information)
 
   vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "%s: gather information %s",
     this->GetLogNameOrDefault(), information->GetClassName());
+  PARAVIEW_TRACE_SCOPE("application", information->GetClassName());
 
   if (this->GetSession() && this->Location != 0)
   {
@@ -867,6 +871,7 @@ bool vtkSMProxy::GatherInformation(vtkPVInformation* information, vtkTypeUInt32
 
   vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "%s: gather information %s",
     this->GetLogNameOrDefault(), information->GetClassName());
+  PARAVIEW_TRACE_SCOPE("application", information->GetClassName());
 
   vtkTypeUInt32 realLocation = (this->Location & location);
   if (this->GetSession() && realLocation != 0)
@@ -2240,6 +2245,7 @@ void vtkSMProxy::LoadState(const vtkSMMessage* message, vtkSMProxyLocator* locat
   }
 
   // Manage properties
+  vtkSMProperty::DeferDomainUpdates deferDomainUpdates;
   vtkSMProxyInternals::PropertyInfoMap::iterator it;
   for (int i = 0; i < message->ExtensionSize(ProxyState::property); ++i)
   {
@@ -2270,7 +2276,8 @@ void vtkSMProxy::LoadState(const vtkSMMessage* message, vtkSMProxyLocator* locat
   // We don't need to do anything special to update domains that may have
   // changed as a consequence of the information properties being updated since
   // the vtkSMProperty automatically called vtkSMProperty::UpdateDomains() when
-  // the property changes.
+  // the property changes. Thanks to deferDomainUpdates, the domains are only
+  // updated once all properties have been read.
 
   // Manage annotation
   if (message->GetExtension(ProxyState::has_annotation))
@@ -20,6 +20,7 @@
 #include "vtkPVCatalystSessionCore.h"
 #include "vtkPVServerInformation.h"
 #include "vtkPVSessionCore.h"
+#include "vtkPVTraceEventsInformation.h"
 #include "vtkProcessModule.h"
 #include "vtkProcessModuleAutoMPI.h"
 #include "vtkReservedRemoteObjectIds.h"
@@ -235,6 +236,56 @@ bool vtkSMSession::IsMPIInitialized(vtkTypeUInt32)
   return vtkProcessModule::GetProcessModule()->IsMPIInitialized();
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMSession::SaveTraceEvents(const char* filename)
+{
+  if (!filename || !filename[0])
+  {
+    vtkErrorMacro("Invalid filename.");
+    return false;
+  }
+
+  vtkNew<vtkPVTraceEventsInformation> events;
+  if (vtkSMSessionClient::SafeDownCast(this) == nullptr)
+  {
+    // builtin session, all processes are reached with a single gather.
+    this->GatherInformation(vtkPVSession::CLIENT_AND_SERVERS, events, 0);
+  }
+  else
+  {
+    this->GatherInformation(vtkPVSession::CLIENT, events, 0);
+
+    vtkNew<vtkPVTraceEventsInformation> dsEvents;
+    this->GatherInformation(vtkPVSession::DATA_SERVER, dsEvents, 0);
+    events->AddInformation(dsEvents);
+
+    // avoid duplicating the gather when data-server and render-server are the
+    // same processes.
+    if (this->GetController(vtkPVSession::DATA_SERVER_ROOT) !=
+      this->GetController(vtkPVSession::RENDER_SERVER_ROOT))
+    {
+      vtkNew<vtkPVTraceEventsInformation> rsEvents;
+      this->GatherInformation(vtkPVSession::RENDER_SERVER, rsEvents, 0);
+      events->AddInformation(rsEvents);
+    }
+  }
+
+  ofstream ofs(filename, ios::out);
+  if (!ofs)
+  {
+    vtkErrorMacro("Failed to open file for writing: " << filename);
+    return false;
+  }
+
+  ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  for (int cc = 0, max = events->GetNumberOfChunks(); cc < max; ++cc)
+  {
+    ofs << (cc > 0 ? ",\n" : "") << events->GetChunk(cc);
+  }
+  ofs << "\n]}\n";
+  return !ofs.fail();
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSession::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -248,6 +248,17 @@ public:
   vtkGetMacro(IsAutoMPI, bool);
   //@}
 
+  /**
+   * Collects trace events recorded by vtkPVLogger on the client and all server
+   * processes and saves them to `filename` as a single trace in the Chrome
+   * trace-event JSON format, which can be loaded in `chrome://tracing` or
+   * Perfetto. Recorded events are cleared on all processes.
+   * Returns false if the file could not be written.
+   *
+   * @sa vtkPVLogger::SetTraceEventsEnabled
+   */
+  bool SaveTraceEvents(const char* filename);
+
 protected:
   // Subclasses should set initialize_during_constructor to false so that
   // this->Initialize() is not called in constructor but only after the session
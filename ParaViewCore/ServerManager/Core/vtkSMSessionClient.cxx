@@ -92,6 +92,8 @@ vtkSMSessionClient::vtkSMSessionClient()
   // Default value
   this->NoMoreDelete = false;
   this->NotBusy = 0;
+  this->PushBatchCount = 0;
+  this->PendingPushesSize = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -104,6 +106,7 @@ vtkSMSessionClient::~vtkSMSessionClient()
   }
   if (this->GetIsAlive())
   {
+    this->FlushPushBatch();
     this->CloseSession();
   }
   this->SetRenderServerController(0);
@@ -125,6 +128,8 @@ vtkSMSessionClient::~vtkSMSessionClient()
 //----------------------------------------------------------------------------
 vtkMultiProcessController* vtkSMSessionClient::GetController(ServerFlags processType)
 {
+  // the caller may communicate with the server directly.
+  this->FlushPushBatch();
   switch (processType)
   {
     case CLIENT:
@@ -447,6 +452,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->FlushPushBatch();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -510,7 +516,22 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   {
     controllers[num_controllers++] = this->RenderServerController;
   }
-  if (num_controllers > 0)
+  if (num_controllers > 0 && this->PushBatchCount > 0)
+  {
+    const PendingRequest request = { vtkPVSessionServer::PUSH, 0,
+      message->SerializeAsString() };
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->PendingPushes[controllers[cc] == this->DataServerController ? 0 : 1].push_back(request);
+      this->PendingPushesSize += request.Data.size();
+    }
+    // keep batches well below the size limit of a single message.
+    if (this->PendingPushesSize > (16 << 20))
+    {
+      this->FlushPushBatch();
+    }
+  }
+  else if (num_controllers > 0)
   {
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::PUSH);
@@ -552,6 +573,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
         msg.set_share_only(true);
         msg.set_client_id(this->ServerInformation->GetClientId());
 
+        this->FlushPushBatch();
         vtkMultiProcessStream stream;
         stream << static_cast<int>(vtkPVSessionServer::PUSH);
         stream << msg.SerializeAsString();
@@ -580,9 +602,64 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::StartPushBatch()
+{
+  ++this->PushBatchCount;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::EndPushBatch()
+{
+  assert(this->PushBatchCount > 0);
+  if (--this->PushBatchCount == 0)
+  {
+    this->FlushPushBatch();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushPushBatch()
+{
+  if (this->PendingPushes[0].empty() && this->PendingPushes[1].empty())
+  {
+    return;
+  }
+
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    std::vector<PendingRequest> pending;
+    pending.swap(this->PendingPushes[cc]);
+    if (pending.empty() || controllers[cc] == NULL || this->NoMoreDelete)
+    {
+      continue;
+    }
+    vtkMultiProcessStream stream;
+    stream << static_cast<int>(vtkPVSessionServer::PUSH_BATCH)
+           << static_cast<int>(pending.size());
+    for (const auto& request : pending)
+    {
+      stream << request.Type;
+      if (request.Type == vtkPVSessionServer::EXECUTE_STREAM)
+      {
+        stream << request.IgnoreErrors;
+      }
+      stream << request.Data;
+    }
+    std::vector<unsigned char> raw_message;
+    stream.GetRawData(raw_message);
+    controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
+      static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  }
+  this->PendingPushesSize = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->FlushPushBatch();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -652,8 +729,28 @@ void vtkSMSessionClient::ExecuteStream(
     controllers[num_controllers++] = this->RenderServerController;
   }
 
-  if (num_controllers > 0)
+  if (num_controllers > 0 && this->PushBatchCount > 0)
+  {
+    // streams executed on the server(s) do not return anything, they can be
+    // queued along with the pushed states.
+    const unsigned char* data;
+    size_t size;
+    cssstream.GetData(&data, &size);
+    const PendingRequest request = { vtkPVSessionServer::EXECUTE_STREAM,
+      static_cast<int>(ignore_errors), std::string(reinterpret_cast<const char*>(data), size) };
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->PendingPushes[controllers[cc] == this->DataServerController ? 0 : 1].push_back(request);
+      this->PendingPushesSize += size;
+    }
+    if (this->PendingPushesSize > (16 << 20))
+    {
+      this->FlushPushBatch();
+    }
+  }
+  else if (num_controllers > 0)
   {
+    this->FlushPushBatch();
     const unsigned char* data;
     size_t size;
     cssstream.GetData(&data, &size);
@@ -682,6 +779,7 @@ void vtkSMSessionClient::ExecuteStream(
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->FlushPushBatch();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -730,6 +828,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->FlushPushBatch();
   this->StartBusyWork();
   if (this->RenderServerController == NULL)
   {
@@ -829,6 +928,7 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPushBatch();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -870,6 +970,7 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPushBatch();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -911,6 +1012,7 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
 void vtkSMSessionClient::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "PushBatchCount: " << this->PushBatchCount << endl;
 }
 //----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMSessionClient::GetNextGlobalUniqueIdentifier()
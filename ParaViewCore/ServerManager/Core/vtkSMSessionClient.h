@@ -26,6 +26,9 @@
 #include "vtkPVServerManagerCoreModule.h" //needed for exports
 #include "vtkSMSession.h"
 
+#include <string> // for std::string
+#include <vector> // for std::vector
+
 class vtkMultiProcessController;
 class vtkPVServerInformation;
 class vtkSMCollaborationManager;
@@ -108,6 +111,19 @@ public:
   const vtkClientServerStream& GetLastResult(vtkTypeUInt32 location) override;
   //@}
 
+  //@{
+  /**
+   * Between StartPushBatch() and EndPushBatch(), state pushed to the server(s)
+   * and streams executed on the server(s) are queued and sent as a single
+   * message when the outermost batch ends. Queued requests are also sent
+   * before any request that needs a reply from the server(s), so requests are
+   * still processed in order. Batches may be nested. Use this when pushing the
+   * state of many proxies at once, e.g. when loading a state file.
+   */
+  void StartPushBatch();
+  void EndPushBatch();
+  //@}
+
   //@{
   /**
    * When Connect() is waiting for a server to connect back to the client (in
@@ -239,6 +255,11 @@ protected:
    */
   vtkTypeUInt32 GetRealLocation(vtkTypeUInt32);
 
+  /**
+   * Sends the requests queued since StartPushBatch(), if any.
+   */
+  void FlushPushBatch();
+
   // Both maybe the same when connected to pvserver.
   vtkMultiProcessController* RenderServerController;
   vtkMultiProcessController* DataServerController;
@@ -278,6 +299,17 @@ private:
   void operator=(const vtkSMSessionClient&) = delete;
 
   int NotBusy;
+  int PushBatchCount;
+  // Requests queued for the data-server and render-server: pushed states and
+  // executed streams.
+  struct PendingRequest
+  {
+    int Type;
+    int IgnoreErrors;
+    std::string Data;
+  };
+  std::vector<PendingRequest> PendingPushes[2];
+  size_t PendingPushesSize;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
 };
@@ -18,11 +18,13 @@
 #include "vtkCollection.h"
 #include "vtkCommand.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVAlgorithmPortsInformation.h"
 #include "vtkPVArrayInformation.h"
 #include "vtkPVDataInformation.h"
 #include "vtkPVDataSetAttributesInformation.h"
+#include "vtkPVMultiAlgorithmPortsInformation.h"
 #include "vtkPVXMLElement.h"
 #include "vtkProcessModule.h"
 #include "vtkSMDocumentation.h"
@@ -34,11 +36,14 @@
 #include "vtkSMOutputPort.h"
 #include "vtkSMProxyLocator.h"
 #include "vtkSMSession.h"
+#include "vtkSMSessionClient.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMStringVectorProperty.h"
 #include "vtkSmartPointer.h"
+#include "vtkWeakPointer.h"
 
 #include <assert.h>
+#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -46,6 +51,19 @@
 #define OUTPUT_PORTNAME_PREFIX "Output-"
 #define MAX_NUMBER_OF_PORTS 10
 
+namespace
+{
+// Source proxies whose output ports are not created yet because
+// vtkSMSourceProxy::DeferOutputPorts is in effect.
+struct vtkSMSourceProxyPortsQueue
+{
+  int DeferCount = 0;
+  std::vector<vtkWeakPointer<vtkSMSourceProxy> > Proxies;
+};
+
+vtkSMSourceProxyPortsQueue vtkSMSourceProxyDeferredPorts;
+}
+
 //---------------------------------------------------------------------------
 class vtkSelectionForwarderCommand : public vtkCommand
 {
@@ -381,11 +399,84 @@ void vtkSMSourceProxy::CreateVTKObjects()
   }
   this->Superclass::CreateVTKObjects();
 
+  if (vtkSMSourceProxyDeferredPorts.DeferCount > 0 && this->ObjectsCreated)
+  {
+    vtkSMSourceProxyDeferredPorts.Proxies.push_back(this);
+    return;
+  }
+
   // We are going to fix the ports such that we don't have to update the
   // pipeline or even UpdateInformation() to create the ports.
   this->CreateOutputPorts();
 }
 
+//---------------------------------------------------------------------------
+vtkSMSourceProxy::DeferOutputPorts::DeferOutputPorts()
+{
+  ++vtkSMSourceProxyDeferredPorts.DeferCount;
+}
+
+//---------------------------------------------------------------------------
+vtkSMSourceProxy::DeferOutputPorts::~DeferOutputPorts()
+{
+  auto& queue = vtkSMSourceProxyDeferredPorts;
+  assert(queue.DeferCount > 0);
+  if (--queue.DeferCount > 0)
+  {
+    return;
+  }
+
+  std::vector<vtkWeakPointer<vtkSMSourceProxy> > proxies;
+  proxies.swap(queue.Proxies);
+
+  // Only proxies gathering their information from a remote server are worth
+  // grouping: the others gather it locally.
+  typedef std::pair<vtkSMSession*, vtkTypeUInt32> GroupKey;
+  std::map<GroupKey, std::vector<vtkSMSourceProxy*> > groups;
+  for (const auto& proxy : proxies)
+  {
+    if (proxy && proxy->ObjectsCreated &&
+      proxy->NumberOfAlgorithmOutputPorts == VTK_UNSIGNED_INT_MAX &&
+      vtkSMSessionClient::SafeDownCast(proxy->GetSession()) != nullptr &&
+      (proxy->GetLocation() & vtkPVSession::CLIENT) == 0)
+    {
+      groups[GroupKey(proxy->GetSession(), proxy->GetLocation())].push_back(proxy);
+    }
+  }
+
+  for (const auto& group : groups)
+  {
+    vtkNew<vtkPVMultiAlgorithmPortsInformation> info;
+    for (vtkSMSourceProxy* proxy : group.second)
+    {
+      info->AddGlobalID(proxy->GetGlobalID());
+    }
+    if (!group.first.first->GatherInformation(group.first.second, info, 0))
+    {
+      continue;
+    }
+    for (size_t cc = 0; cc < group.second.size(); ++cc)
+    {
+      const unsigned int index = static_cast<unsigned int>(cc);
+      if (info->GetNumberOfOutputs(index) >= 0)
+      {
+        group.second[cc]->NumberOfAlgorithmOutputPorts = info->GetNumberOfOutputs(index);
+        group.second[cc]->NumberOfAlgorithmRequiredInputPorts =
+          info->GetNumberOfRequiredInputs(index);
+      }
+    }
+  }
+
+  // proxies whose port counts could not be fetched above gather them now.
+  for (const auto& proxy : proxies)
+  {
+    if (proxy)
+    {
+      proxy->CreateOutputPorts();
+    }
+  }
+}
+
 //---------------------------------------------------------------------------
 unsigned int vtkSMSourceProxy::GetNumberOfAlgorithmOutputPorts()
 {
@@ -224,6 +224,26 @@ public:
    */
   void MarkDirty(vtkSMProxy* modifiedProxy) override;
 
+  /**
+   * Helper to defer the creation of output ports. While any instance of this
+   * class exists, source proxies do not create their output ports when their
+   * VTK objects are created. When the last instance is destroyed, the number
+   * of ports of all these proxies is fetched with a single information request
+   * per session and location, rather than one request per proxy, and their
+   * output ports are created. This is used when loading a state file, where
+   * the per-proxy requests would also break up the batch of pushed states.
+   */
+  class VTKPVSERVERMANAGERCORE_EXPORT DeferOutputPorts
+  {
+  public:
+    DeferOutputPorts();
+    ~DeferOutputPorts();
+
+  private:
+    DeferOutputPorts(const DeferOutputPorts&) = delete;
+    void operator=(const DeferOutputPorts&) = delete;
+  };
+
 protected:
   vtkSMSourceProxy();
   ~vtkSMSourceProxy() override;
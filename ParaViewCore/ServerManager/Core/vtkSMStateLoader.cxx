@@ -24,6 +24,7 @@
 #include "vtkSMProxyLocator.h"
 #include "vtkSMProxyManager.h"
 #include "vtkSMSession.h"
+#include "vtkSMSessionClient.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSettingsProxy.h"
 #include "vtkSMSourceProxy.h"
@@ -36,6 +37,38 @@
 
 vtkObjectFactoryNewMacro(vtkSMStateLoader);
 vtkCxxSetObjectMacro(vtkSMStateLoader, ProxyLocator, vtkSMProxyLocator);
+//---------------------------------------------------------------------------
+namespace
+{
+// Batches the state pushed to the server while in scope, see
+// vtkSMSessionClient::StartPushBatch(). Nothing to do for builtin sessions.
+class vtkSMStateLoaderPushBatch
+{
+public:
+  vtkSMStateLoaderPushBatch(vtkSMSession* session)
+    : Session(vtkSMSessionClient::SafeDownCast(session))
+  {
+    if (this->Session)
+    {
+      this->Session->StartPushBatch();
+    }
+  }
+  ~vtkSMStateLoaderPushBatch() { this->End(); }
+
+  void End()
+  {
+    if (this->Session)
+    {
+      this->Session->EndPushBatch();
+      this->Session = nullptr;
+    }
+  }
+
+private:
+  vtkSMSessionClient* Session;
+};
+}
+
 //---------------------------------------------------------------------------
 struct vtkSMStateLoaderRegistrationInfo
 {
@@ -211,21 +244,23 @@ void vtkSMStateLoader::CreatedNewProxy(vtkTypeUInt32 id, vtkSMProxy* proxy)
     proxy->SetGlobalID(id);
   }
 
-  // Calling UpdateVTKObjects() will assign the proxy a GlobalId, if needed.
-  proxy->UpdateVTKObjects();
-  if (proxy->IsA("vtkSMSourceProxy"))
-  {
-    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
-  }
   if (this->Internal->DeferProxyRegistration)
   {
+    // The server-side objects of proxies loaded while registration is
+    // deferred are created in bulk by LoadStateInternal(), once all the
+    // proxies have been loaded.
     this->Internal->ProxyCreationOrder.push_back(
       vtkSMStateLoaderInternals::ProxyCreationOrderItem(id, proxy));
+    return;
   }
-  else
+
+  // Calling UpdateVTKObjects() will assign the proxy a GlobalId, if needed.
+  proxy->UpdateVTKObjects();
+  if (proxy->IsA("vtkSMSourceProxy"))
   {
-    this->RegisterProxy(id, proxy);
+    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
   }
+  this->RegisterProxy(id, proxy);
 }
 
 //---------------------------------------------------------------------------
@@ -619,22 +654,55 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
   // registered. That way, when properties on TimeKeeper or AnimationScene
   // start getting modified, the proxies they may refer to are already
   // present and registered.
+  //
+  // The proxies are first loaded client-side only. Their server-side objects
+  // are then created and their state pushed in dependency order, as a single
+  // batch when connected to a server, and domains are updated once all that is
+  // done rather than every time a property they depend on is loaded. The
+  // output ports of source proxies are created after the batch is sent, with
+  // a single request for the number of ports of all of them.
   std::vector<vtkSmartPointer<vtkPVXMLElement> > deferredCollections;
   this->Internal->DeferProxyRegistration = true;
-  for (i = 0; i < numElems; i++)
   {
-    vtkPVXMLElement* currentElement = rootElement->GetNestedElement(i);
-    const char* name = currentElement->GetName();
-    if (name != NULL && strcmp(name, "ProxyCollection") == 0)
+    vtkSMProperty::DeferDomainUpdates deferDomainUpdates;
+    vtkSMStateLoaderPushBatch pushBatch(this->GetSession());
     {
-      const char* group_name = currentElement->GetAttributeOrEmpty("name");
-      if (strcmp(group_name, "animation") == 0 || strcmp(group_name, "timekeeper") == 0)
+      vtkSMSourceProxy::DeferOutputPorts deferOutputPorts;
+      for (i = 0; i < numElems; i++)
       {
-        deferredCollections.push_back(currentElement);
+        vtkPVXMLElement* currentElement = rootElement->GetNestedElement(i);
+        const char* name = currentElement->GetName();
+        if (name != NULL && strcmp(name, "ProxyCollection") == 0)
+        {
+          const char* group_name = currentElement->GetAttributeOrEmpty("name");
+          if (strcmp(group_name, "animation") == 0 || strcmp(group_name, "timekeeper") == 0)
+          {
+            deferredCollections.push_back(currentElement);
+          }
+          else if (!this->HandleProxyCollection(currentElement))
+          {
+            return 0;
+          }
+        }
       }
-      else if (!this->HandleProxyCollection(currentElement))
+
+      // Calling UpdateVTKObjects() will assign the proxies a GlobalId, if
+      // needed.
+      for (const auto& item : this->Internal->ProxyCreationOrder)
       {
-        return 0;
+        if (item.second)
+        {
+          item.second->UpdateVTKObjects();
+        }
+      }
+    }
+    pushBatch.End();
+
+    for (const auto& item : this->Internal->ProxyCreationOrder)
+    {
+      if (vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(item.second))
+      {
+        source->UpdatePipelineInformation();
       }
     }
   }
@@ -99,7 +99,9 @@ protected:
    * state loaded on the proxy is "pushed" and any info properties updated.
    * We also create a list to track the order in which proxies are created.
    * This order is a dependency order too and hence helps us register proxies in
-   * order of dependencies.
+   * order of dependencies. While registration is deferred, pushing the state and
+   * updating the pipeline information is deferred too, so that
+   * LoadStateInternal() can do it in bulk once all proxies have been loaded.
    */
   void CreatedNewProxy(vtkTypeUInt32 id, vtkSMProxy* proxy) override;
 
@@ -25,9 +25,29 @@
 #include "vtkSMProperty.h"
 #include "vtkSMPropertyHelper.h"
 #include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
 
 #include <cassert>
 
+namespace
+{
+// Returns true if the blocks information lacks arrays information. The whole
+// tree is compacted at once, so checking the top-level blocks is enough.
+bool vtkSMSpreadSheetRepresentationInitializationHelperHasCompactBlocks(
+  vtkPVCompositeDataInformation* cdInfo)
+{
+  for (unsigned int cc = 0, max = cdInfo->GetNumberOfChildren(); cc < max; ++cc)
+  {
+    vtkPVDataInformation* childInfo = cdInfo->GetDataInformation(cc);
+    if (childInfo && childInfo->GetIsCompact())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+}
+
 vtkStandardNewMacro(vtkSMSpreadSheetRepresentationInitializationHelper);
 //----------------------------------------------------------------------------
 vtkSMSpreadSheetRepresentationInitializationHelper::
@@ -80,6 +100,18 @@ void vtkSMSpreadSheetRepresentationInitializationHelper::PostInitializeProxy(
       return;
     }
 
+    // arrays information for the blocks was not gathered. Gather it once for
+    // the whole tree rather than once per block while looking for an index.
+    vtkSmartPointer<vtkPVDataInformation> fullInfo;
+    if (vtkSMSpreadSheetRepresentationInitializationHelperHasCompactBlocks(cdInfo))
+    {
+      fullInfo = vtkSmartPointer<vtkPVDataInformation>::New();
+      fullInfo->SetPortNumber(static_cast<int>(port));
+      fullInfo->SetCompactCompositeThreshold(-1);
+      inputProxy->GatherInformation(fullInfo);
+      dataInfo = fullInfo;
+    }
+
     // see if there are only partial arrays. If so, we go down the tree till we
     // find an index with at least 1 non-partial array.
     vtkNew<vtkPVCompositeDataInformationIterator> iter;
@@ -91,7 +123,6 @@ void vtkSMSpreadSheetRepresentationInitializationHelper::PostInitializeProxy(
       {
         continue;
       }
-
       auto attrInfo = currentDataInfo->GetAttributeInformation(vtkDataObject::ROW);
       for (int cc = 0, max = attrInfo->GetNumberOfArrays(); cc < max; ++cc)
       {
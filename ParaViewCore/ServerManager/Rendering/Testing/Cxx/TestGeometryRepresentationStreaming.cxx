@@ -0,0 +1,143 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestGeometryRepresentationStreaming.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
+#include "vtkGeometryRepresentation.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVCompositeRepresentation.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVRenderView.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMRepresentationProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+#include <iostream>
+
+// Checks that vtkGeometryRepresentation delivers all of its geometry when it
+// starts needing ordered compositing while only part of it has been streamed.
+
+namespace
+{
+vtkIdType CountCells(vtkDataObject* data)
+{
+  if (auto ds = vtkDataSet::SafeDownCast(data))
+  {
+    return ds->GetNumberOfCells();
+  }
+  vtkIdType numCells = 0;
+  if (auto cd = vtkCompositeDataSet::SafeDownCast(data))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cd->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      numCells += CountCells(iter->GetCurrentDataObject());
+    }
+  }
+  return numCells;
+}
+}
+
+int TestGeometryRepresentationStreaming(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestGeometryRepresentationStreaming");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  vtkPVView::SetEnableStreaming(true);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+  controller->InitializeSession(session.Get());
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  view->UpdateVTKObjects();
+  controller->RegisterViewProxy(view);
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->InitializeProxy(sphere);
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(256);
+  vtkSMPropertyHelper(sphere, "PhiResolution").Set(256);
+  sphere->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(sphere);
+  sphere->UpdatePipeline();
+  const vtkIdType numCells = sphere->GetDataInformation()->GetNumberOfCells();
+
+  vtkSMProxy* repr = controller->Show(sphere, 0, view);
+  auto composite = vtkPVCompositeRepresentation::SafeDownCast(repr->GetClientSideObject());
+  auto geometry = vtkGeometryRepresentation::SafeDownCast(
+    composite ? composite->GetActiveRepresentation() : nullptr);
+  auto pvview = vtkPVRenderView::SafeDownCast(view->GetClientSideObject());
+  if (!geometry || !pvview)
+  {
+    std::cerr << "Failed to get the geometry representation." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // stream the sphere in many chunks, and never request more than the first
+  // ones.
+  geometry->SetStreamingCellThreshold(1000);
+  geometry->SetNumberOfStreamingChunks(32);
+  geometry->SetStreamingRequestSize(1);
+  geometry->MarkModified();
+  pvview->Update();
+  pvview->StillRender();
+
+  bool success = true;
+  vtkPVDataDeliveryManager* dm = pvview->GetDeliveryManager();
+  const vtkIdType streamedCells = CountCells(dm->GetDeliveredPiece(geometry, false));
+  if (streamedCells <= 0 || streamedCells >= numCells)
+  {
+    std::cerr << "Expected part of the " << numCells << " cells to be delivered, got "
+              << streamedCells << "." << std::endl;
+    success = false;
+  }
+
+  // translucent geometry needs ordered compositing, which needs all the
+  // geometry. Changing the opacity does not re-execute the representation.
+  vtkSMPropertyHelper(repr, "Opacity").Set(0.5);
+  repr->UpdateVTKObjects();
+  pvview->Update();
+  pvview->StillRender();
+
+  const vtkIdType deliveredCells = CountCells(dm->GetDeliveredPiece(geometry, false));
+  if (deliveredCells != numCells)
+  {
+    std::cerr << "Expected all the " << numCells << " cells to be delivered with ordered "
+              << "compositing, got " << deliveredCells << "." << std::endl;
+    success = false;
+  }
+
+  controller->UnRegisterProxy(sphere);
+  controller->UnRegisterProxy(view);
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  vtkPVView::SetEnableStreaming(false);
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,104 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestRepresentedArrayListDomainCompact.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataObject.h"
+#include "vtkFieldData.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVCompositeDataInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMRepresentedArrayListDomain.h"
+
+#include <cstdlib>
+#include <iostream>
+
+// Checks that vtkSMRepresentedArrayListDomain only offers field data arrays
+// with a single tuple per block for coloring composite datasets, whether the
+// information for the blocks is compact or not.
+
+namespace
+{
+class TestDomain : public vtkSMRepresentedArrayListDomain
+{
+public:
+  static TestDomain* New();
+  vtkTypeMacro(TestDomain, vtkSMRepresentedArrayListDomain);
+  using vtkSMRepresentedArrayListDomain::IsFilteredArray;
+};
+vtkStandardNewMacro(TestDomain);
+
+void AddFieldArray(vtkDataObject* data, const char* name, int numberOfTuples)
+{
+  vtkNew<vtkIntArray> array;
+  array->SetName(name);
+  array->SetNumberOfTuples(numberOfTuples);
+  array->FillValue(0);
+  data->GetFieldData()->AddArray(array);
+}
+
+bool Check(int compactThreshold, bool expectCompact)
+{
+  // "single" has one tuple per block, "multi" has two tuples on one block.
+  vtkNew<vtkMultiBlockDataSet> data;
+  for (unsigned int cc = 0; cc < 3; ++cc)
+  {
+    vtkNew<vtkPoints> points;
+    points->InsertNextPoint(cc, 0, 0);
+    vtkNew<vtkPolyData> block;
+    block->SetPoints(points);
+    AddFieldArray(block, "single", 1);
+    AddFieldArray(block, "multi", cc == 1 ? 2 : 1);
+    data->SetBlock(cc, block);
+  }
+
+  vtkNew<vtkPVDataInformation> info;
+  info->SetCompactCompositeThreshold(compactThreshold);
+  info->CopyFromObject(data);
+
+  vtkPVDataInformation* blockInfo = info->GetCompositeDataInformation()->GetDataInformation(0);
+  if (!blockInfo || blockInfo->GetIsCompact() != expectCompact)
+  {
+    std::cerr << "Unexpected block information for threshold " << compactThreshold << "."
+              << std::endl;
+    return false;
+  }
+
+  vtkNew<TestDomain> domain;
+  bool success = true;
+  if (domain->IsFilteredArray(info, vtkDataObject::FIELD_ASSOCIATION_NONE, "single"))
+  {
+    std::cerr << "'single' should not be filtered, threshold " << compactThreshold << "."
+              << std::endl;
+    success = false;
+  }
+  if (!domain->IsFilteredArray(info, vtkDataObject::FIELD_ASSOCIATION_NONE, "multi"))
+  {
+    std::cerr << "'multi' should be filtered, threshold " << compactThreshold << "."
+              << std::endl;
+    success = false;
+  }
+  return success;
+}
+}
+
+int TestRepresentedArrayListDomainCompact(int, char* [])
+{
+  bool success = Check(-1, false);
+  success = Check(1, true) && success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -26,6 +26,7 @@
 #include "vtkPVDataSetAttributesInformation.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSMArrayListDomain.h"
+#include "vtkSMOutputPort.h"
 #include "vtkSMSourceProxy.h"
 #include "vtkSMStringVectorProperty.h"
 #include "vtkSMUncheckedPropertyHelper.h"
@@ -234,6 +235,13 @@ void vtkSMChartSeriesSelectionDomain::Update(vtkSMProperty*)
   std::vector<vtkStdString> column_names;
   int fieldAssociation = vtkSMUncheckedPropertyHelper(fieldDataSelection).GetAsInt(0);
 
+  vtkSMUncheckedPropertyHelper inputHelper(input);
+  vtkSMSourceProxy* inputProxy = inputHelper.GetNumberOfElements() > 0
+    ? vtkSMSourceProxy::SafeDownCast(inputHelper.GetAsProxy(0))
+    : nullptr;
+  vtkSMOutputPort* inputPort =
+    inputProxy ? inputProxy->GetOutputPort(inputHelper.GetOutputPort()) : nullptr;
+
   vtkSMUncheckedPropertyHelper compositeIndexHelper(compositeIndex);
   unsigned int numElems = compositeIndexHelper.GetNumberOfElements();
   for (unsigned int cc = 0; cc < numElems; cc++)
@@ -264,8 +272,19 @@ void vtkSMChartSeriesSelectionDomain::Update(vtkSMProperty*)
         blockNameStream << compositeIndexHelper.GetAsInt(cc);
       }
     }
+    vtkPVDataInformation* arraysInfo = childInfo;
+    if (childInfo->GetIsCompact() && inputPort)
+    {
+      // block information was gathered in compact form, fetch the arrays for
+      // this block alone.
+      if (auto subsetInfo =
+            inputPort->GetSubsetDataInformation(compositeIndexHelper.GetAsInt(cc)))
+      {
+        arraysInfo = subsetInfo;
+      }
+    }
     this->PopulateAvailableArrays(
-      blockNameStream.str(), column_names, childInfo, fieldAssociation, this->FlattenTable);
+      blockNameStream.str(), column_names, arraysInfo, fieldAssociation, this->FlattenTable);
   }
   this->SetStrings(column_names);
 }
@@ -33,9 +33,10 @@ namespace
 // Given composite data set information, check whether the arrays
 // associated with the field data in the leaf blocks have a single
 // tuple. We do this to limit which field arrays are available to
-// the domain.
+// the domain. `maxNumberOfTuples` is the number of tuples of the array in the
+// information for the whole dataset, which is the maximum over all blocks.
 bool vtkFieldArrayHasOneTuplePerCompositeDataSetLeaf(
-  vtkPVCompositeDataInformation* info, const char* arrayName)
+  vtkPVCompositeDataInformation* info, const char* arrayName, vtkTypeInt64 maxNumberOfTuples)
 {
   for (unsigned int i = 0; i < info->GetNumberOfChildren(); ++i)
   {
@@ -43,6 +44,18 @@ bool vtkFieldArrayHasOneTuplePerCompositeDataSetLeaf(
     if (childInfo)
     {
       vtkPVCompositeDataInformation* compositeChildInfo = childInfo->GetCompositeDataInformation();
+      if (childInfo->GetIsCompact())
+      {
+        // arrays information is not available for blocks of large composite
+        // datasets, and gathering it for every block would defeat the
+        // purpose of the compact form. Rely on the maximum number of tuples
+        // over all blocks instead.
+        if (maxNumberOfTuples > 1)
+        {
+          return false;
+        }
+        continue;
+      }
       if (compositeChildInfo->GetNumberOfChildren() == 0)
       {
         // We have found a leaf in the dataset. Check whether the field
@@ -57,7 +70,8 @@ bool vtkFieldArrayHasOneTuplePerCompositeDataSetLeaf(
       else
       {
         // Recurse on the composite data information in the child
-        if (!vtkFieldArrayHasOneTuplePerCompositeDataSetLeaf(compositeChildInfo, arrayName))
+        if (!vtkFieldArrayHasOneTuplePerCompositeDataSetLeaf(
+              compositeChildInfo, arrayName, maxNumberOfTuples))
         {
           return false;
         }
@@ -211,7 +225,10 @@ bool vtkSMRepresentedArrayListDomain::IsFilteredArray(
   {
     vtkPVCompositeDataInformation* cdi = info->GetCompositeDataInformation();
     assert(cdi);
-    return !vtkFieldArrayHasOneTuplePerCompositeDataSetLeaf(cdi, name);
+    vtkPVArrayInformation* arrayInfo =
+      info->GetArrayInformation(name, vtkDataObject::FIELD_ASSOCIATION_NONE);
+    const vtkTypeInt64 maxNumberOfTuples = arrayInfo ? arrayInfo->GetNumberOfTuples() : 0;
+    return !vtkFieldArrayHasOneTuplePerCompositeDataSetLeaf(cdi, name, maxNumberOfTuples);
   }
 
   // don't filter.
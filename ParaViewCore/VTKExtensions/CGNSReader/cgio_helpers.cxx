@@ -674,6 +674,23 @@ int readZoneInfo(int cgioNum, double zoneId, CGNSRead::ZoneInformation& zoneInfo
     return 1;
   }
 
+  // Zone_t data is an IndexDimension x 3 array: vertex sizes, cell sizes and
+  // boundary vertex sizes.
+  std::vector<vtkTypeInt64> zsize;
+  zoneInfo.structured = true;
+  zoneInfo.numberOfCells = 0;
+  if (readNodeDataAs<vtkTypeInt64>(cgioNum, zoneId, zsize) == CG_OK && zsize.size() >= 3 &&
+    zsize.size() % 3 == 0)
+  {
+    const std::size_t indexDim = std::min<std::size_t>(zsize.size() / 3, 3);
+    zoneInfo.numberOfCells = 1;
+    for (std::size_t cc = 0; cc < indexDim; ++cc)
+    {
+      zoneInfo.cellDims[cc] = static_cast<vtkIdType>(zsize[indexDim + cc]);
+      zoneInfo.numberOfCells *= zoneInfo.cellDims[cc];
+    }
+  }
+
   std::vector<double> zoneChildren;
   getNodeChildrenId(cgioNum, zoneId, zoneChildren);
   for (double zoneChildId : zoneChildren)
@@ -689,6 +706,12 @@ int readZoneInfo(int cgioNum, double zoneId, CGNSRead::ZoneInformation& zoneInfo
           fname.c_str() + std::min(fname.size() + 1, sizeof(zoneInfo.family)), zoneInfo.family);
         zoneInfo.family[32] = 0;
       }
+      else if (strcmp(nodeLabel, "ZoneType_t") == 0)
+      {
+        std::string zoneType;
+        CGNSRead::readNodeStringData(cgioNum, zoneChildId, zoneType);
+        zoneInfo.structured = (zoneType == "Structured");
+      }
       else if (strcmp(nodeLabel, "ZoneBC_t") == 0)
       {
         std::vector<double> zoneBCChildren;
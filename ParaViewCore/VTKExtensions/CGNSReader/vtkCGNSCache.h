@@ -18,6 +18,11 @@
  *
  *     store an object in a container with its CGNS path key
  *
+ * Entries are evicted in least-recently-used order once either the number of
+ * entries exceeds CacheSizeLimit or their accumulated memory footprint
+ * (as reported by GetActualMemorySize()) exceeds CacheMemoryLimit. Both
+ * limits are disabled when negative (the default). Hit and miss counts are
+ * recorded to help tune these limits.
  *
  * @par Thanks:
  * Thanks to Mickael Philit
@@ -27,16 +32,16 @@
 #define vtkCGNSCache_h
 
 #include "vtkSmartPointer.h"
+#include "vtkType.h"
 
 #include <iterator>
+#include <list>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 
 namespace CGNSRead
 {
-// No priority and no size limit right now
-
 template <typename CacheDataType>
 class vtkCGNSCache
 {
@@ -52,30 +57,72 @@ public:
   void SetCacheSizeLimit(int size);
   int GetCacheSizeLimit();
 
+  /**
+   * Limit, in kibibytes, of the memory held by the cache. Negative means
+   * unlimited.
+   */
+  void SetCacheMemoryLimit(vtkTypeInt64 kibibytes);
+  vtkTypeInt64 GetCacheMemoryLimit() const { return this->cacheMemoryLimit; }
+
+  //@{
+  /**
+   * Cache statistics.
+   */
+  size_t GetNumberOfEntries() const { return this->CacheData.size(); }
+  vtkTypeInt64 GetMemorySize() const { return this->memorySize; }
+  vtkTypeUInt64 GetNumberOfHits() const { return this->hits; }
+  vtkTypeUInt64 GetNumberOfMisses() const { return this->misses; }
+  vtkTypeUInt64 GetNumberOfEvictions() const { return this->evictions; }
+  void ResetStatistics() { this->hits = this->misses = this->evictions = 0; }
+  //@}
+
 private:
   vtkCGNSCache(const vtkCGNSCache&) = delete;
   void operator=(const vtkCGNSCache&) = delete;
 
-  typedef std::unordered_map<std::string, vtkSmartPointer<CacheDataType> > CacheMapper;
+  // Most recently used keys are at the front.
+  typedef std::list<std::string> RecencyList;
+
+  struct CacheEntry
+  {
+    vtkSmartPointer<CacheDataType> Data;
+    vtkTypeInt64 Size;
+    typename RecencyList::iterator Recency;
+  };
+
+  typedef std::unordered_map<std::string, CacheEntry> CacheMapper;
   CacheMapper CacheData;
+  RecencyList Recency;
 
-  typename CacheMapper::iterator LastCacheAccess;
+  void Erase(typename CacheMapper::iterator iter);
+  void Trim();
 
   int cacheSizeLimit;
+  vtkTypeInt64 cacheMemoryLimit;
+  vtkTypeInt64 memorySize;
+  vtkTypeUInt64 hits;
+  vtkTypeUInt64 misses;
+  vtkTypeUInt64 evictions;
 };
 
 template <typename CacheDataType>
 vtkCGNSCache<CacheDataType>::vtkCGNSCache()
   : CacheData()
+  , Recency()
 {
   this->cacheSizeLimit = -1;
-  this->LastCacheAccess = CacheData.end();
+  this->cacheMemoryLimit = -1;
+  this->memorySize = 0;
+  this->hits = 0;
+  this->misses = 0;
+  this->evictions = 0;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::SetCacheSizeLimit(int size)
 {
   this->cacheSizeLimit = size;
+  this->Trim();
 }
 
 template <typename CacheDataType>
@@ -84,36 +131,86 @@ int vtkCGNSCache<CacheDataType>::GetCacheSizeLimit()
   return this->cacheSizeLimit;
 }
 
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::SetCacheMemoryLimit(vtkTypeInt64 kibibytes)
+{
+  this->cacheMemoryLimit = kibibytes;
+  this->Trim();
+}
+
 template <typename CacheDataType>
 vtkSmartPointer<CacheDataType> vtkCGNSCache<CacheDataType>::Find(const std::string& query)
 {
   typename CacheMapper::iterator iter;
   iter = this->CacheData.find(query);
   if (iter == this->CacheData.end())
+  {
+    ++this->misses;
     return vtkSmartPointer<CacheDataType>(nullptr);
-  this->LastCacheAccess = iter;
-  return iter->second;
+  }
+  ++this->hits;
+  this->Recency.splice(this->Recency.begin(), this->Recency, iter->second.Recency);
+  return iter->second.Data;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::Insert(
   const std::string& key, const vtkSmartPointer<CacheDataType>& data)
 {
+  typename CacheMapper::iterator iter = this->CacheData.find(key);
+  if (iter != this->CacheData.end())
+  {
+    this->Erase(iter);
+  }
+  if (data == nullptr)
+  {
+    return;
+  }
 
-  if (this->cacheSizeLimit > 0 &&
-    this->CacheData.size() >= static_cast<size_t>(this->cacheSizeLimit))
+  const vtkTypeInt64 size = static_cast<vtkTypeInt64>(data->GetActualMemorySize());
+  if (this->cacheMemoryLimit >= 0 && size > this->cacheMemoryLimit)
   {
-    // Make some room by removing last accessed/inserted item
-    this->CacheData.erase(this->LastCacheAccess);
+    // Would evict everything else and still not fit, don't bother.
+    return;
   }
-  this->CacheData[key] = data;
-  this->LastCacheAccess = this->CacheData.find(key);
+
+  this->Recency.push_front(key);
+  CacheEntry& entry = this->CacheData[key];
+  entry.Data = data;
+  entry.Size = size;
+  entry.Recency = this->Recency.begin();
+  this->memorySize += size;
+  this->Trim();
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::ClearCache()
 {
   this->CacheData.clear();
+  this->Recency.clear();
+  this->memorySize = 0;
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::Erase(typename CacheMapper::iterator iter)
+{
+  this->memorySize -= iter->second.Size;
+  this->Recency.erase(iter->second.Recency);
+  this->CacheData.erase(iter);
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::Trim()
+{
+  // Never evict the most recently used entry, it was just inserted or used.
+  while (this->Recency.size() > 1 &&
+    ((this->cacheSizeLimit > 0 &&
+       this->CacheData.size() > static_cast<size_t>(this->cacheSizeLimit)) ||
+           (this->cacheMemoryLimit >= 0 && this->memorySize > this->cacheMemoryLimit)))
+  {
+    this->Erase(this->CacheData.find(this->Recency.back()));
+    ++this->evictions;
+  }
 }
 }
 #endif // vtkCGNSCache_h
@@ -88,20 +88,6 @@ bool IsIdTypeBigEnough(const T& val)
   return (sizeof(vtkIdType) >= sizeof(T) || static_cast<T>(vtkTypeTraits<vtkIdType>::Max()) >= val);
 }
 
-struct duo_t
-{
-  duo_t()
-  {
-    pair[0] = 0;
-    pair[1] = 0;
-  }
-
-  int& operator[](std::size_t n) { return pair[n]; }
-  const int& operator[](std::size_t n) const { return pair[n]; }
-private:
-  int pair[2];
-};
-
 class SectionInformation
 {
 public:
@@ -473,7 +459,22 @@ public:
   static int readBCData(const double nodeId, const int cellDim, const int physicalDim,
     vtkDataSet* dataset, vtkCGNSReader* self);
 
-  static std::string GenerateMeshKey(const char* basename, const char* zonename);
+  static std::string GenerateMeshKey(
+    const char* filename, const char* basename, const char* zonename);
+
+  // A zone, or a slab of a structured zone, to be read by this rank.
+  struct ZonePiece
+  {
+    int Zone;
+    bool HasVOI;
+    int VOI[6];
+  };
+
+  // Distributes zones across pieces so that each piece gets roughly the same
+  // number of cells. Structured zones much larger than a piece's share are
+  // split into slabs along their longest index direction.
+  static void DistributeZones(vtkCGNSReader* self, int piece, int numPieces,
+    std::map<int, std::vector<ZonePiece> >& baseToZones);
 };
 
 //----------------------------------------------------------------------------
@@ -500,6 +501,7 @@ vtkCGNSReader::vtkCGNSReader()
   this->IgnoreSILChangeEvents = false;
   this->CacheMesh = false;
   this->CacheConnectivity = false;
+  this->CacheMemoryLimit = -1;
 
   // Setup the selection callback to modify this object when an array
   // selection is changed.
@@ -571,10 +573,13 @@ void vtkCGNSReader::SetController(vtkMultiProcessController* c)
 
 //------------------------------------------------------------------------------
 
-std::string vtkCGNSReader::vtkPrivate::GenerateMeshKey(const char* basename, const char* zonename)
+std::string vtkCGNSReader::vtkPrivate::GenerateMeshKey(
+  const char* filename, const char* basename, const char* zonename)
 {
+  // different files may use the same base and zone names for different
+  // meshes, so the file is part of the key.
   std::ostringstream query;
-  query << "/" << basename << "/" << zonename;
+  query << (filename ? filename : "") << ":/" << basename << "/" << zonename;
   return query.str();
 }
 
@@ -1485,8 +1490,8 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
     // Try to get from cache
     const char* basename = self->Internal->GetBase(base).name;
     const char* zonename = self->Internal->GetBase(base).zones[zone].name;
-    // build a key /basename/zonename
-    keyMesh = vtkPrivate::GenerateMeshKey(basename, zonename);
+    // build a key filename:/basename/zonename
+    keyMesh = vtkPrivate::GenerateMeshKey(self->FileName, basename, zonename);
 
     points = self->MeshPointsCache.Find(keyMesh);
     if (points.Get() != nullptr)
@@ -1642,8 +1647,8 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
 }
 
 //------------------------------------------------------------------------------
-int vtkCGNSReader::GetCurvilinearZone(
-  int base, int zone, int cellDim, int physicalDim, void* v_zsize, vtkMultiBlockDataSet* mbase)
+int vtkCGNSReader::GetCurvilinearZone(int base, int zone, int cellDim, int physicalDim,
+  void* v_zsize, vtkMultiBlockDataSet* mbase, const int* voi)
 {
   cgsize_t* zsize = reinterpret_cast<cgsize_t*>(v_zsize);
 
@@ -1652,18 +1657,24 @@ int vtkCGNSReader::GetCurvilinearZone(
   const char* zonename = this->Internal->GetBase(base).zones[zone].name;
 
   vtkSmartPointer<vtkDataObject> zoneDO = sil->ReadGridForZone(basename, zonename)
-    ? vtkPrivate::readCurvilinearZone(base, zone, cellDim, physicalDim, zsize, nullptr, this)
+    ? vtkPrivate::readCurvilinearZone(base, zone, cellDim, physicalDim, zsize, voi, this)
     : vtkSmartPointer<vtkDataObject>();
   mbase->SetBlock(zone, zoneDO.Get());
 
+  // When the zone is split across ranks, patches are read by the rank holding
+  // the first slab.
+  const bool firstPiece = voi == nullptr || (voi[0] == 0 && voi[2] == 0 && voi[4] == 0);
+
   //----------------------------------------------------------------------------
   // Handle boundary conditions (BC) patches
   //----------------------------------------------------------------------------
-  if (!this->CreateEachSolutionAsBlock && sil->ReadPatchesForBase(basename))
+  if (!this->CreateEachSolutionAsBlock && firstPiece && sil->ReadPatchesForBase(basename))
   {
     vtkNew<vtkMultiBlockDataSet> newZoneMB;
 
     vtkSmartPointer<vtkStructuredGrid> zoneGrid = vtkStructuredGrid::SafeDownCast(zoneDO);
+    // Patches cannot be extracted from a slab, read them from the file instead.
+    vtkSmartPointer<vtkStructuredGrid> patchSource = voi == nullptr ? zoneGrid : nullptr;
     newZoneMB->SetBlock(0u, zoneGrid);
     newZoneMB->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "Internal");
     vtkPrivate::AddIsPatchArray(zoneGrid, false);
@@ -1700,8 +1711,8 @@ int vtkCGNSReader::GetCurvilinearZone(
             if (sil->ReadPatch(basename, zonename, binfo.Name))
             {
               const unsigned int idx = patchesMB->GetNumberOfBlocks();
-              vtkSmartPointer<vtkDataSet> ds = zoneGrid
-                ? binfo.CreateDataSet(cellDim, zoneGrid)
+              vtkSmartPointer<vtkDataSet> ds = patchSource
+                ? binfo.CreateDataSet(cellDim, patchSource)
                 : vtkPrivate::readBCDataSet(binfo, base, zone, cellDim, physicalDim, zsize, this);
               vtkPrivate::AddIsPatchArray(ds, true);
               patchesMB->SetBlock(idx, ds);
@@ -1818,8 +1829,8 @@ int vtkCGNSReader::GetUnstructuredZone(
     // Try to get from cache
     const char* basename = this->Internal->GetBase(base).name;
     const char* zonename = this->Internal->GetBase(base).zones[zone].name;
-    // build a key /basename/zonename
-    keyMesh = vtkPrivate::GenerateMeshKey(basename, zonename);
+    // build a key filename:/basename/zonename
+    keyMesh = vtkPrivate::GenerateMeshKey(this->FileName, basename, zonename);
 
     points = this->MeshPointsCache.Find(keyMesh);
     if (points.Get() != nullptr)
@@ -2094,10 +2105,8 @@ int vtkCGNSReader::GetUnstructuredZone(
     // else create new grid
     const char* basename = this->Internal->GetBase(base).name;
     const char* zonename = this->Internal->GetBase(base).zones[zone].name;
-    // build a key /basename/zonename
-    std::ostringstream query;
-    query << "/" << basename << "/" << zonename << "/core";
-    keyConnect = query.str();
+    // build a key filename:/basename/zonename/core
+    keyConnect = vtkPrivate::GenerateMeshKey(this->FileName, basename, zonename) + "/core";
 
     ugrid = this->ConnectivitiesCache.Find(keyConnect);
     if (ugrid.Get() != nullptr)
@@ -3318,6 +3327,144 @@ public:
   }
 };
 
+//----------------------------------------------------------------------------
+void vtkCGNSReader::vtkPrivate::DistributeZones(vtkCGNSReader* self, int piece, int numPieces,
+  std::map<int, std::vector<ZonePiece> >& baseToZones)
+{
+  struct WorkItem
+  {
+    int Base;
+    int Zone;
+    double Weight;
+    int Axis;              // split direction, -1 if the whole zone.
+    vtkIdType CellBegin;   // cell range along Axis.
+    vtkIdType CellEnd;
+  };
+
+  // Weigh every zone by its number of cells, as read in the metadata.
+  std::vector<WorkItem> zones;
+  double totalWeight = 0.0;
+  const int numBases = self->Internal->GetNumberOfBaseNodes();
+  for (int bb = 0; bb < numBases; ++bb)
+  {
+    const CGNSRead::BaseInformation& baseInfo = self->Internal->GetBase(bb);
+    const bool hasSizes = static_cast<int>(baseInfo.zones.size()) == baseInfo.nzones;
+    for (int zz = 0; zz < baseInfo.nzones; ++zz)
+    {
+      WorkItem item = { bb, zz, 1.0, -1, 0, 0 };
+      if (hasSizes && baseInfo.zones[zz].numberOfCells > 0)
+      {
+        item.Weight = static_cast<double>(baseInfo.zones[zz].numberOfCells);
+      }
+      totalWeight += item.Weight;
+      zones.push_back(item);
+    }
+  }
+  if (zones.empty())
+  {
+    return;
+  }
+
+  // Split structured zones that are much bigger than a piece's share into
+  // slabs along their longest index direction, so they can be read in
+  // parallel using sub-extents.
+  const double share = totalWeight / numPieces;
+  std::vector<WorkItem> items;
+  for (const WorkItem& zoneItem : zones)
+  {
+    const CGNSRead::BaseInformation& baseInfo = self->Internal->GetBase(zoneItem.Base);
+    const bool hasSizes = static_cast<int>(baseInfo.zones.size()) == baseInfo.nzones;
+    if (numPieces == 1 || !hasSizes || !baseInfo.zones[zoneItem.Zone].structured ||
+      zoneItem.Weight <= 1.5 * share)
+    {
+      items.push_back(zoneItem);
+      continue;
+    }
+
+    const CGNSRead::ZoneInformation& zoneInfo = baseInfo.zones[zoneItem.Zone];
+    int axis = 0;
+    for (int dd = 1; dd < std::min(baseInfo.cellDim, 3); ++dd)
+    {
+      axis = zoneInfo.cellDims[dd] > zoneInfo.cellDims[axis] ? dd : axis;
+    }
+    const vtkIdType numCells = zoneInfo.cellDims[axis];
+    const vtkIdType numSlabs =
+      std::min(numCells, static_cast<vtkIdType>(std::ceil(zoneItem.Weight / share)));
+    for (vtkIdType slab = 0; slab < numSlabs; ++slab)
+    {
+      WorkItem item = zoneItem;
+      item.Axis = axis;
+      item.CellBegin = (numCells * slab) / numSlabs;
+      item.CellEnd = (numCells * (slab + 1)) / numSlabs;
+      item.Weight = zoneItem.Weight * (item.CellEnd - item.CellBegin) / numCells;
+      items.push_back(item);
+    }
+  }
+
+  // Assign contiguous runs of items to pieces: an item goes to the piece
+  // whose share of the total weight contains the item's midpoint.
+  double accumulated = 0.0;
+  for (const WorkItem& item : items)
+  {
+    const double midpoint = accumulated + 0.5 * item.Weight;
+    accumulated += item.Weight;
+    const int owner = std::min(numPieces - 1, static_cast<int>(midpoint * numPieces / totalWeight));
+    if (owner != piece)
+    {
+      continue;
+    }
+
+    std::vector<ZonePiece>& pieces = baseToZones[item.Base];
+    if (item.Axis < 0)
+    {
+      ZonePiece zonePiece = { item.Zone, false, { 0, 0, 0, 0, 0, 0 } };
+      pieces.push_back(zonePiece);
+      continue;
+    }
+
+    // Slabs are contiguous so consecutive slabs of a zone assigned to this
+    // piece simply extend the sub-extent.
+    if (!pieces.empty() && pieces.back().Zone == item.Zone && pieces.back().HasVOI)
+    {
+      pieces.back().VOI[2 * item.Axis + 1] = static_cast<int>(item.CellEnd);
+    }
+    else
+    {
+      const CGNSRead::ZoneInformation& zoneInfo =
+        self->Internal->GetBase(item.Base).zones[item.Zone];
+      ZonePiece zonePiece = { item.Zone, true, { 0, 0, 0, 0, 0, 0 } };
+      for (int dd = 0; dd < std::min(self->Internal->GetBase(item.Base).cellDim, 3); ++dd)
+      {
+        // VOI is expressed in 0-based point extents.
+        zonePiece.VOI[2 * dd + 1] = static_cast<int>(zoneInfo.cellDims[dd]);
+      }
+      zonePiece.VOI[2 * item.Axis] = static_cast<int>(item.CellBegin);
+      zonePiece.VOI[2 * item.Axis + 1] = static_cast<int>(item.CellEnd);
+      pieces.push_back(zonePiece);
+    }
+  }
+
+  // A zone entirely read by this piece does not need a sub-extent.
+  for (auto& bpair : baseToZones)
+  {
+    for (ZonePiece& zonePiece : bpair.second)
+    {
+      if (zonePiece.HasVOI)
+      {
+        const CGNSRead::ZoneInformation& zoneInfo =
+          self->Internal->GetBase(bpair.first).zones[zonePiece.Zone];
+        bool whole = true;
+        for (int dd = 0; dd < 3; ++dd)
+        {
+          whole = whole && zonePiece.VOI[2 * dd] == 0 &&
+            (zonePiece.VOI[2 * dd + 1] == 0 || zonePiece.VOI[2 * dd + 1] == zoneInfo.cellDims[dd]);
+        }
+        zonePiece.HasVOI = !whole;
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
@@ -3328,7 +3475,6 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
 
   int processNumber;
   int numProcessors;
-  int startRange, endRange;
 
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   // get the output
@@ -3345,67 +3491,6 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
     numProcessors = 1;
   }
 
-  int numBases = this->Internal->GetNumberOfBaseNodes();
-  int numZones = 0;
-  for (int bb = 0; bb < numBases; bb++)
-  {
-    numZones += this->Internal->GetBase(bb).nzones;
-  }
-
-  // Divide the files evenly between processors
-  int num_zones_per_process = numZones / numProcessors;
-
-  // This if/else logic is for when you don't have a nice even division of files
-  // Each process computes which sequence of files it needs to read in
-  int left_over_zones = numZones - (num_zones_per_process * numProcessors);
-  // base --> startZone,endZone
-  std::map<int, duo_t> baseToZoneRange;
-
-  // REDO this part !!!!
-  if (processNumber < left_over_zones)
-  {
-    int accumulated = 0;
-    startRange = (num_zones_per_process + 1) * processNumber;
-    endRange = startRange + (num_zones_per_process + 1);
-    for (int bb = 0; bb < numBases; bb++)
-    {
-      duo_t zoneRange;
-      startRange = startRange - accumulated;
-      endRange = endRange - accumulated;
-      int startInterZone = std::max(startRange, 0);
-      int endInterZone = std::min(endRange, this->Internal->GetBase(bb).nzones);
-
-      if ((endInterZone - startInterZone) > 0)
-      {
-        zoneRange[0] = startInterZone;
-        zoneRange[1] = endInterZone;
-      }
-      accumulated = this->Internal->GetBase(bb).nzones;
-      baseToZoneRange[bb] = zoneRange;
-    }
-  }
-  else
-  {
-    int accumulated = 0;
-    startRange = num_zones_per_process * processNumber + left_over_zones;
-    endRange = startRange + num_zones_per_process;
-    for (int bb = 0; bb < numBases; bb++)
-    {
-      duo_t zoneRange;
-      startRange = startRange - accumulated;
-      endRange = endRange - accumulated;
-      int startInterZone = std::max(startRange, 0);
-      int endInterZone = std::min(endRange, this->Internal->GetBase(bb).nzones);
-      if ((endInterZone - startInterZone) > 0)
-      {
-        zoneRange[0] = startInterZone;
-        zoneRange[1] = endInterZone;
-      }
-      accumulated = this->Internal->GetBase(bb).nzones;
-      baseToZoneRange[bb] = zoneRange;
-    }
-  }
-
   // Bnd Sections Not implemented yet for parallel
   if (numProcessors > 1)
   {
@@ -3423,6 +3508,11 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
   }
   this->IgnoreSILChangeEvents = false;
 
+  // Divide the zones between processors, balancing the number of cells.
+  // base --> zones (or parts of zones) to read
+  std::map<int, std::vector<vtkPrivate::ZonePiece> > baseToZones;
+  vtkPrivate::DistributeZones(this, processNumber, numProcessors, baseToZones);
+
   vtkMultiBlockDataSet* rootNode = output;
 
   vtkDebugMacro(<< "Start Loading CGNS data");
@@ -3576,10 +3666,9 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
     // so we don't keep ids for released nodes.
     baseChildId.resize(nz);
 
-    int zonemin = baseToZoneRange[numBase][0];
-    int zonemax = baseToZoneRange[numBase][1];
-    for (int zone = zonemin; zone < zonemax; ++zone)
+    for (const vtkPrivate::ZonePiece& zonePiece : baseToZones[numBase])
     {
+      const int zone = zonePiece.Zone;
       CGNSRead::char_33 zoneName;
       cgsize_t zsize[9];
       CGNS_ENUMT(ZoneType_t) zt = CGNS_ENUMV(ZoneTypeNull);
@@ -3686,7 +3775,8 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
           break;
         case CGNS_ENUMV(Structured):
         {
-          ier = GetCurvilinearZone(numBase, zone, cellDim, physicalDim, zsize, mbase);
+          ier = GetCurvilinearZone(numBase, zone, cellDim, physicalDim, zsize, mbase,
+            zonePiece.HasVOI ? zonePiece.VOI : nullptr);
           if (ier != CG_OK)
           {
             vtkErrorMacro(<< "Error Reading file");
@@ -3718,6 +3808,13 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
 errorData:
   cgio_close_file(this->cgioNum);
 
+  vtkDebugMacro(<< "Mesh cache: " << this->MeshPointsCache.GetNumberOfHits() << " hits, "
+                << this->MeshPointsCache.GetNumberOfMisses() << " misses, "
+                << this->MeshPointsCache.GetMemorySize() << " KiB; connectivity cache: "
+                << this->ConnectivitiesCache.GetNumberOfHits() << " hits, "
+                << this->ConnectivitiesCache.GetNumberOfMisses() << " misses, "
+                << this->ConnectivitiesCache.GetMemorySize() << " KiB");
+
   this->UpdateProgress(1.0);
   return 1;
 }
@@ -3825,6 +3922,19 @@ void vtkCGNSReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CreateEachSolutionAsBlock: " << this->CreateEachSolutionAsBlock << endl;
   os << indent << "IgnoreFlowSolutionPointers: " << this->IgnoreFlowSolutionPointers << endl;
   os << indent << "DistributeBlocks: " << this->DistributeBlocks << endl;
+  os << indent << "CacheMesh: " << this->CacheMesh << endl;
+  os << indent << "CacheConnectivity: " << this->CacheConnectivity << endl;
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << endl;
+  os << indent << "MeshPointsCache: " << this->MeshPointsCache.GetNumberOfEntries()
+     << " entries, " << this->MeshPointsCache.GetMemorySize() << " KiB, "
+     << this->MeshPointsCache.GetNumberOfHits() << " hits, "
+     << this->MeshPointsCache.GetNumberOfMisses() << " misses, "
+     << this->MeshPointsCache.GetNumberOfEvictions() << " evictions" << endl;
+  os << indent << "ConnectivitiesCache: " << this->ConnectivitiesCache.GetNumberOfEntries()
+     << " entries, " << this->ConnectivitiesCache.GetMemorySize() << " KiB, "
+     << this->ConnectivitiesCache.GetNumberOfHits() << " hits, "
+     << this->ConnectivitiesCache.GetNumberOfMisses() << " misses, "
+     << this->ConnectivitiesCache.GetNumberOfEvictions() << " evictions" << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -4212,6 +4322,26 @@ void vtkCGNSReader::SetCacheConnectivity(bool enable)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkCGNSReader::SetCacheMemoryLimit(int megabytes)
+{
+  if (this->CacheMemoryLimit != megabytes)
+  {
+    this->CacheMemoryLimit = megabytes;
+    const vtkTypeInt64 kibibytes = megabytes < 0 ? -1 : static_cast<vtkTypeInt64>(megabytes) * 1024;
+    this->MeshPointsCache.SetCacheMemoryLimit(kibibytes);
+    this->ConnectivitiesCache.SetCacheMemoryLimit(kibibytes);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkCGNSReader::GetCacheStatistics(vtkTypeUInt64& hits, vtkTypeUInt64& misses)
+{
+  hits = this->MeshPointsCache.GetNumberOfHits() + this->ConnectivitiesCache.GetNumberOfHits();
+  misses =
+    this->MeshPointsCache.GetNumberOfMisses() + this->ConnectivitiesCache.GetNumberOfMisses();
+}
+
 //==============================================================================
 // *************** LEGACY API **************************************************
 //------------------------------------------------------------------------------
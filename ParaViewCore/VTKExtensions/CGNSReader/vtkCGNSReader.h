@@ -215,8 +215,8 @@ public:
   //@{
   /**
    * This reader can cache the mesh points if they are time invariant.
-   * They will be stored with a unique reference to their /base/zonename
-   * and not be read in the file when doing unsteady analysis.
+   * They will be stored with a unique reference to their file and
+   * /base/zonename and not be read in the file when doing unsteady analysis.
    */
   void SetCacheMesh(bool enable);
   vtkGetMacro(CacheMesh, bool);
@@ -225,13 +225,31 @@ public:
   //@{
   /**
    * This reader can cache the meshconnectivities if they are time invariant.
-   * They will be stored with a unique reference to their /base/zonename
-   * and not be read in the file when doing unsteady analysis.
+   * They will be stored with a unique reference to their file and
+   * /base/zonename and not be read in the file when doing unsteady analysis.
    */
   void SetCacheConnectivity(bool enable);
   vtkGetMacro(CacheConnectivity, bool);
   vtkBooleanMacro(CacheConnectivity, bool);
 
+  //@{
+  /**
+   * Limit, in MiB, of the memory used by each of the mesh points and mesh
+   * connectivity caches. When exceeded, least-recently used entries are
+   * evicted. Negative means unlimited (default). Since caches are keyed by
+   * file and /base/zonename, entries are reused across the time steps of a
+   * file, while each file of a vtkCGNSFileSeriesReader gets its own entries.
+   */
+  void SetCacheMemoryLimit(int megabytes);
+  vtkGetMacro(CacheMemoryLimit, int);
+  //@}
+
+  /**
+   * Returns the accumulated number of cache hits and misses of the mesh points
+   * and mesh connectivity caches.
+   */
+  void GetCacheStatistics(vtkTypeUInt64& hits, vtkTypeUInt64& misses);
+
   //@{
   /**
    * Set/get the communication object used to relay a list of files
@@ -272,8 +290,12 @@ protected:
   static void SelectionModifiedCallback(
     vtkObject* caller, unsigned long eid, void* clientdata, void* calldata);
 
-  int GetCurvilinearZone(
-    int base, int zone, int cell_dim, int phys_dim, void* zsize, vtkMultiBlockDataSet* mbase);
+  /**
+   * Read a structured zone. If `voi` is not null, only the given sub-extent
+   * (0-based point extents) of the zone is read.
+   */
+  int GetCurvilinearZone(int base, int zone, int cell_dim, int phys_dim, void* zsize,
+    vtkMultiBlockDataSet* mbase, const int* voi = nullptr);
 
   int GetUnstructuredZone(
     int base, int zone, int cell_dim, int phys_dim, void* zsize, vtkMultiBlockDataSet* mbase);
@@ -307,6 +329,7 @@ private:
   bool DistributeBlocks;
   bool CacheMesh;
   bool CacheConnectivity;
+  int CacheMemoryLimit;
 
   // For internal cgio calls (low level IO)
   int cgioNum;      // cgio file reference
@@ -1147,6 +1147,8 @@ static void BroadcastZones(
     {
       stream.Push(zinfo.name, 33);
       stream.Push(zinfo.family, 33);
+      stream << zinfo.structured << zinfo.numberOfCells << zinfo.cellDims[0] << zinfo.cellDims[1]
+             << zinfo.cellDims[2];
       stream << static_cast<unsigned int>(zinfo.bcs.size());
       for (auto& bcinfo : zinfo.bcs)
       {
@@ -1169,6 +1171,8 @@ static void BroadcastZones(
       stream.Pop(cref, size);
       cref = zinfo.family;
       stream.Pop(cref, size);
+      stream >> zinfo.structured >> zinfo.numberOfCells >> zinfo.cellDims[0] >>
+        zinfo.cellDims[1] >> zinfo.cellDims[2];
       stream >> count;
       zinfo.bcs.resize(count);
       for (auto& bcinfo : zinfo.bcs)
@@ -185,10 +185,18 @@ public:
   char_33 name;
   char_33 family;
   std::vector<CGNSRead::ZoneBCInformation> bcs;
+  // Zone size, used to balance zones across ranks. For structured zones,
+  // cellDims holds the number of cells along each index direction.
+  bool structured;
+  vtkIdType numberOfCells;
+  vtkIdType cellDims[3];
   ZoneInformation()
   {
     this->name[0] = '\0';
     this->family[0] = '\0';
+    this->structured = false;
+    this->numberOfCells = 0;
+    this->cellDims[0] = this->cellDims[1] = this->cellDims[2] = 0;
   }
 };
 
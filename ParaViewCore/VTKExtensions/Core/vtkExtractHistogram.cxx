@@ -26,6 +26,7 @@
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVProgressAccumulator.h"
 #include "vtkPointData.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -284,8 +285,8 @@ inline int vtkExtractHistogramClamp(int value, int min, int max)
 }
 
 //-----------------------------------------------------------------------------
-void vtkExtractHistogram::BinAnArray(
-  vtkDataArray* data_array, vtkIntArray* bin_values, double min, double max, vtkFieldData* field)
+void vtkExtractHistogram::BinAnArray(vtkDataArray* data_array, vtkIntArray* bin_values,
+  double min, double max, vtkFieldData* field, vtkPVProgressAccumulator& progress)
 {
   // If the requested component is out-of-range for the input,
   // the bin_values will be 0, so no need to do any actual counting.
@@ -302,9 +303,9 @@ void vtkExtractHistogram::BinAnArray(
 
   for (int i = 0; i != num_of_tuples; ++i)
   {
-    if (i % 1000 == 0)
+    if (i % 1000 == 999)
     {
-      this->UpdateProgress(0.10 + 0.90 * i / num_of_tuples);
+      progress.Add(1000);
     }
     double value;
     // if component is equal to the number of components, then the magnitude was requested.
@@ -407,20 +408,31 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
   {
     // for composite datasets visit each leaf dataset and add in its counts
     vtkCompositeDataIterator* cdit = cdin->NewIterator();
+    vtkIdType total_tuples = 0;
+    for (cdit->InitTraversal(); !cdit->IsDoneWithTraversal(); cdit->GoToNextItem())
+    {
+      vtkDataArray* data_array = this->GetInputArrayToProcess(0, cdit->GetCurrentDataObject());
+      total_tuples += data_array ? data_array->GetNumberOfTuples() : 0;
+    }
+    vtkPVProgressAccumulator progress(this, total_tuples, 0.10, 1.0);
     cdit->InitTraversal();
     while (!cdit->IsDoneWithTraversal())
     {
       vtkDataObject* dObj = cdit->GetCurrentDataObject();
       vtkDataArray* data_array = this->GetInputArrayToProcess(0, dObj);
-      this->BinAnArray(data_array, bin_values, min, max, this->GetInputFieldData(dObj));
+      this->BinAnArray(data_array, bin_values, min, max, this->GetInputFieldData(dObj), progress);
       cdit->GoToNextItem();
     }
     cdit->Delete();
+    progress.Finish();
   }
   else
   {
     vtkDataArray* data_array = this->GetInputArrayToProcess(0, inputVector);
-    this->BinAnArray(data_array, bin_values, min, max, this->GetInputFieldData(input));
+    vtkPVProgressAccumulator progress(
+      this, data_array ? data_array->GetNumberOfTuples() : 0, 0.10, 1.0);
+    this->BinAnArray(data_array, bin_values, min, max, this->GetInputFieldData(input), progress);
+    progress.Finish();
   }
 
   if (this->CalculateAverages)
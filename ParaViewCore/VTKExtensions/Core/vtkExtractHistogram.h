@@ -33,6 +33,7 @@
 class vtkDoubleArray;
 class vtkFieldData;
 class vtkIntArray;
+class vtkPVProgressAccumulator;
 struct vtkEHInternals;
 
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkExtractHistogram : public vtkTableAlgorithm
@@ -124,8 +125,8 @@ protected:
   virtual bool InitializeBinExtents(
     vtkInformationVector** inputVector, vtkDoubleArray* bin_extents, double& min, double& max);
 
-  void BinAnArray(
-    vtkDataArray* src, vtkIntArray* vals, double min, double max, vtkFieldData* field);
+  void BinAnArray(vtkDataArray* src, vtkIntArray* vals, double min, double max,
+    vtkFieldData* field, vtkPVProgressAccumulator& progress);
 
   void FillBinExtents(vtkDoubleArray* bin_extents, double min, double max);
 
@@ -98,15 +98,15 @@ int vtkPExtractHistogram::RequestData(
   reduceFilter->SetController(this->Controller);
 
   bool isRoot = (this->Controller->GetLocalProcessId() == 0);
-  if (isRoot)
-  {
-    // PostGatherHelper needs to be set only on the root node.
-    vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
-      vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
-    rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
-    rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
-    reduceFilter->SetPostGatherHelper(rf);
-  }
+
+  // Adding bin values is associative, so histograms are reduced along a tree.
+  // This requires the PostGatherHelper on all nodes.
+  vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
+    vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
+  rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
+  rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
+  reduceFilter->SetPostGatherHelper(rf);
+  reduceFilter->TreeReductionOn();
 
   vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
   copy->ShallowCopy(output);
@@ -0,0 +1,131 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVProgressAccumulator.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVProgressAccumulator
+ * @brief   cheap, thread-safe progress counter for algorithms.
+ *
+ * vtkPVProgressAccumulator lets an algorithm report progress from tight loops
+ * (including loops split across threads using vtkSMPTools) without paying for
+ * a vtkCommand::ProgressEvent on every call. Work units are accumulated with a
+ * single atomic add; vtkAlgorithm::UpdateProgress() is only called when the
+ * accumulated work crosses the next reporting step (1% by default) and only
+ * from the thread that created the accumulator, since progress observers are
+ * not thread-safe.
+ *
+ * Accumulators can be nested by mapping their [0, 1] range to a sub-range of
+ * the algorithm's progress, e.g. to report the second of two passes.
+ *
+ * @code{cpp}
+ * vtkPVProgressAccumulator progress(this, numTuples, 0.1, 1.0);
+ * vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+ *   for (vtkIdType cc = begin; cc < end; ++cc)
+ *   {
+ *     ...
+ *   }
+ *   progress.Add(end - begin);
+ * });
+ * @endcode
+ */
+
+#ifndef vtkPVProgressAccumulator_h
+#define vtkPVProgressAccumulator_h
+
+#include "vtkAlgorithm.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+#include "vtkType.h"
+
+#include <atomic> // for std::atomic
+#include <thread> // for std::thread::id
+
+class vtkPVProgressAccumulator
+{
+public:
+  /**
+   * Create an accumulator for `totalWork` units of work reported to `algo` in
+   * the progress sub-range [`start`, `end`]. `steps` is the number of
+   * UpdateProgress calls made over the full range.
+   */
+  vtkPVProgressAccumulator(
+    vtkAlgorithm* algo, vtkIdType totalWork, double start = 0.0, double end = 1.0, int steps = 100)
+    : Algorithm(algo)
+    , TotalWork(totalWork > 0 ? totalWork : 1)
+    , Start(start)
+    , End(end)
+    , Steps(steps > 0 ? steps : 1)
+    , Owner(std::this_thread::get_id())
+    , Done(0)
+    , ReportedStep(-1)
+  {
+  }
+
+  /**
+   * Add `work` units of completed work. Safe to call concurrently.
+   */
+  void Add(vtkIdType work)
+  {
+    const vtkIdType done = this->Done.fetch_add(work, std::memory_order_relaxed) + work;
+    const int step = static_cast<int>((this->Steps * done) / this->TotalWork);
+    if (step <= this->ReportedStep.load(std::memory_order_relaxed) ||
+      std::this_thread::get_id() != this->Owner)
+    {
+      return;
+    }
+    this->Report(step, done);
+  }
+
+  /**
+   * Report completion of the sub-range.
+   */
+  void Finish()
+  {
+    if (std::this_thread::get_id() == this->Owner && this->Algorithm)
+    {
+      this->ReportedStep.store(this->Steps, std::memory_order_relaxed);
+      this->Algorithm->UpdateProgress(this->End);
+    }
+  }
+
+  /**
+   * Returns the work accumulated so far.
+   */
+  vtkIdType GetDone() const { return this->Done.load(std::memory_order_relaxed); }
+
+private:
+  vtkPVProgressAccumulator(const vtkPVProgressAccumulator&) = delete;
+  void operator=(const vtkPVProgressAccumulator&) = delete;
+
+  void Report(int step, vtkIdType done)
+  {
+    this->ReportedStep.store(step, std::memory_order_relaxed);
+    if (this->Algorithm)
+    {
+      const double fraction =
+        done >= this->TotalWork ? 1.0 : static_cast<double>(done) / this->TotalWork;
+      this->Algorithm->UpdateProgress(this->Start + (this->End - this->Start) * fraction);
+    }
+  }
+
+  vtkAlgorithm* Algorithm;
+  const vtkIdType TotalWork;
+  const double Start;
+  const double End;
+  const int Steps;
+  const std::thread::id Owner;
+  std::atomic<vtkIdType> Done;
+  std::atomic<int> ReportedStep;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkPVProgressAccumulator.h
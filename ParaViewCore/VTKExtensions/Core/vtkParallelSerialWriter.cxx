@@ -24,6 +24,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
@@ -31,8 +32,13 @@
 
 #include <algorithm>
 #include <cassert>
+#include <map>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <vtksys/SystemInformation.hxx>
 #include <vtksys/SystemTools.hxx>
 
 namespace
@@ -48,6 +54,32 @@ bool vtkIsEmpty(vtkDataObject* dobj)
   }
   return true;
 }
+
+// Appends `pieces` into a single data object using `helper`.
+vtkSmartPointer<vtkDataObject> vtkAppendPieces(
+  vtkAlgorithm* helper, std::vector<vtkSmartPointer<vtkDataObject> > pieces)
+{
+  if (pieces.size() <= 1)
+  {
+    return pieces.empty() ? nullptr : pieces[0];
+  }
+
+  helper->RemoveAllInputs();
+  for (auto& piece : pieces)
+  {
+    helper->AddInputDataObject(piece);
+  }
+  pieces.clear();
+  helper->Update();
+  vtkDataObject* appended = helper->GetOutputDataObject(0);
+  vtkSmartPointer<vtkDataObject> result;
+  result.TakeReference(appended->NewInstance());
+  result->ShallowCopy(appended);
+  helper->RemoveAllInputs();
+  return result;
+}
+
+static const int PARALLEL_SERIAL_WRITER_PIECE_TAG = 88030;
 }
 
 vtkStandardNewMacro(vtkParallelSerialWriter);
@@ -59,6 +91,7 @@ vtkCxxSetObjectMacro(vtkParallelSerialWriter, Controller, vtkMultiProcessControl
 vtkParallelSerialWriter::vtkParallelSerialWriter()
   : NumberOfIORanks(1)
   , RankAssignmentMode(vtkParallelSerialWriter::ASSIGNMENT_MODE_CONTIGUOUS)
+  , AggregationBufferSize(0)
   , Controller(nullptr)
   , SubController(nullptr)
 {
@@ -215,10 +248,14 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
         this->SubControllerColor = mod + (myid - (div + 1) * mod) / div;
       }
     }
-    else
+    else if (this->RankAssignmentMode == ASSIGNMENT_MODE_ROUND_ROBIN)
     {
       this->SubControllerColor = myid % num_io_ranks;
     }
+    else
+    {
+      this->SubControllerColor = this->GetHostGroup(num_io_ranks);
+    }
     assert(this->SubControllerColor >= 0 && this->SubControllerColor < num_io_ranks);
     this->SubController.TakeReference(
       this->Controller->PartitionController(this->SubControllerColor, myid));
@@ -278,7 +315,12 @@ void vtkParallelSerialWriter::WriteAFile(const std::string& filename_arg, vtkDat
 {
   auto controller = this->SubController ? this->SubController.GetPointer() : this->Controller;
 
-  const auto filename = this->GetPartitionFileName(filename_arg);
+  if (this->AggregationBufferSize > 0 && this->PostGatherHelper &&
+    controller->GetNumberOfProcesses() > 1)
+  {
+    this->Aggregate(controller, filename_arg, input);
+    return;
+  }
 
   vtkSmartPointer<vtkReductionFilter> reductionFilter = vtkSmartPointer<vtkReductionFilter>::New();
   reductionFilter->SetController(controller);
@@ -294,37 +336,169 @@ void vtkParallelSerialWriter::WriteAFile(const std::string& filename_arg, vtkDat
 
   if (controller->GetLocalProcessId() == 0)
   {
-    vtkDataObject* output = reductionFilter->GetOutputDataObject(0);
-    if (vtkIsEmpty(output) == false)
+    this->WriteOutput(
+      this->GetPartitionFileName(filename_arg), reductionFilter->GetOutputDataObject(0));
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkParallelSerialWriter::WriteOutput(const std::string& filename, vtkDataObject* output)
+{
+  if (vtkIsEmpty(output))
+  {
+    return;
+  }
+
+  std::ostringstream fname;
+  if (this->WriteAllTimeSteps)
+  {
+    std::string path = vtksys::SystemTools::GetFilenamePath(filename);
+    std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
+    std::string ext = vtksys::SystemTools::GetFilenameLastExtension(filename);
+    if (this->FileNameSuffix && vtkFileSeriesWriter::SuffixValidation(this->FileNameSuffix))
     {
-      std::ostringstream fname;
-      if (this->WriteAllTimeSteps)
-      {
-        std::string path = vtksys::SystemTools::GetFilenamePath(filename);
-        std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
-        std::string ext = vtksys::SystemTools::GetFilenameLastExtension(filename);
-        if (this->FileNameSuffix && vtkFileSeriesWriter::SuffixValidation(this->FileNameSuffix))
-        {
-          // Print this->CurrentTimeIndex to a string using this->FileNameSuffix as format
-          char suffix[100];
-          snprintf(suffix, 100, this->FileNameSuffix, this->CurrentTimeIndex);
-          fname << path << "/" << fnamenoext << suffix << ext;
-        }
-        else
-        {
-          fname << path << "/" << fnamenoext << "." << this->CurrentTimeIndex << ext;
-        }
-      }
-      else
-      {
-        fname << filename;
-      }
-      this->Writer->SetInputDataObject(output);
-      this->SetWriterFileName(fname.str().c_str());
-      this->WriteInternal();
-      this->Writer->SetInputConnection(0);
+      // Print this->CurrentTimeIndex to a string using this->FileNameSuffix as format
+      char suffix[100];
+      snprintf(suffix, 100, this->FileNameSuffix, this->CurrentTimeIndex);
+      fname << path << "/" << fnamenoext << suffix << ext;
+    }
+    else
+    {
+      fname << path << "/" << fnamenoext << "." << this->CurrentTimeIndex << ext;
+    }
+  }
+  else
+  {
+    fname << filename;
+  }
+  this->Writer->SetInputDataObject(output);
+  this->SetWriterFileName(fname.str().c_str());
+  this->WriteInternal();
+  this->Writer->SetInputConnection(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkParallelSerialWriter::Aggregate(
+  vtkMultiProcessController* controller, const std::string& filename, vtkDataObject* input)
+{
+  // pre-process the local data as vtkReductionFilter does, without gathering.
+  vtkSmartPointer<vtkDataObject> piece;
+  {
+    vtkNew<vtkReductionFilter> reductionFilter;
+    reductionFilter->SetController(nullptr);
+    reductionFilter->SetPreGatherHelper(this->PreGatherHelper);
+    reductionFilter->SetPostGatherHelper(this->PostGatherHelper);
+    reductionFilter->SetInputDataObject(input);
+    reductionFilter->UpdateInformation();
+    vtkInformation* outInfo = reductionFilter->GetExecutive()->GetOutputInformation(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), this->Piece);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), this->NumberOfPieces);
+    outInfo->Set(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), this->GhostLevel);
+    reductionFilter->Update();
+    vtkDataObject* reduced = reductionFilter->GetOutputDataObject(0);
+    piece.TakeReference(reduced->NewInstance());
+    piece->ShallowCopy(reduced);
+  }
+
+  if (controller->GetLocalProcessId() != 0)
+  {
+    // the root receives from one rank at a time, so large pieces are not
+    // transferred until the root is ready for them.
+    controller->Send(piece, 0, PARALLEL_SERIAL_WRITER_PIECE_TAG);
+    return;
+  }
+
+  // each batch is appended and written to its own partition file while the
+  // next batch is received. Batches are limited to half of the buffer size so
+  // that the batch being written and the one being received fit in it.
+  // GetActualMemorySize() is in KiB.
+  const unsigned long batch_limit = static_cast<unsigned long>(this->AggregationBufferSize) * 512;
+  std::vector<vtkSmartPointer<vtkDataObject> > batch;
+  unsigned long batch_size = 0;
+  int partition = 0;
+  std::thread writer;
+  auto writeBatch = [&]() {
+    if (writer.joinable())
+    {
+      writer.join();
+    }
+    if (batch.empty())
+    {
+      return;
+    }
+    const std::string fname = this->GetPartitionFileName(filename, partition++);
+    writer = std::thread(
+      [this, fname](std::vector<vtkSmartPointer<vtkDataObject> > pieces) {
+        this->WriteOutput(fname, vtkAppendPieces(this->PostGatherHelper, std::move(pieces)));
+      },
+      std::move(batch));
+    batch.clear();
+    batch_size = 0;
+  };
+
+  auto addPiece = [&](vtkSmartPointer<vtkDataObject> dobj) {
+    if (dobj && !vtkIsEmpty(dobj))
+    {
+      batch_size += dobj->GetActualMemorySize();
+      batch.push_back(std::move(dobj));
+    }
+    if (batch_size >= batch_limit)
+    {
+      writeBatch();
+    }
+  };
+
+  addPiece(std::move(piece));
+  const int num_ranks = controller->GetNumberOfProcesses();
+  for (int rank = 1; rank < num_ranks; ++rank)
+  {
+    vtkSmartPointer<vtkDataObject> received;
+    received.TakeReference(controller->ReceiveDataObject(rank, PARALLEL_SERIAL_WRITER_PIECE_TAG));
+    addPiece(std::move(received));
+  }
+  writeBatch();
+  if (writer.joinable())
+  {
+    writer.join();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkParallelSerialWriter::GetHostGroup(int numberOfGroups)
+{
+  const int myid = this->Controller->GetLocalProcessId();
+  const int num_ranks = this->Controller->GetNumberOfProcesses();
+
+  vtksys::SystemInformation sysinfo;
+  const size_t max_length = 256;
+  std::vector<char> hostname(max_length, '\0');
+  const std::string myhostname = sysinfo.GetHostname();
+  std::copy_n(
+    myhostname.begin(), std::min(myhostname.size(), max_length - 1), hostname.begin());
+  std::vector<char> hostnames(max_length * num_ranks, '\0');
+  this->Controller->AllGather(&hostname[0], &hostnames[0], static_cast<vtkIdType>(max_length));
+
+  // number hosts in the order of their first rank.
+  std::map<std::string, int> hosts;
+  int myhost = 0;
+  for (int rank = 0; rank < num_ranks; ++rank)
+  {
+    const std::string name(&hostnames[rank * max_length]);
+    auto iter = hosts.find(name);
+    if (iter == hosts.end())
+    {
+      iter = hosts.insert(std::make_pair(name, static_cast<int>(hosts.size()))).first;
+    }
+    if (rank == myid)
+    {
+      myhost = iter->second;
     }
   }
+
+  const int num_hosts = static_cast<int>(hosts.size());
+  const int num_groups = std::min(numberOfGroups, num_hosts);
+  return static_cast<int>((static_cast<long long>(myhost) * num_groups) / num_hosts);
 }
 
 //----------------------------------------------------------------------------
@@ -358,16 +532,25 @@ void vtkParallelSerialWriter::WriteInternal()
 }
 
 //-----------------------------------------------------------------------------
-std::string vtkParallelSerialWriter::GetPartitionFileName(const std::string& fname)
+std::string vtkParallelSerialWriter::GetPartitionFileName(const std::string& fname, int partition)
 {
+  std::string suffix;
   if (this->SubController != nullptr && this->SubControllerColor >= 0)
   {
-    std::string path = vtksys::SystemTools::GetFilenamePath(fname);
-    std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(fname);
-    std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fname);
-    return path + "/" + fnamenoext + "-" + std::to_string(this->SubControllerColor) + ext;
+    suffix += "-" + std::to_string(this->SubControllerColor);
+  }
+  if (partition >= 0)
+  {
+    suffix += "-" + std::to_string(partition);
+  }
+  if (suffix.empty())
+  {
+    return fname;
   }
-  return fname;
+  std::string path = vtksys::SystemTools::GetFilenamePath(fname);
+  std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(fname);
+  std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fname);
+  return path + "/" + fnamenoext + suffix + ext;
 }
 
 //-----------------------------------------------------------------------------
@@ -387,4 +570,7 @@ void vtkParallelSerialWriter::SetWriterFileName(const char* fname)
 void vtkParallelSerialWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfIORanks: " << this->NumberOfIORanks << endl;
+  os << indent << "RankAssignmentMode: " << this->RankAssignmentMode << endl;
+  os << indent << "AggregationBufferSize: " << this->AggregationBufferSize << endl;
 }
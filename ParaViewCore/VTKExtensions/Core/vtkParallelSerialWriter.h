@@ -167,7 +167,8 @@ public:
   enum
   {
     ASSIGNMENT_MODE_CONTIGUOUS,
-    ASSIGNMENT_MODE_ROUND_ROBIN
+    ASSIGNMENT_MODE_ROUND_ROBIN,
+    ASSIGNMENT_MODE_HOST
   };
 
   //@{
@@ -185,12 +186,34 @@ public:
    * In ASSIGNMENT_MODE_ROUND_ROBIN, the grouping is done in round robin fashion, thus for 16 MPI
    * ranks with NumberOfIORanks set to 3, the groups are
    * `[0, 3, ..., 15], [1, 4, ..., 13], [2, 5, ..., 14]` with 0, 1 and 2 doing the IO.
+   *
+   * In ASSIGNMENT_MODE_HOST, ranks running on the same host are always in the same
+   * group, so that data is aggregated over the node's shared memory rather than the
+   * network. Hosts are grouped contiguously into `NumberOfIORanks` groups; when
+   * `NumberOfIORanks` is at least the number of hosts, the first rank on each host
+   * does the IO for that host.
    */
-  vtkSetClampMacro(
-    RankAssignmentMode, int, ASSIGNMENT_MODE_CONTIGUOUS, ASSIGNMENT_MODE_ROUND_ROBIN);
+  vtkSetClampMacro(RankAssignmentMode, int, ASSIGNMENT_MODE_CONTIGUOUS, ASSIGNMENT_MODE_HOST);
   vtkGetMacro(RankAssignmentMode, int);
   //@}
 
+  //@{
+  /**
+   * When greater than 0, data is not gathered to the IO ranks all at once.
+   * Instead, each IO rank receives pieces one rank at a time and, each time
+   * about half this many MiB of pieces were received, appends them using the
+   * PostGatherHelper and writes them to their own partition file while the
+   * next pieces are received. Partition files are named
+   * `name[-group]-<batch>.ext`, where `<batch>` counts from 0. Memory used on
+   * IO ranks stays on the order of AggregationBufferSize, unless a single
+   * piece is larger.
+   * Default is 0, i.e. all pieces are gathered and written to a single file.
+   * Ignored when there is no PostGatherHelper.
+   */
+  vtkSetClampMacro(AggregationBufferSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(AggregationBufferSize, int);
+  //@}
+
   //@{
   /**
    * Get/Set the controller to use. By default initialized to
@@ -221,7 +244,30 @@ private:
   void SetWriterFileName(const char* fname);
   void WriteInternal();
 
-  std::string GetPartitionFileName(const std::string& fname);
+  /**
+   * Returns `fname` with the group of this rank and, when `partition` is not
+   * negative, the aggregation batch appended before the extension.
+   */
+  std::string GetPartitionFileName(const std::string& fname, int partition = -1);
+
+  /**
+   * Writes `output`, if not empty, to `filename` adjusted for the current
+   * time step.
+   */
+  void WriteOutput(const std::string& filename, vtkDataObject* output);
+
+  /**
+   * Returns the group of this rank in ASSIGNMENT_MODE_HOST.
+   */
+  int GetHostGroup(int numberOfGroups);
+
+  /**
+   * Pre-processes the input on every rank of `controller` and writes the
+   * results on its root, one partition file of `filename` per batch of
+   * AggregationBufferSize.
+   */
+  void Aggregate(
+    vtkMultiProcessController* controller, const std::string& filename, vtkDataObject* input);
 
   vtkAlgorithm* PreGatherHelper;
   vtkAlgorithm* PostGatherHelper;
@@ -244,6 +290,7 @@ private:
 
   int NumberOfIORanks;
   int RankAssignmentMode;
+  int AggregationBufferSize;
 
   vtkMultiProcessController* Controller;
   vtkSmartPointer<vtkMultiProcessController> SubController;
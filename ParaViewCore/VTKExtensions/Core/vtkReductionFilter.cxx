@@ -40,10 +40,64 @@
 #include "vtkToolkits.h"
 #include "vtkTrivialProducer.h"
 
-#include <sstream>
-#include <sstream>
+#include <string>
 #include <vector>
 
+namespace
+{
+// Sends `data`, which may be a vtkSelection or null, to `destProcessId`.
+void vtkReductionFilterSend(
+  vtkMultiProcessController* controller, vtkDataObject* data, int destProcessId)
+{
+  const int tag = vtkReductionFilter::TREE_REDUCTION;
+  vtkSelection* sel = vtkSelection::SafeDownCast(data);
+  int kind = data == nullptr ? 0 : (sel ? 1 : 2);
+  controller->Send(&kind, 1, destProcessId, tag);
+  if (sel)
+  {
+    // selections cannot be sent as data objects.
+    std::string str;
+    vtkSelectionSerializer::SaveBinary(str, sel);
+    vtkIdType length = static_cast<vtkIdType>(str.size());
+    controller->Send(&length, 1, destProcessId, tag);
+    controller->Send(str.c_str(), length, destProcessId, tag);
+  }
+  else if (data)
+  {
+    controller->Send(data, destProcessId, tag);
+  }
+}
+
+// Receives data sent with vtkReductionFilterSend().
+vtkSmartPointer<vtkDataObject> vtkReductionFilterReceive(
+  vtkMultiProcessController* controller, int sourceProcessId)
+{
+  const int tag = vtkReductionFilter::TREE_REDUCTION;
+  int kind = 0;
+  controller->Receive(&kind, 1, sourceProcessId, tag);
+  vtkSmartPointer<vtkDataObject> data;
+  if (kind == 1)
+  {
+    vtkIdType length = 0;
+    controller->Receive(&length, 1, sourceProcessId, tag);
+    std::vector<char> buffer(length + 1, 0);
+    controller->Receive(&buffer[0], length, sourceProcessId, tag);
+    vtkNew<vtkSelection> sel;
+    if (!vtkSelectionSerializer::LoadBinary(&buffer[0], static_cast<size_t>(length), sel.Get()))
+    {
+      vtkGenericWarningMacro(
+        "Failed to parse the selection received from process " << sourceProcessId << ".");
+    }
+    data = sel.Get();
+  }
+  else if (kind == 2)
+  {
+    data.TakeReference(controller->ReceiveDataObject(sourceProcessId, tag));
+  }
+  return data;
+}
+}
+
 vtkStandardNewMacro(vtkReductionFilter);
 vtkCxxSetObjectMacro(vtkReductionFilter, Controller, vtkMultiProcessController);
 vtkCxxSetObjectMacro(vtkReductionFilter, PreGatherHelper, vtkAlgorithm);
@@ -60,6 +114,7 @@ vtkReductionFilter::vtkReductionFilter()
   this->GenerateProcessIds = 0;
   this->ReductionMode = vtkReductionFilter::REDUCE_ALL_TO_ONE;
   this->ReductionProcessId = 0;
+  this->TreeReduction = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -367,43 +422,62 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     }
   }
 
-  std::vector<vtkSmartPointer<vtkDataObject> > data_sets;
-  std::vector<vtkSmartPointer<vtkDataObject> > receiveData(numProcs);
+  const bool allToAll = this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ALL;
+  // REDUCE_ALL_TO_ALL reduces on process 0 and broadcasts the result.
+  const int destId = allToAll ? 0 : this->ReductionProcessId;
 
-  if (vtkSelection* sel = vtkSelection::SafeDownCast(preOutput))
+  std::vector<vtkSmartPointer<vtkDataObject> > data_sets;
+  if (this->TreeReduction && this->PassThrough < 0)
   {
-    if (this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ALL)
+    vtkSmartPointer<vtkDataObject> reduced = this->TreeReduce(preOutput, output);
+    if (destId != 0)
     {
-      for (int i = 0; i < controller->GetNumberOfProcesses(); i++)
+      if (myId == 0)
+      {
+        vtkReductionFilterSend(controller, reduced, destId);
+      }
+      else if (myId == destId)
       {
-        this->GatherSelection(sel, receiveData, i);
+        reduced = vtkReductionFilterReceive(controller, 0);
       }
     }
-    else
+    if (allToAll)
     {
-      this->GatherSelection(sel, receiveData, this->ReductionProcessId);
+      reduced = this->Broadcast(reduced);
     }
-  }
-  else
-  {
-    if (this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ALL)
+
+    if (myId == destId || allToAll)
     {
-      for (int i = 0; i < controller->GetNumberOfProcesses(); i++)
+      if (reduced)
       {
-        controller->Gather(preOutput, receiveData, i);
+        data_sets.push_back(reduced);
       }
     }
-    else
+    else if (preOutput && this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ONE)
+    {
+      data_sets.push_back(preOutput);
+    }
+    if (data_sets.size() > 0)
     {
-      controller->Gather(preOutput, receiveData, this->ReductionProcessId);
+      this->PostProcess(output, &data_sets[0], static_cast<unsigned int>(data_sets.size()));
     }
+    return;
+  }
+
+  std::vector<vtkSmartPointer<vtkDataObject> > receiveData(numProcs);
+  if (vtkSelection* sel = vtkSelection::SafeDownCast(preOutput))
+  {
+    this->GatherSelection(sel, receiveData, destId);
+  }
+  else
+  {
+    controller->Gather(preOutput, receiveData, destId);
   }
 
   // the reduction from all ranks may return NULL datasets on certain ranks.
   // So, we need to handle receiveData having NULLs.
   assert(static_cast<int>(receiveData.size()) == numProcs);
-  if (myId == this->ReductionProcessId ||
-    this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ALL)
+  if (myId == destId)
   {
     if (this->PassThrough >= 0 && receiveData[this->PassThrough] != NULL)
     {
@@ -420,33 +494,112 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
       }
     }
   }
-  else if (myId != this->ReductionProcessId && preOutput &&
-    this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ONE)
+  else if (preOutput && this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ONE)
   {
     data_sets.push_back(preOutput);
   }
 
   // Now run the PostGatherHelper.
-  // If myId==this->ReductionProcessId or this->ReductionMode ==
-  // vtkReductionFilter::REDUCE_ALL_TO_ALL
-  // data_sets has datasets collected from all satellites otherwise
-  // it contains the current process's result.
+  // If myId==destId data_sets has datasets collected from all satellites
+  // otherwise it contains the current process's result.
   if (data_sets.size() > 0)
   {
     this->PostProcess(output, &data_sets[0], static_cast<unsigned int>(data_sets.size()));
   }
+
+  if (allToAll)
+  {
+    // all processes get the same result as process 0.
+    vtkSmartPointer<vtkDataObject> reduced =
+      this->Broadcast(myId == 0 && data_sets.size() > 0 ? output : nullptr);
+    if (myId != 0 && reduced)
+    {
+      output->ShallowCopy(reduced);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkReductionFilter::TreeReduce(
+  vtkDataObject* preOutput, vtkDataObject* output)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  // At the level `mask`, process myId holds the partial result of processes
+  // [myId, myId + mask) and combines it with the one of
+  // [myId + mask, myId + 2 * mask), unless it sends its own up the tree.
+  vtkSmartPointer<vtkDataObject> reduced = preOutput;
+  for (int mask = 1; mask < numProcs; mask <<= 1)
+  {
+    if (myId & mask)
+    {
+      vtkReductionFilterSend(controller, reduced, myId - mask);
+      return nullptr;
+    }
+    if (myId + mask >= numProcs)
+    {
+      continue;
+    }
+
+    vtkSmartPointer<vtkDataObject> received = vtkReductionFilterReceive(controller, myId + mask);
+    if (!reduced)
+    {
+      reduced = received;
+    }
+    else if (received)
+    {
+      vtkSmartPointer<vtkDataObject> inputs[2] = { reduced, received };
+      vtkSmartPointer<vtkDataObject> combined;
+      combined.TakeReference(output->NewInstance());
+      this->PostProcess(combined, inputs, 2);
+      reduced = combined;
+    }
+  }
+  return reduced;
 }
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkReductionFilter::Broadcast(vtkDataObject* data)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  // receive from the process that differs by the lowest set bit of myId, then
+  // send to the processes that differ by the lower bits.
+  vtkSmartPointer<vtkDataObject> result = data;
+  int mask = 1;
+  while (mask < numProcs)
+  {
+    if (myId & mask)
+    {
+      result = vtkReductionFilterReceive(controller, myId - mask);
+      break;
+    }
+    mask <<= 1;
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1)
+  {
+    if (myId + mask < numProcs)
+    {
+      vtkReductionFilterSend(controller, result, myId + mask);
+    }
+  }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 int vtkReductionFilter::GatherSelection(vtkSelection* sendData,
   std::vector<vtkSmartPointer<vtkDataObject> >& receiveData, int destProcessId)
 {
-  std::ostringstream sendBufferOstr;
+  std::string sendBufferStr;
   if (sendData)
   {
-    vtkSelectionSerializer::PrintXML(sendBufferOstr, vtkIndent(), 1, sendData);
+    vtkSelectionSerializer::SaveBinary(sendBufferStr, sendData);
   }
 
-  std::string sendBufferStr = sendBufferOstr.str();
   vtkNew<vtkCharArray> sendBuffer;
   vtkNew<vtkCharArray> recvBuffer;
   sendBuffer->SetArray(const_cast<char*>(sendBufferStr.c_str()), sendBufferStr.size(), 1);
@@ -461,12 +614,15 @@ int vtkReductionFilter::GatherSelection(vtkSelection* sendData,
       for (int i = 0; i < this->Controller->GetNumberOfProcesses(); ++i)
       {
         // offsets has NumberOfProcesses+1 elements
-        unsigned int length = (offsets->GetValue(i + 1) - offsets->GetValue(i));
+        vtkIdType length = (offsets->GetValue(i + 1) - offsets->GetValue(i));
         if (length != 0)
         {
           vtkNew<vtkSelection> sel;
-          vtkSelectionSerializer::Parse(
-            recvBuffer->GetPointer(offsets->GetValue(i)), length, sel.Get());
+          if (!vtkSelectionSerializer::LoadBinary(recvBuffer->GetPointer(offsets->GetValue(i)),
+                static_cast<size_t>(length), sel.Get()))
+          {
+            vtkErrorMacro("Failed to parse the selection received from process " << i << ".");
+          }
           receiveData[i] = sel.Get();
         }
       }
@@ -486,4 +642,5 @@ void vtkReductionFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
   os << indent << "GenerateProcessIds: " << this->GenerateProcessIds << endl;
+  os << indent << "TreeReduction: " << this->TreeReduction << endl;
 }
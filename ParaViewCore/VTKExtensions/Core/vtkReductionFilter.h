@@ -28,6 +28,12 @@
  * In addition to doing reduction the PassThrough variable lets you choose
  * to pass through the results of any one node instead of aggregating all of
  * them together.
+ *
+ * When the PostGatherHelper is associative (appending datasets or tables,
+ * adding attributes, merging histograms), TreeReduction can be set to reduce
+ * the data along a binomial tree instead, so that no node receives more than
+ * log2(N) partial results. REDUCE_ALL_TO_ALL reduces on process 0 and
+ * broadcasts the result along a binomial tree.
 */
 
 #ifndef vtkReductionFilter_h
@@ -124,9 +130,26 @@ public:
   vtkGetMacro(GenerateProcessIds, int);
   //@}
 
+  //@{
+  /**
+   * When set, the data is reduced along a binomial tree: at each level,
+   * processes run the PostGatherHelper on their partial result and the one
+   * received from their partner, and send the combined result up the tree.
+   * The order of the inputs given to the PostGatherHelper is preserved, i.e.
+   * the data from lower process ids comes first. This is only valid when the
+   * PostGatherHelper is associative and set on all processes, and must be set
+   * identically on all processes. Ignored when PassThrough is set.
+   * Off by default.
+   */
+  vtkSetMacro(TreeReduction, bool);
+  vtkGetMacro(TreeReduction, bool);
+  vtkBooleanMacro(TreeReduction, bool);
+  //@}
+
   enum Tags
   {
-    TRANSMIT_DATA_OBJECT = 23484
+    TRANSMIT_DATA_OBJECT = 23484,
+    TREE_REDUCTION = 23485
   };
 
 protected:
@@ -155,6 +178,19 @@ protected:
   int GatherSelection(vtkSelection* sendData,
     std::vector<vtkSmartPointer<vtkDataObject> >& receiveData, int destProcessId);
 
+  /**
+   * Reduces `preOutput` from all processes along a binomial tree rooted at
+   * process 0, see TreeReduction. Returns the reduced data on process 0, null
+   * on other processes.
+   */
+  vtkSmartPointer<vtkDataObject> TreeReduce(vtkDataObject* preOutput, vtkDataObject* output);
+
+  /**
+   * Broadcasts `data` from process 0 to all processes along a binomial tree.
+   * `data` may be a vtkSelection or null.
+   */
+  vtkSmartPointer<vtkDataObject> Broadcast(vtkDataObject* data);
+
   vtkAlgorithm* PreGatherHelper;
   vtkAlgorithm* PostGatherHelper;
   vtkMultiProcessController* Controller;
@@ -162,6 +198,7 @@ protected:
   int GenerateProcessIds;
   int ReductionMode;
   int ReductionProcessId;
+  bool TreeReduction;
 
 private:
   vtkReductionFilter(const vtkReductionFilter&) = delete;
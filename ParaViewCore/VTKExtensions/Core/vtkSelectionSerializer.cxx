@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkSelectionSerializer.h"
 
+#include "vtkByteSwap.h"
 #include "vtkDataArray.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkInformation.h"
@@ -23,14 +24,19 @@
 #include "vtkInformationKey.h"
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationStringKey.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVInstantiator.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
+#include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 
+#include <cstring>
+#include <limits>
+
 //----------------------------------------------------------------------------
 
 vtkStandardNewMacro(vtkSelectionSerializer);
@@ -412,6 +418,437 @@ void vtkSelectionSerializer::ParseNode(vtkPVXMLElement* nodeXML, vtkSelectionNod
   }
 }
 
+namespace
+{
+const vtkTypeUInt32 vtkSelectionSerializerMagic = 0x42535650; // "PVSB"
+const vtkTypeUInt32 vtkSelectionSerializerNullString = 0xffffffff;
+
+// Byte order of the values that follow, saved first.
+const unsigned char vtkSelectionSerializerBigEndian = 0;
+const unsigned char vtkSelectionSerializerLittleEndian = 1;
+#ifdef VTK_WORDS_BIGENDIAN
+const unsigned char vtkSelectionSerializerByteOrder = vtkSelectionSerializerBigEndian;
+#else
+const unsigned char vtkSelectionSerializerByteOrder = vtkSelectionSerializerLittleEndian;
+#endif
+
+// Integer properties supported by the binary form, the same as the xml form.
+const int vtkSelectionSerializerNumberOfIntegerKeys = 13;
+vtkInformationIntegerKey* vtkSelectionSerializerIntegerKey(int index)
+{
+  switch (index)
+  {
+    case 0:
+      return vtkSelectionNode::CONTENT_TYPE();
+    case 1:
+      return vtkSelectionNode::FIELD_TYPE();
+    case 2:
+      return vtkSelectionNode::SOURCE_ID();
+    case 3:
+      return vtkSelectionSerializer::ORIGINAL_SOURCE_ID();
+    case 4:
+      return vtkSelectionNode::PROP_ID();
+    case 5:
+      return vtkSelectionNode::PROCESS_ID();
+    case 6:
+      return vtkSelectionNode::CONTAINING_CELLS();
+    case 7:
+      return vtkSelectionNode::INVERSE();
+    case 8:
+      return vtkSelectionNode::PIXEL_COUNT();
+    case 9:
+      return vtkSelectionNode::INDEXED_VERTICES();
+    case 10:
+      return vtkSelectionNode::COMPOSITE_INDEX();
+    case 11:
+      return vtkSelectionNode::HIERARCHICAL_LEVEL();
+    case 12:
+      return vtkSelectionNode::HIERARCHICAL_INDEX();
+    default:
+      return nullptr;
+  }
+}
+
+template <class T>
+void vtkSelectionSerializerSave(std::string& buffer, const T& value)
+{
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void vtkSelectionSerializerSave(std::string& buffer, const char* str)
+{
+  if (!str)
+  {
+    vtkSelectionSerializerSave(buffer, vtkSelectionSerializerNullString);
+    return;
+  }
+  const size_t length = strlen(str);
+  vtkSelectionSerializerSave(buffer, static_cast<vtkTypeUInt32>(length));
+  buffer.append(str, length);
+}
+
+// Values are swapped to the native byte order when `swap` is true.
+template <class T>
+bool vtkSelectionSerializerLoad(const char*& data, const char* end, bool swap, T& value)
+{
+  if (end - data < static_cast<std::ptrdiff_t>(sizeof(value)))
+  {
+    return false;
+  }
+  memcpy(&value, data, sizeof(value));
+  data += sizeof(value);
+  if (swap && sizeof(value) > 1)
+  {
+    vtkByteSwap::SwapVoidRange(&value, 1, static_cast<int>(sizeof(value)));
+  }
+  return true;
+}
+
+bool vtkSelectionSerializerLoad(
+  const char*& data, const char* end, bool swap, std::string& str, bool& isNull)
+{
+  vtkTypeUInt32 length;
+  if (!vtkSelectionSerializerLoad(data, end, swap, length))
+  {
+    return false;
+  }
+  isNull = length == vtkSelectionSerializerNullString;
+  if (isNull)
+  {
+    str.clear();
+    return true;
+  }
+  if (end - data < static_cast<std::ptrdiff_t>(length))
+  {
+    return false;
+  }
+  str.assign(data, length);
+  data += length;
+  return true;
+}
+
+// Saves `values` as runs of consecutive values if that is smaller than the
+// values themselves. Returns false if nothing was saved.
+template <class T>
+bool vtkSelectionSerializerSaveRuns(std::string& buffer, const T* values, vtkIdType count)
+{
+  if (!std::numeric_limits<T>::is_integer || count == 0)
+  {
+    return false;
+  }
+  vtkTypeInt64 numRuns = 1;
+  for (vtkIdType cc = 1; cc < count; ++cc)
+  {
+    if (static_cast<vtkTypeInt64>(values[cc]) != static_cast<vtkTypeInt64>(values[cc - 1]) + 1)
+    {
+      ++numRuns;
+    }
+  }
+  if (numRuns * 2 * sizeof(vtkTypeInt64) >= count * sizeof(T))
+  {
+    return false;
+  }
+
+  vtkSelectionSerializerSave(buffer, static_cast<unsigned char>(1));
+  vtkSelectionSerializerSave(buffer, numRuns);
+  vtkIdType start = 0;
+  for (vtkIdType cc = 1; cc <= count; ++cc)
+  {
+    if (cc == count ||
+      static_cast<vtkTypeInt64>(values[cc]) != static_cast<vtkTypeInt64>(values[cc - 1]) + 1)
+    {
+      vtkSelectionSerializerSave(buffer, static_cast<vtkTypeInt64>(values[start]));
+      vtkSelectionSerializerSave(buffer, static_cast<vtkTypeInt64>(cc - start));
+      start = cc;
+    }
+  }
+  return true;
+}
+
+template <class T>
+bool vtkSelectionSerializerLoadRuns(
+  const char*& data, const char* end, bool swap, T* values, vtkIdType count)
+{
+  vtkTypeInt64 numRuns;
+  if (!vtkSelectionSerializerLoad(data, end, swap, numRuns))
+  {
+    return false;
+  }
+  vtkIdType pos = 0;
+  for (vtkTypeInt64 run = 0; run < numRuns; ++run)
+  {
+    vtkTypeInt64 start, length;
+    if (!vtkSelectionSerializerLoad(data, end, swap, start) ||
+      !vtkSelectionSerializerLoad(data, end, swap, length) || length < 0 || length > count - pos)
+    {
+      return false;
+    }
+    for (vtkTypeInt64 cc = 0; cc < length; ++cc)
+    {
+      values[pos++] = static_cast<T>(start + cc);
+    }
+  }
+  return pos == count;
+}
+
+void vtkSelectionSerializerSaveArray(std::string& buffer, vtkAbstractArray* array)
+{
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  vtkStringArray* stringArray = vtkStringArray::SafeDownCast(array);
+  const vtkIdType numTuples = array->GetNumberOfTuples();
+  const int numComps = array->GetNumberOfComponents();
+  const vtkIdType numValues = numTuples * numComps;
+
+  vtkSelectionSerializerSave(buffer, array->GetClassName());
+  vtkSelectionSerializerSave(buffer, array->GetName());
+  vtkSelectionSerializerSave(buffer, static_cast<vtkTypeInt64>(numTuples));
+  vtkSelectionSerializerSave(buffer, static_cast<vtkTypeInt32>(numComps));
+  if (dataArray)
+  {
+    void* dataPtr = numValues > 0 ? dataArray->GetVoidPointer(0) : nullptr;
+    bool saved = false;
+    if (numComps == 1)
+    {
+      switch (dataArray->GetDataType())
+      {
+        vtkTemplateMacro(saved = vtkSelectionSerializerSaveRuns(
+                           buffer, static_cast<VTK_TT*>(dataPtr), numValues));
+      }
+    }
+    if (!saved)
+    {
+      vtkSelectionSerializerSave(buffer, static_cast<unsigned char>(0));
+      if (numValues > 0)
+      {
+        buffer.append(static_cast<const char*>(dataPtr),
+          static_cast<size_t>(numValues * dataArray->GetDataTypeSize()));
+      }
+    }
+  }
+  else if (stringArray)
+  {
+    for (vtkIdType cc = 0; cc < numValues; ++cc)
+    {
+      vtkSelectionSerializerSave(buffer, stringArray->GetValue(cc).c_str());
+    }
+  }
+}
+
+vtkSmartPointer<vtkAbstractArray> vtkSelectionSerializerLoadArray(
+  const char*& data, const char* end, bool swap)
+{
+  std::string classname, name;
+  bool nullName, isNull;
+  vtkTypeInt64 numTuples;
+  vtkTypeInt32 numComps;
+  if (!vtkSelectionSerializerLoad(data, end, swap, classname, isNull) ||
+    !vtkSelectionSerializerLoad(data, end, swap, name, nullName) ||
+    !vtkSelectionSerializerLoad(data, end, swap, numTuples) ||
+    !vtkSelectionSerializerLoad(data, end, swap, numComps) || numTuples < 0 || numComps < 1)
+  {
+    return nullptr;
+  }
+
+  vtkSmartPointer<vtkObject> object;
+  object.TakeReference(vtkPVInstantiator::CreateInstance(classname.c_str()));
+  vtkSmartPointer<vtkAbstractArray> array = vtkAbstractArray::SafeDownCast(object);
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  vtkStringArray* stringArray = vtkStringArray::SafeDownCast(array);
+  if (!dataArray && !stringArray)
+  {
+    return nullptr;
+  }
+  const vtkIdType numValues = static_cast<vtkIdType>(numTuples) * numComps;
+  unsigned char encoding = 0;
+  if (dataArray)
+  {
+    if (!vtkSelectionSerializerLoad(data, end, swap, encoding) ||
+      (encoding == 0 && end - data < numValues * dataArray->GetDataTypeSize()))
+    {
+      return nullptr;
+    }
+  }
+  array->SetName(nullName ? nullptr : name.c_str());
+  array->SetNumberOfComponents(numComps);
+  array->SetNumberOfTuples(numTuples);
+
+  if (dataArray && numValues > 0)
+  {
+    void* dataPtr = dataArray->GetVoidPointer(0);
+    if (encoding == 0)
+    {
+      const size_t size = static_cast<size_t>(numValues * dataArray->GetDataTypeSize());
+      memcpy(dataPtr, data, size);
+      data += size;
+      if (swap && dataArray->GetDataTypeSize() > 1)
+      {
+        vtkByteSwap::SwapVoidRange(dataPtr, numValues, dataArray->GetDataTypeSize());
+      }
+    }
+    else
+    {
+      bool loaded = false;
+      switch (dataArray->GetDataType())
+      {
+        vtkTemplateMacro(loaded = vtkSelectionSerializerLoadRuns(
+                           data, end, swap, static_cast<VTK_TT*>(dataPtr), numValues));
+      }
+      if (!loaded)
+      {
+        return nullptr;
+      }
+    }
+  }
+  else if (stringArray)
+  {
+    std::string value;
+    for (vtkIdType cc = 0; cc < numValues; ++cc)
+    {
+      if (!vtkSelectionSerializerLoad(data, end, swap, value, isNull))
+      {
+        return nullptr;
+      }
+      stringArray->SetValue(cc, value);
+    }
+  }
+  return array;
+}
+}
+
+//----------------------------------------------------------------------------
+void vtkSelectionSerializer::SaveBinary(std::string& buffer, vtkSelection* selection)
+{
+  vtkSelectionSerializerSave(buffer, vtkSelectionSerializerByteOrder);
+  vtkSelectionSerializerSave(buffer, vtkSelectionSerializerMagic);
+  const unsigned int numNodes = selection ? selection->GetNumberOfNodes() : 0;
+  vtkSelectionSerializerSave(buffer, static_cast<vtkTypeUInt32>(numNodes));
+  for (unsigned int i = 0; i < numNodes; i++)
+  {
+    vtkSelectionNode* node = selection->GetNode(i);
+    vtkInformation* properties = node->GetProperties();
+
+    unsigned char numKeys = 0;
+    for (int cc = 0; cc < vtkSelectionSerializerNumberOfIntegerKeys; ++cc)
+    {
+      numKeys += properties->Has(vtkSelectionSerializerIntegerKey(cc)) ? 1 : 0;
+    }
+    vtkSelectionSerializerSave(buffer, numKeys);
+    for (int cc = 0; cc < vtkSelectionSerializerNumberOfIntegerKeys; ++cc)
+    {
+      vtkInformationIntegerKey* key = vtkSelectionSerializerIntegerKey(cc);
+      if (properties->Has(key))
+      {
+        vtkSelectionSerializerSave(buffer, static_cast<unsigned char>(cc));
+        vtkSelectionSerializerSave(buffer, static_cast<vtkTypeInt32>(properties->Get(key)));
+      }
+    }
+    const unsigned char hasEpsilon = properties->Has(vtkSelectionNode::EPSILON()) ? 1 : 0;
+    vtkSelectionSerializerSave(buffer, hasEpsilon);
+    if (hasEpsilon)
+    {
+      vtkSelectionSerializerSave(buffer, properties->Get(vtkSelectionNode::EPSILON()));
+    }
+
+    vtkDataSetAttributes* data = node->GetSelectionData();
+    vtkTypeUInt32 numArrays = 0;
+    for (int cc = 0; cc < data->GetNumberOfArrays(); ++cc)
+    {
+      vtkAbstractArray* array = data->GetAbstractArray(cc);
+      numArrays += (vtkDataArray::SafeDownCast(array) || vtkStringArray::SafeDownCast(array));
+    }
+    vtkSelectionSerializerSave(buffer, numArrays);
+    for (int cc = 0; cc < data->GetNumberOfArrays(); ++cc)
+    {
+      vtkAbstractArray* array = data->GetAbstractArray(cc);
+      if (vtkDataArray::SafeDownCast(array) || vtkStringArray::SafeDownCast(array))
+      {
+        vtkSelectionSerializerSaveArray(buffer, array);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkSelectionSerializer::LoadBinary(const char* data, size_t length, vtkSelection* root)
+{
+  root->Initialize();
+  const char* end = data + length;
+  unsigned char byteOrder;
+  if (!vtkSelectionSerializerLoad(data, end, false, byteOrder) ||
+    (byteOrder != vtkSelectionSerializerBigEndian &&
+      byteOrder != vtkSelectionSerializerLittleEndian))
+  {
+    return false;
+  }
+  const bool swap = byteOrder != vtkSelectionSerializerByteOrder;
+  vtkTypeUInt32 magic, numNodes;
+  if (!vtkSelectionSerializerLoad(data, end, swap, magic) || magic != vtkSelectionSerializerMagic ||
+    !vtkSelectionSerializerLoad(data, end, swap, numNodes))
+  {
+    return false;
+  }
+  for (vtkTypeUInt32 i = 0; i < numNodes; i++)
+  {
+    vtkNew<vtkSelectionNode> node;
+    vtkInformation* properties = node->GetProperties();
+
+    unsigned char numKeys;
+    if (!vtkSelectionSerializerLoad(data, end, swap, numKeys))
+    {
+      root->Initialize();
+      return false;
+    }
+    for (unsigned char cc = 0; cc < numKeys; ++cc)
+    {
+      unsigned char index;
+      vtkTypeInt32 value;
+      if (!vtkSelectionSerializerLoad(data, end, swap, index) ||
+        !vtkSelectionSerializerLoad(data, end, swap, value) ||
+        !vtkSelectionSerializerIntegerKey(index))
+      {
+        root->Initialize();
+        return false;
+      }
+      properties->Set(vtkSelectionSerializerIntegerKey(index), value);
+    }
+    unsigned char hasEpsilon;
+    if (!vtkSelectionSerializerLoad(data, end, swap, hasEpsilon))
+    {
+      root->Initialize();
+      return false;
+    }
+    if (hasEpsilon)
+    {
+      double epsilon;
+      if (!vtkSelectionSerializerLoad(data, end, swap, epsilon))
+      {
+        root->Initialize();
+        return false;
+      }
+      properties->Set(vtkSelectionNode::EPSILON(), epsilon);
+    }
+
+    vtkTypeUInt32 numArrays;
+    if (!vtkSelectionSerializerLoad(data, end, swap, numArrays))
+    {
+      root->Initialize();
+      return false;
+    }
+    for (vtkTypeUInt32 cc = 0; cc < numArrays; ++cc)
+    {
+      vtkSmartPointer<vtkAbstractArray> array = vtkSelectionSerializerLoadArray(data, end, swap);
+      if (!array)
+      {
+        root->Initialize();
+        return false;
+      }
+      node->GetSelectionData()->AddArray(array);
+    }
+    root->AddNode(node);
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkSelectionSerializer::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -20,6 +20,9 @@
  * serialize/deserialize vtkSelection to/from xml. Currently, it
  * supports only a subset of properties: CONTENT_TYPE, SOURCE_ID,
  * PROP_ID, PROCESS_ID, ORIGINAL_SOURCE_ID
+ *
+ * The xml form is meant for state files. Selections transferred between
+ * processes use the more compact binary form produced by SaveBinary().
  * @sa
  * vtkSelection
 */
@@ -30,6 +33,8 @@
 #include "vtkObject.h"
 #include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
 
+#include <string> // for std::string
+
 class vtkInformationIntegerKey;
 class vtkPVXMLElement;
 class vtkSelection;
@@ -63,6 +68,22 @@ public:
   static void Parse(const char* xml, unsigned int length, vtkSelection* root);
   //@}
 
+  //@{
+  /**
+   * Serialize the selection tree to a compact binary form appended to
+   * `buffer`, and create a selection tree from such a buffer. The binary form
+   * is only meant for transfers between processes running the same version:
+   * it supports the same properties as the xml form, and lists are stored in
+   * binary, with single component integral lists stored as runs of
+   * consecutive values when that is smaller (e.g. for ranges of ids).
+   * The byte order of the saving process is recorded, and values are swapped
+   * on load when it differs. LoadBinary() returns false if the buffer is not a
+   * valid selection.
+   */
+  static void SaveBinary(std::string& buffer, vtkSelection* selection);
+  static bool LoadBinary(const char* data, size_t length, vtkSelection* root);
+  //@}
+
   /**
    * ID of the dataset or algorithm that the selection belongs to. What
    * ID means is application specific.
@@ -0,0 +1,209 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestParallelSerialWriterAggregation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkParallelSerialWriter with an AggregationBufferSize writes
+// each batch it receives to its own partition file, and that the partition
+// files together hold the data of all processes.
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerInterpreterInitializer.h"
+#include "vtkClientServerStream.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkParallelSerialWriter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkSmartPointer.h"
+#include "vtkTesting.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+// Large enough for each piece to fill a batch on its own with an
+// AggregationBufferSize of 1 MiB.
+const vtkIdType NumberOfPoints = 100000;
+
+// Process `rank` has NumberOfPoints vertices, all tagged with its rank.
+vtkSmartPointer<vtkPolyData> MakePiece(int rank)
+{
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(NumberOfPoints);
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkIntArray> ranks;
+  ranks->SetName("rank");
+  ranks->SetNumberOfTuples(NumberOfPoints);
+  for (vtkIdType cc = 0; cc < NumberOfPoints; ++cc)
+  {
+    points->SetPoint(cc, rank, static_cast<double>(cc), 0);
+    verts->InsertNextCell(1, &cc);
+    ranks->SetValue(cc, rank);
+  }
+  auto polydata = vtkSmartPointer<vtkPolyData>::New();
+  polydata->SetPoints(points);
+  polydata->SetVerts(verts);
+  polydata->GetPointData()->AddArray(ranks);
+  return polydata;
+}
+
+// vtkParallelSerialWriter drives its writer through the client-server
+// interpreter. This handles the two methods it calls on vtkPolyDataWriter.
+int TestParallelSerialWriterAggregationCommand(vtkClientServerInterpreter*, vtkObjectBase* ptr,
+  const char* method, const vtkClientServerStream& msg, vtkClientServerStream&, void*)
+{
+  auto writer = vtkPolyDataWriter::SafeDownCast(ptr);
+  if (!writer)
+  {
+    return 0;
+  }
+  if (strcmp(method, "SetFileName") == 0)
+  {
+    char* fname = nullptr;
+    if (!msg.GetArgument(0, 2, &fname))
+    {
+      return 0;
+    }
+    writer->SetFileName(fname);
+    return 1;
+  }
+  if (strcmp(method, "Write") == 0)
+  {
+    writer->Write();
+    return 1;
+  }
+  return 0;
+}
+
+bool CheckPartitions(const std::string& dir, int numRanks)
+{
+  if (vtksys::SystemTools::FileExists(dir + "/out.vtk"))
+  {
+    vtkLogF(ERROR, "data was written to a single file.");
+    return false;
+  }
+
+  vtkIdType numPoints = 0;
+  for (int partition = 0; partition < numRanks; ++partition)
+  {
+    const std::string fname = dir + "/out-" + std::to_string(partition) + ".vtk";
+    if (!vtksys::SystemTools::FileExists(fname))
+    {
+      vtkLogF(ERROR, "missing partition file '%s'.", fname.c_str());
+      return false;
+    }
+
+    vtkNew<vtkPolyDataReader> reader;
+    reader->SetFileName(fname.c_str());
+    reader->Update();
+    vtkPolyData* output = reader->GetOutput();
+    auto ranks = vtkIntArray::SafeDownCast(output->GetPointData()->GetArray("rank"));
+    if (!ranks || output->GetNumberOfPoints() != NumberOfPoints ||
+      output->GetNumberOfVerts() != NumberOfPoints)
+    {
+      vtkLogF(ERROR, "partition file '%s' does not hold a single piece.", fname.c_str());
+      return false;
+    }
+    // batches are received in rank order.
+    if (ranks->GetValue(0) != partition || ranks->GetValue(NumberOfPoints - 1) != partition)
+    {
+      vtkLogF(ERROR, "partition file '%s' holds the wrong piece.", fname.c_str());
+      return false;
+    }
+    numPoints += output->GetNumberOfPoints();
+  }
+
+  if (vtksys::SystemTools::FileExists(dir + "/out-" + std::to_string(numRanks) + ".vtk"))
+  {
+    vtkLogF(ERROR, "unexpected partition file.");
+    return false;
+  }
+  if (numPoints != NumberOfPoints * numRanks)
+  {
+    vtkLogF(ERROR, "expected %d points in total, got %d.",
+      static_cast<int>(NumberOfPoints * numRanks), static_cast<int>(numPoints));
+    return false;
+  }
+  return true;
+}
+}
+
+int TestParallelSerialWriterAggregation(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  const int rank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  if (!testing->GetTempDirectory())
+  {
+    vtkLogF(ERROR, "no temp directory specified!");
+    vtkMultiProcessController::SetGlobalController(nullptr);
+    controller->Finalize();
+    return EXIT_FAILURE;
+  }
+  const std::string dir = testing->GetTempDirectory();
+  if (rank == 0)
+  {
+    vtksys::SystemTools::RemoveFile(dir + "/out.vtk");
+    for (int partition = 0; partition <= numRanks; ++partition)
+    {
+      vtksys::SystemTools::RemoveFile(dir + "/out-" + std::to_string(partition) + ".vtk");
+    }
+  }
+  controller->Barrier();
+
+  vtkClientServerInterpreter* interp =
+    vtkClientServerInterpreterInitializer::GetGlobalInterpreter();
+  if (!interp->HasCommandFunction("vtkPolyDataWriter"))
+  {
+    interp->AddCommandFunction("vtkPolyDataWriter", TestParallelSerialWriterAggregationCommand);
+  }
+
+  vtkNew<vtkPolyDataWriter> polyWriter;
+  polyWriter->SetFileTypeToBinary();
+  vtkNew<vtkAppendPolyData> append;
+
+  vtkNew<vtkParallelSerialWriter> writer;
+  writer->SetController(controller);
+  writer->SetWriter(polyWriter);
+  writer->SetPostGatherHelper(append);
+  writer->SetFileNameMethod("SetFileName");
+  writer->SetAggregationBufferSize(1);
+  writer->SetFileName((dir + "/out.vtk").c_str());
+  writer->SetInputDataObject(MakePiece(rank));
+  writer->Write();
+  controller->Barrier();
+
+  int success = rank == 0 ? CheckPartitions(dir, numRanks) : 1;
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
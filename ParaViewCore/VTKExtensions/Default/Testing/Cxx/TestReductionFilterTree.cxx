@@ -0,0 +1,214 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestReductionFilterTree.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkReductionFilter gives the same results with TreeReduction on
+// and off, for the append and histogram helpers, when reducing to a process
+// other than 0 and with REDUCE_ALL_TO_ALL. Meant to run on a number of
+// processes that is not a power of two, so that the tree is not complete.
+#include "vtkAppendPolyData.h"
+#include "vtkAttributeDataReductionFilter.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkReductionFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+#include <cstdlib>
+
+namespace
+{
+const int NumberOfBins = 5;
+
+// Process `rank` has rank + 1 points, all tagged with its rank.
+vtkSmartPointer<vtkDataObject> MakePoints(int rank)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIntArray> ranks;
+  ranks->SetName("rank");
+  for (int cc = 0; cc <= rank; ++cc)
+  {
+    points->InsertNextPoint(rank, cc, 0);
+    ranks->InsertNextValue(rank);
+  }
+  auto polydata = vtkSmartPointer<vtkPolyData>::New();
+  polydata->SetPoints(points);
+  polydata->GetPointData()->AddArray(ranks);
+  return polydata;
+}
+
+// The local histogram of process `rank`.
+vtkSmartPointer<vtkDataObject> MakeHistogram(int rank)
+{
+  vtkNew<vtkIntArray> values;
+  values->SetName("bin_values");
+  for (int cc = 0; cc < NumberOfBins; ++cc)
+  {
+    values->InsertNextValue(rank * 10 + cc);
+  }
+  auto table = vtkSmartPointer<vtkTable>::New();
+  table->AddColumn(values);
+  return table;
+}
+
+vtkSmartPointer<vtkAlgorithm> MakeHelper(bool histogram)
+{
+  if (histogram)
+  {
+    auto helper = vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
+    helper->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
+    helper->SetReductionType(vtkAttributeDataReductionFilter::ADD);
+    return helper;
+  }
+  return vtkSmartPointer<vtkAppendPolyData>::New();
+}
+
+vtkSmartPointer<vtkDataObject> Reduce(vtkMultiProcessController* controller, bool histogram,
+  int mode, int reductionProcessId, bool tree)
+{
+  const int rank = controller->GetLocalProcessId();
+  vtkNew<vtkReductionFilter> reduction;
+  reduction->SetController(controller);
+  reduction->SetPostGatherHelper(MakeHelper(histogram));
+  reduction->SetReductionMode(mode);
+  reduction->SetReductionProcessId(reductionProcessId);
+  reduction->SetTreeReduction(tree);
+  reduction->SetInputDataObject(histogram ? MakeHistogram(rank) : MakePoints(rank));
+  reduction->Update();
+  return reduction->GetOutputDataObject(0);
+}
+
+vtkIntArray* GetValues(vtkDataObject* data)
+{
+  if (auto table = vtkTable::SafeDownCast(data))
+  {
+    return vtkIntArray::SafeDownCast(table->GetColumnByName("bin_values"));
+  }
+  if (auto polydata = vtkPolyData::SafeDownCast(data))
+  {
+    return vtkIntArray::SafeDownCast(polydata->GetPointData()->GetArray("rank"));
+  }
+  return nullptr;
+}
+
+// Checks the result holds the data of all processes, in process order.
+bool CheckReduced(vtkIntArray* values, bool histogram, int numRanks)
+{
+  if (histogram)
+  {
+    if (values->GetNumberOfTuples() != NumberOfBins)
+    {
+      return false;
+    }
+    for (int cc = 0; cc < NumberOfBins; ++cc)
+    {
+      // sum of rank * 10 + cc over all ranks.
+      if (values->GetValue(cc) != 5 * numRanks * (numRanks - 1) + cc * numRanks)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  vtkIdType index = 0;
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    for (int cc = 0; cc <= rank; ++cc, ++index)
+    {
+      if (index >= values->GetNumberOfTuples() || values->GetValue(index) != rank)
+      {
+        return false;
+      }
+    }
+  }
+  return index == values->GetNumberOfTuples();
+}
+
+bool Check(vtkMultiProcessController* controller, bool histogram, int mode, int reductionProcessId)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+  const char* name = histogram ? "histogram" : "append";
+
+  vtkSmartPointer<vtkDataObject> flat =
+    Reduce(controller, histogram, mode, reductionProcessId, false);
+  vtkSmartPointer<vtkDataObject> tree =
+    Reduce(controller, histogram, mode, reductionProcessId, true);
+  vtkIntArray* flatValues = GetValues(flat);
+  vtkIntArray* treeValues = GetValues(tree);
+  if (!flatValues || !treeValues)
+  {
+    vtkLogF(ERROR, "%s, mode %d: missing output on rank %d", name, mode, rank);
+    return false;
+  }
+
+  if (flatValues->GetNumberOfTuples() != treeValues->GetNumberOfTuples())
+  {
+    vtkLogF(ERROR, "%s, mode %d: %d values with the tree, %d without on rank %d", name, mode,
+      static_cast<int>(treeValues->GetNumberOfTuples()),
+      static_cast<int>(flatValues->GetNumberOfTuples()), rank);
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < flatValues->GetNumberOfTuples(); ++cc)
+  {
+    if (flatValues->GetValue(cc) != treeValues->GetValue(cc))
+    {
+      vtkLogF(ERROR, "%s, mode %d: value %d differs on rank %d", name, mode, static_cast<int>(cc),
+        rank);
+      return false;
+    }
+  }
+
+  const bool reduced = mode == vtkReductionFilter::REDUCE_ALL_TO_ALL || rank == reductionProcessId;
+  if (reduced && !CheckReduced(treeValues, histogram, numRanks))
+  {
+    vtkLogF(ERROR, "%s, mode %d: wrong reduced values on rank %d", name, mode, rank);
+    return false;
+  }
+  return true;
+}
+}
+
+int TestReductionFilterTree(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  const int numRanks = controller->GetNumberOfProcesses();
+  // reduce to the last process, so that the result has to be moved from the
+  // root of the tree.
+  const int reductionProcessId = numRanks - 1;
+
+  int success = 1;
+  for (int histogram = 0; histogram < 2; ++histogram)
+  {
+    success &= Check(
+      controller, histogram != 0, vtkReductionFilter::REDUCE_ALL_TO_ONE, reductionProcessId);
+    success &= Check(
+      controller, histogram != 0, vtkReductionFilter::REDUCE_ALL_TO_ALL, reductionProcessId);
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSelectionSerializer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkSelectionSerializer.h"
+#include "vtkStringArray.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#define TEST_ASSERT(cond)                                                                          \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: " #cond " failed at line " << __LINE__ << endl;                                \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Appends `value` in the byte order opposite to the native one.
+template <class T>
+void SaveSwapped(std::string& buffer, T value)
+{
+  std::string bytes(reinterpret_cast<const char*>(&value), sizeof(value));
+  std::reverse(bytes.begin(), bytes.end());
+  buffer += bytes;
+}
+}
+
+int TestSelectionSerializer(int, char* [])
+{
+  vtkNew<vtkSelection> selection;
+
+  // two ranges of ids, stored as runs.
+  vtkNew<vtkSelectionNode> idNode;
+  idNode->SetContentType(vtkSelectionNode::INDICES);
+  idNode->SetFieldType(vtkSelectionNode::CELL);
+  idNode->GetProperties()->Set(vtkSelectionNode::PROCESS_ID(), 3);
+  idNode->GetProperties()->Set(vtkSelectionNode::EPSILON(), 0.25);
+  vtkNew<vtkIdTypeArray> ids;
+  for (vtkIdType cc = 0; cc < 100000; ++cc)
+  {
+    ids->InsertNextValue(cc < 50000 ? cc + 10 : cc + 100);
+  }
+  idNode->SetSelectionList(ids);
+  selection->AddNode(idNode);
+
+  vtkNew<vtkSelectionNode> valueNode;
+  valueNode->SetContentType(vtkSelectionNode::VALUES);
+  vtkNew<vtkStringArray> values;
+  values->SetName("names");
+  values->InsertNextValue("first");
+  values->InsertNextValue("");
+  values->InsertNextValue("third");
+  valueNode->SetSelectionList(values);
+  selection->AddNode(valueNode);
+
+  std::string buffer;
+  vtkSelectionSerializer::SaveBinary(buffer, selection);
+  TEST_ASSERT(buffer.size() < ids->GetDataSize() * sizeof(vtkIdType));
+
+  vtkNew<vtkSelection> result;
+  TEST_ASSERT(vtkSelectionSerializer::LoadBinary(buffer.c_str(), buffer.size(), result));
+  TEST_ASSERT(result->GetNumberOfNodes() == 2);
+
+  vtkSelectionNode* node = result->GetNode(0);
+  TEST_ASSERT(node->GetContentType() == vtkSelectionNode::INDICES);
+  TEST_ASSERT(node->GetFieldType() == vtkSelectionNode::CELL);
+  TEST_ASSERT(node->GetProperties()->Get(vtkSelectionNode::PROCESS_ID()) == 3);
+  TEST_ASSERT(node->GetProperties()->Get(vtkSelectionNode::EPSILON()) == 0.25);
+  vtkIdTypeArray* resultIds = vtkIdTypeArray::SafeDownCast(node->GetSelectionList());
+  TEST_ASSERT(resultIds && resultIds->GetNumberOfTuples() == ids->GetNumberOfTuples());
+  for (vtkIdType cc = 0; cc < ids->GetNumberOfTuples(); ++cc)
+  {
+    TEST_ASSERT(resultIds->GetValue(cc) == ids->GetValue(cc));
+  }
+
+  node = result->GetNode(1);
+  vtkStringArray* resultValues = vtkStringArray::SafeDownCast(node->GetSelectionList());
+  TEST_ASSERT(resultValues && resultValues->GetNumberOfTuples() == 3);
+  TEST_ASSERT(std::string(resultValues->GetName()) == "names");
+  TEST_ASSERT(resultValues->GetValue(0) == "first" && resultValues->GetValue(1).empty());
+  TEST_ASSERT(resultValues->GetValue(2) == "third");
+
+  // truncated buffers are rejected.
+  TEST_ASSERT(!vtkSelectionSerializer::LoadBinary(buffer.c_str(), buffer.size() - 1, result));
+  TEST_ASSERT(result->GetNumberOfNodes() == 0);
+
+  // buffers saved with the other byte order are swapped on load. The first
+  // byte of a buffer is its byte order.
+  const unsigned char nativeOrder = static_cast<unsigned char>(buffer[0]);
+  std::string swapped(1, static_cast<char>(nativeOrder == 1 ? 0 : 1));
+  SaveSwapped<vtkTypeUInt32>(swapped, 0x42535650);
+  SaveSwapped<vtkTypeUInt32>(swapped, 1); // nodes
+  swapped += '\1';                        // integer keys
+  swapped += '\0';                        // CONTENT_TYPE
+  SaveSwapped<vtkTypeInt32>(swapped, vtkSelectionNode::INDICES);
+  swapped += '\1'; // epsilon
+  SaveSwapped<double>(swapped, 0.5);
+  SaveSwapped<vtkTypeUInt32>(swapped, 1); // arrays
+  const std::string classname = "vtkIntArray";
+  SaveSwapped<vtkTypeUInt32>(swapped, static_cast<vtkTypeUInt32>(classname.size()));
+  swapped += classname;
+  SaveSwapped<vtkTypeUInt32>(swapped, 0xffffffff); // no name
+  SaveSwapped<vtkTypeInt64>(swapped, 3);           // tuples
+  SaveSwapped<vtkTypeInt32>(swapped, 1);           // components
+  swapped += '\0';                                 // values are not runs
+  const int swappedValues[3] = { 7, -2, 0x01020304 };
+  for (int value : swappedValues)
+  {
+    SaveSwapped<vtkTypeInt32>(swapped, value);
+  }
+  TEST_ASSERT(vtkSelectionSerializer::LoadBinary(swapped.c_str(), swapped.size(), result));
+  TEST_ASSERT(result->GetNumberOfNodes() == 1);
+  node = result->GetNode(0);
+  TEST_ASSERT(node->GetContentType() == vtkSelectionNode::INDICES);
+  TEST_ASSERT(node->GetProperties()->Get(vtkSelectionNode::EPSILON()) == 0.5);
+  vtkIntArray* resultInts = vtkIntArray::SafeDownCast(node->GetSelectionList());
+  TEST_ASSERT(resultInts && resultInts->GetNumberOfTuples() == 3);
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    TEST_ASSERT(resultInts->GetValue(cc) == swappedValues[cc]);
+  }
+
+  // unknown byte orders are rejected.
+  swapped[0] = '\7';
+  TEST_ASSERT(!vtkSelectionSerializer::LoadBinary(swapped.c_str(), swapped.size(), result));
+  return EXIT_SUCCESS;
+}
@@ -22,18 +22,29 @@
 #include "vtkErrorCode.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVMergeTables.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
 #include "vtkTable.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
 #include <numeric>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 vtkStandardNewMacro(vtkCSVWriter);
@@ -49,6 +60,8 @@ vtkCSVWriter::vtkCSVWriter()
   this->FileName = 0;
   this->Precision = 5;
   this->UseScientificNotation = true;
+  this->UseShortestRoundTrip = false;
+  this->WriteInParallel = false;
   this->FieldAssociation = 0;
   this->AddMetaData = false;
   this->AddTime = false;
@@ -97,7 +110,7 @@ namespace
 //-----------------------------------------------------------------------------
 template <class iterT>
 void vtkCSVWriterGetDataString(
-  iterT* iter, vtkIdType tupleIndex, ofstream& stream, vtkCSVWriter* writer, bool* first)
+  iterT* iter, vtkIdType tupleIndex, std::ostream& stream, vtkCSVWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex * numComps;
@@ -118,7 +131,7 @@ void vtkCSVWriterGetDataString(
 //-----------------------------------------------------------------------------
 template <>
 void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<vtkStdString>* iter, vtkIdType tupleIndex,
-  ofstream& stream, vtkCSVWriter* writer, bool* first)
+  std::ostream& stream, vtkCSVWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex * numComps;
@@ -139,7 +152,7 @@ void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<vtkStdString>* iter, vtk
 //-----------------------------------------------------------------------------
 template <>
 void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<char>* iter, vtkIdType tupleIndex,
-  ofstream& stream, vtkCSVWriter* writer, bool* first)
+  std::ostream& stream, vtkCSVWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex * numComps;
@@ -160,7 +173,7 @@ void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<char>* iter, vtkIdType t
 //-----------------------------------------------------------------------------
 template <>
 void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<unsigned char>* iter, vtkIdType tupleIndex,
-  ofstream& stream, vtkCSVWriter* writer, bool* first)
+  std::ostream& stream, vtkCSVWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex * numComps;
@@ -186,6 +199,255 @@ void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<unsigned char>* iter, vt
   }
 }
 
+//-----------------------------------------------------------------------------
+// Formats values directly into a character buffer. This avoids the per-value
+// overhead of formatted stream insertion, which dominates when writing large
+// tables.
+class vtkCSVFormatter
+{
+public:
+  std::string Buffer;
+
+  vtkCSVFormatter(vtkCSVWriter* self)
+    : FieldDelimiter(self->GetFieldDelimiter() ? self->GetFieldDelimiter() : "")
+    , StringDelimiter(self->GetUseStringDelimiter() && self->GetStringDelimiter()
+          ? self->GetStringDelimiter()
+          : "")
+    , Precision(self->GetPrecision())
+    , UseScientificNotation(self->GetUseScientificNotation())
+    , UseShortestRoundTrip(self->GetUseShortestRoundTrip())
+  {
+  }
+
+  void Delimiter() { this->Buffer += this->FieldDelimiter; }
+
+  void Text(const std::string& value) { this->Buffer += value; }
+
+  void String(const std::string& value)
+  {
+    this->Buffer += this->StringDelimiter;
+    this->Buffer += value;
+    this->Buffer += this->StringDelimiter;
+  }
+
+  void Integer(unsigned long long value)
+  {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* cur = end;
+    do
+    {
+      *--cur = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value != 0);
+    this->Buffer.append(cur, end);
+  }
+
+  void Integer(long long value)
+  {
+    if (value < 0)
+    {
+      this->Buffer += '-';
+      this->Integer(0ull - static_cast<unsigned long long>(value));
+    }
+    else
+    {
+      this->Integer(static_cast<unsigned long long>(value));
+    }
+  }
+
+  void Real(double value, bool singlePrecision)
+  {
+    char digits[512];
+    int length;
+    if (this->UseShortestRoundTrip && vtkMath::IsFinite(value))
+    {
+      // every value with at most 6 (float) or 15 (double) significant digits
+      // is printed exactly by "%g" at that precision, so only longer values
+      // need more attempts.
+      const int maxPrecision = singlePrecision ? 9 : 17;
+      for (int precision = singlePrecision ? 6 : 15;; ++precision)
+      {
+        length = snprintf(digits, sizeof(digits), "%.*g", precision, value);
+        if (precision == maxPrecision ||
+          (singlePrecision ? static_cast<double>(strtof(digits, nullptr)) == value
+                           : strtod(digits, nullptr) == value))
+        {
+          break;
+        }
+      }
+    }
+    else
+    {
+      const char* format = this->UseScientificNotation ? "%.*e" : "%.*g";
+      length = snprintf(digits, sizeof(digits), format, this->Precision, value);
+    }
+    length = std::min(std::max(length, 0), static_cast<int>(sizeof(digits)) - 1);
+    this->Buffer.append(digits, length);
+  }
+
+private:
+  std::string FieldDelimiter;
+  std::string StringDelimiter;
+  int Precision;
+  bool UseScientificNotation;
+  bool UseShortestRoundTrip;
+};
+
+//-----------------------------------------------------------------------------
+template <typename ValueType>
+void vtkCSVFormatValue(vtkCSVFormatter& formatter, ValueType value)
+{
+  if (std::is_signed<ValueType>::value)
+  {
+    formatter.Integer(static_cast<long long>(value));
+  }
+  else
+  {
+    formatter.Integer(static_cast<unsigned long long>(value));
+  }
+}
+
+void vtkCSVFormatValue(vtkCSVFormatter& formatter, float value)
+{
+  formatter.Real(value, true);
+}
+
+void vtkCSVFormatValue(vtkCSVFormatter& formatter, double value)
+{
+  formatter.Real(value, false);
+}
+
+//-----------------------------------------------------------------------------
+// A column to write. Append() is called concurrently for different rows.
+class vtkCSVColumn
+{
+public:
+  virtual ~vtkCSVColumn() {}
+  virtual void Append(vtkIdType row, vtkCSVFormatter& formatter, bool* first) = 0;
+};
+
+//-----------------------------------------------------------------------------
+// Numeric columns with contiguous storage are read straight from memory.
+template <typename ValueType>
+class vtkCSVTypedColumn : public vtkCSVColumn
+{
+  const ValueType* Values;
+  vtkIdType NumberOfValues;
+  int NumberOfComponents;
+
+public:
+  vtkCSVTypedColumn(vtkDataArray* array)
+    : Values(static_cast<const ValueType*>(array->GetVoidPointer(0)))
+    , NumberOfValues(array->GetNumberOfValues())
+    , NumberOfComponents(array->GetNumberOfComponents())
+  {
+  }
+
+  void Append(vtkIdType row, vtkCSVFormatter& formatter, bool* first) override
+  {
+    const vtkIdType index = row * this->NumberOfComponents;
+    for (int cc = 0; cc < this->NumberOfComponents; ++cc)
+    {
+      if (!(*first))
+      {
+        formatter.Delimiter();
+      }
+      *first = false;
+      if ((index + cc) < this->NumberOfValues)
+      {
+        vtkCSVFormatValue(formatter, this->Values[index + cc]);
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+class vtkCSVStringColumn : public vtkCSVColumn
+{
+  vtkStringArray* Array;
+
+public:
+  vtkCSVStringColumn(vtkStringArray* array)
+    : Array(array)
+  {
+  }
+
+  void Append(vtkIdType row, vtkCSVFormatter& formatter, bool* first) override
+  {
+    const int numComps = this->Array->GetNumberOfComponents();
+    const vtkIdType index = row * numComps;
+    for (int cc = 0; cc < numComps; ++cc)
+    {
+      if (!(*first))
+      {
+        formatter.Delimiter();
+      }
+      *first = false;
+      if ((index + cc) < this->Array->GetNumberOfValues())
+      {
+        formatter.String(this->Array->GetValue(index + cc));
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Any other array (non-contiguous storage, variants, etc.) goes through the
+// array iterators and stream formatting.
+class vtkCSVGenericColumn : public vtkCSVColumn
+{
+  vtkSmartPointer<vtkArrayIterator> Iterator;
+  vtkCSVWriter* Writer;
+
+public:
+  vtkCSVGenericColumn(vtkAbstractArray* array, vtkCSVWriter* writer)
+    : Writer(writer)
+  {
+    this->Iterator.TakeReference(array->NewIterator());
+  }
+
+  void Append(vtkIdType row, vtkCSVFormatter& formatter, bool* first) override
+  {
+    std::ostringstream stream;
+    if (this->Writer->GetUseScientificNotation())
+    {
+      stream << std::scientific;
+    }
+    stream << std::setprecision(this->Writer->GetPrecision());
+    switch (this->Iterator->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(vtkCSVWriterGetDataString(
+        static_cast<VTK_TT*>(this->Iterator.GetPointer()), row, stream, this->Writer, first));
+    }
+    formatter.Text(stream.str());
+  }
+};
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<vtkCSVColumn> vtkCSVNewColumn(vtkAbstractArray* array, vtkCSVWriter* writer)
+{
+  // signed char is written as a character by the generic column.
+  auto darray = vtkDataArray::FastDownCast(array);
+  if (darray && darray->HasStandardMemoryLayout() && darray->GetDataType() != VTK_SIGNED_CHAR)
+  {
+    switch (darray->GetDataType())
+    {
+      vtkTemplateMacro(return std::unique_ptr<vtkCSVColumn>(new vtkCSVTypedColumn<VTK_TT>(darray)));
+    }
+  }
+  if (auto sarray = vtkStringArray::SafeDownCast(array))
+  {
+    return std::unique_ptr<vtkCSVColumn>(new vtkCSVStringColumn(sarray));
+  }
+  return std::unique_ptr<vtkCSVColumn>(new vtkCSVGenericColumn(array, writer));
+}
+
+// Rows formatted by a single task, and the number of such chunks formatted
+// before they are written out.
+constexpr vtkIdType vtkCSVRowsPerChunk = 16384;
+constexpr vtkIdType vtkCSVChunksPerBatch = 64;
+
 } // end anonymous namespace
 
 class vtkCSVWriter::CSVFile
@@ -222,13 +484,24 @@ public:
 
   void WriteHeader(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
   {
+    const std::string header = this->FormatHeader(dsa, self);
+    this->Stream.write(header.c_str(), header.size());
+  }
+
+  /**
+   * Records the columns to write, in order, and returns the header line.
+   */
+  std::string FormatHeader(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
+  {
+    std::ostringstream stream;
     bool add_delimiter = false;
     if (!vtkMath::IsNan(this->Time))
     {
       // add a time column.
-      this->Stream << "Time";
+      stream << "Time";
       add_delimiter = true;
     }
+    this->ColumnInfo.clear();
     for (int cc = 0, numArrays = dsa->GetNumberOfArrays(); cc < numArrays; ++cc)
     {
       auto array = dsa->GetAbstractArray(cc);
@@ -242,7 +515,7 @@ public:
         if (add_delimiter)
         {
           // add separator for all but the very first column
-          this->Stream << self->GetFieldDelimiter();
+          stream << self->GetFieldDelimiter();
         }
         add_delimiter = true;
 
@@ -252,18 +525,11 @@ public:
         {
           array_name << ":" << comp;
         }
-        this->Stream << self->GetString(array_name.str());
+        stream << self->GetString(array_name.str());
       }
     }
-    this->Stream << "\n";
-
-    // push the floating point precision/notation type.
-    if (self->GetUseScientificNotation())
-    {
-      this->Stream << std::scientific;
-    }
-
-    this->Stream << std::setprecision(self->GetPrecision());
+    stream << "\n";
+    return stream.str();
   }
 
   void WriteData(vtkTable* table, vtkCSVWriter* self)
@@ -273,42 +539,81 @@ public:
 
   void WriteData(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
   {
-    std::vector<vtkSmartPointer<vtkArrayIterator> > columnsIters;
-    for (const auto& cinfo : this->ColumnInfo)
+    // format a batch of rows at a time to bound the memory used.
+    const vtkIdType num_tuples = dsa->GetNumberOfTuples();
+    const vtkIdType batch = vtkCSVRowsPerChunk * vtkCSVChunksPerBatch;
+    std::vector<std::string> chunks;
+    for (vtkIdType begin = 0; begin < num_tuples; begin += batch)
     {
-      auto array = dsa->GetAbstractArray(cinfo.first.c_str());
-      if (array->GetNumberOfComponents() != cinfo.second)
+      this->FormatData(dsa, self, begin, std::min(begin + batch, num_tuples), chunks);
+      for (const auto& chunk : chunks)
       {
-        vtkErrorWithObjectMacro(self, "Mismatched components for '" << array->GetName() << "'!");
+        this->Stream.write(chunk.c_str(), chunk.size());
       }
-      vtkArrayIterator* iter = array->NewIterator();
-      columnsIters.push_back(iter);
-      iter->FastDelete();
     }
+  }
 
-    const auto num_tuples = dsa->GetNumberOfTuples();
-    for (vtkIdType cc = 0; cc < num_tuples; ++cc)
+  /**
+   * Formats rows [begin, end) of the columns recorded by FormatHeader(). The
+   * rows are split in chunks formatted concurrently, returned in row order.
+   */
+  void FormatData(vtkDataSetAttributes* dsa, vtkCSVWriter* self, vtkIdType begin, vtkIdType end,
+    std::vector<std::string>& chunks)
+  {
+    std::vector<std::unique_ptr<vtkCSVColumn> > columns;
+    for (const auto& cinfo : this->ColumnInfo)
     {
-      bool first_column = true;
-      if (!vtkMath::IsNan(this->Time))
+      auto array = dsa->GetAbstractArray(cinfo.first.c_str());
+      if (array->GetNumberOfComponents() != cinfo.second)
       {
-        // add a time column.
-        this->Stream << this->Time;
-        first_column = false;
+        vtkErrorWithObjectMacro(self, "Mismatched components for '" << array->GetName() << "'!");
       }
+      columns.push_back(vtkCSVNewColumn(array, self));
+    }
 
-      for (auto& iter : columnsIters)
+    const vtkIdType num_chunks = (end - begin + vtkCSVRowsPerChunk - 1) / vtkCSVRowsPerChunk;
+    chunks.clear();
+    chunks.resize(static_cast<size_t>(num_chunks));
+    const double time = this->Time;
+    vtkSMPTools::For(0, num_chunks, 1, [&](vtkIdType first_chunk, vtkIdType last_chunk) {
+      vtkCSVFormatter formatter(self);
+      for (vtkIdType chunk = first_chunk; chunk < last_chunk; ++chunk)
       {
-        switch (iter->GetDataType())
+        const vtkIdType first_row = begin + chunk * vtkCSVRowsPerChunk;
+        const vtkIdType last_row = std::min(first_row + vtkCSVRowsPerChunk, end);
+        formatter.Buffer.clear();
+        formatter.Buffer.reserve(static_cast<size_t>(last_row - first_row) * 16 * columns.size());
+        for (vtkIdType cc = first_row; cc < last_row; ++cc)
         {
-          vtkArrayIteratorTemplateMacro(vtkCSVWriterGetDataString(
-            static_cast<VTK_TT*>(iter.GetPointer()), cc, this->Stream, self, &first_column));
+          bool first_column = true;
+          if (!vtkMath::IsNan(time))
+          {
+            // add a time column.
+            formatter.Real(time, false);
+            first_column = false;
+          }
+          for (auto& column : columns)
+          {
+            column->Append(cc, formatter, &first_column);
+          }
+          formatter.Buffer += '\n';
         }
+        chunks[chunk].swap(formatter.Buffer);
       }
-      this->Stream << "\n";
-    }
+    });
   }
 
+  //@{
+  /**
+   * Get/Set the columns to write, as (array name, number of components) pairs.
+   */
+  const std::vector<std::pair<std::string, int> >& GetColumns() const { return this->ColumnInfo; }
+  void SetColumns(const std::vector<std::pair<std::string, int> >& columns)
+  {
+    this->ColumnInfo = columns;
+  }
+  //@}
+
 private:
   CSVFile(const CSVFile&) = delete;
   void operator=(const CSVFile&) = delete;
@@ -371,6 +676,12 @@ void vtkCSVWriter::WriteData()
     return;
   }
 
+  if (this->WriteInParallel)
+  {
+    this->WriteDataInParallel(table, time);
+    return;
+  }
+
   const int myRank = controller->GetLocalProcessId();
   const int numRanks = controller->GetNumberOfProcesses();
   if (myRank > 0)
@@ -477,6 +788,128 @@ void vtkCSVWriter::WriteData()
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkCSVWriter::WriteDataInParallel(vtkTable* table, double time)
+{
+  auto controller = this->Controller;
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  const vtkIdType row_count = table->GetNumberOfRows();
+  std::vector<vtkIdType> global_row_counts(numRanks, 0);
+  controller->AllGather(&row_count, &global_row_counts[0], 1);
+
+  // the root determines which columns to write, same as when it writes all
+  // the rows, creates the file with the header and shares the columns and the
+  // header size with all ranks.
+  vtkCSVWriter::CSVFile file(time);
+  vtkMultiProcessStream stream;
+  if (myRank > 0)
+  {
+    if (row_count > 0)
+    {
+      vtkNew<vtkTable> clone;
+      auto cloneRD = clone->GetRowData();
+      cloneRD->CopyAllOn();
+      cloneRD->CopyAllocate(table->GetRowData(), /*sze=*/1);
+      cloneRD->CopyData(table->GetRowData(), 0, 1, 0);
+      controller->Send(clone, 0, 88020);
+    }
+  }
+  else
+  {
+    vtkDataSetAttributes::FieldList columns;
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+      if (global_row_counts[rank] > 0)
+      {
+        if (rank == 0)
+        {
+          columns.IntersectFieldList(table->GetRowData());
+        }
+        else
+        {
+          vtkNew<vtkTable> emptytable;
+          controller->Receive(emptytable, vtkMultiProcessController::ANY_SOURCE, 88020);
+          columns.IntersectFieldList(emptytable->GetRowData());
+        }
+      }
+    }
+
+    vtkNew<vtkDataSetAttributes> tmp;
+    tmp->CopyAllOn();
+    columns.CopyAllocate(tmp, vtkDataSetAttributes::PASSDATA, /*sz=*/1, 0);
+    const std::string header = file.FormatHeader(tmp, this);
+
+    int error_code = vtkErrorCode::NoError;
+    if (!this->FileName)
+    {
+      error_code = vtkErrorCode::NoFileNameError;
+    }
+    else
+    {
+      std::ofstream output(this->FileName, ios::out | ios::binary | ios::trunc);
+      output.write(header.c_str(), header.size());
+      error_code = output.fail() ? vtkErrorCode::CannotOpenFileError : vtkErrorCode::NoError;
+    }
+
+    stream << error_code << static_cast<vtkTypeInt64>(header.size())
+           << static_cast<int>(file.GetColumns().size());
+    for (const auto& cinfo : file.GetColumns())
+    {
+      stream << cinfo.first << cinfo.second;
+    }
+  }
+  controller->Broadcast(stream, 0);
+
+  int error_code;
+  vtkTypeInt64 offset;
+  int num_columns;
+  stream >> error_code >> offset >> num_columns;
+  if (error_code != vtkErrorCode::NoError)
+  {
+    this->SetErrorCode(error_code);
+    return;
+  }
+  std::vector<std::pair<std::string, int> > columns(num_columns);
+  for (auto& cinfo : columns)
+  {
+    stream >> cinfo.first >> cinfo.second;
+  }
+  file.SetColumns(columns);
+
+  // format the local rows, then write them after the rows of lower ranks.
+  std::vector<std::string> chunks;
+  vtkIdType size = 0;
+  if (row_count > 0)
+  {
+    file.FormatData(table->GetRowData(), this, 0, row_count, chunks);
+    for (const auto& chunk : chunks)
+    {
+      size += static_cast<vtkIdType>(chunk.size());
+    }
+  }
+  std::vector<vtkIdType> global_sizes(numRanks, 0);
+  controller->AllGather(&size, &global_sizes[0], 1);
+  offset = std::accumulate(global_sizes.begin(), global_sizes.begin() + myRank, offset);
+
+  if (size > 0)
+  {
+    std::fstream output(this->FileName, ios::in | ios::out | ios::binary);
+    output.seekp(static_cast<std::streamoff>(offset));
+    for (const auto& chunk : chunks)
+    {
+      output.write(chunk.c_str(), chunk.size());
+    }
+    output.flush();
+    error_code = output.fail() ? vtkErrorCode::CannotOpenFileError : vtkErrorCode::NoError;
+  }
+
+  int global_error_code = vtkErrorCode::NoError;
+  controller->AllReduce(&error_code, &global_error_code, 1, vtkCommunicator::MAX_OP);
+  this->SetErrorCode(global_error_code);
+}
+
 //-----------------------------------------------------------------------------
 void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -489,6 +922,8 @@ void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "FileName: " << (this->FileName ? this->FileName : "none") << endl;
   os << indent << "UseScientificNotation: " << this->UseScientificNotation << endl;
   os << indent << "Precision: " << this->Precision << endl;
+  os << indent << "UseShortestRoundTrip: " << this->UseShortestRoundTrip << endl;
+  os << indent << "WriteInParallel: " << this->WriteInParallel << endl;
   os << indent << "FieldAssociation: " << this->FieldAssociation << endl;
   os << indent << "AddMetaData: " << this->AddMetaData << endl;
   if (this->Controller)
@@ -97,6 +97,29 @@ public:
   vtkBooleanMacro(UseScientificNotation, bool);
   //@}
 
+  //@{
+  /**
+   * When set to true (default is false), floating point values are written
+   * with the fewest significant digits that read back to the exact same value,
+   * ignoring Precision and UseScientificNotation.
+   */
+  vtkSetMacro(UseShortestRoundTrip, bool);
+  vtkGetMacro(UseShortestRoundTrip, bool);
+  vtkBooleanMacro(UseShortestRoundTrip, bool);
+  //@}
+
+  //@{
+  /**
+   * When set to true (default is false), in parallel runs each rank formats its
+   * own rows and writes them at its offset in the output file, instead of
+   * sending them to the root rank for writing. All ranks must be able to open
+   * the output file, i.e. it must be on a shared file system.
+   */
+  vtkSetMacro(WriteInParallel, bool);
+  vtkGetMacro(WriteInParallel, bool);
+  vtkBooleanMacro(WriteInParallel, bool);
+  //@}
+
   //@{
   /**
    * Get/set the attribute data to write if the input is either
@@ -144,6 +167,12 @@ protected:
 
   void WriteData() override;
 
+  /**
+   * Write `table` from all ranks of the controller, each rank writing its rows
+   * at its offset in the file. See WriteInParallel.
+   */
+  void WriteDataInParallel(vtkTable* table, double time);
+
   // see algorithm for more info.
   // This writer takes in vtkTable, vtkDataSet or vtkCompositeDataSet.
   int FillInputPortInformation(int port, vtkInformation* info) override;
@@ -158,6 +187,8 @@ protected:
   bool UseStringDelimiter;
   int Precision;
   bool UseScientificNotation;
+  bool UseShortestRoundTrip;
+  bool WriteInParallel;
   int FieldAssociation;
   bool AddMetaData;
   bool AddTime;
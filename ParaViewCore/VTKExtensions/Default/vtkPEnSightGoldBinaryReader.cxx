@@ -17,18 +17,173 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <ctype.h>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <streambuf>
 #include <string>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define VTK_PENSIGHT_HAS_MMAP
+#endif
+
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+namespace
+{
+#ifdef VTK_PENSIGHT_HAS_MMAP
+//----------------------------------------------------------------------------
+// Read-only std::streambuf over a memory-mapped file. The whole file is
+// exposed as the get area, so read() is a memcpy out of the page cache and
+// seekg() only moves a pointer. Read-ahead is disabled on the mapping so
+// that parts skipped with seekg() are not paged in; large reads ask the
+// kernel to prefetch just the range being copied instead. As with a
+// std::filebuf, seeking past the end succeeds and the next read fails.
+class vtkMappedFileBuffer : public std::streambuf
+{
+public:
+  vtkMappedFileBuffer()
+    : Data(nullptr)
+    , Size(0)
+    , Overrun(0)
+  {
+  }
+
+  ~vtkMappedFileBuffer() override
+  {
+    if (this->Data)
+    {
+      munmap(this->Data, this->Size);
+    }
+  }
+
+  bool Open(const char* filename, size_t size)
+  {
+    if (size == 0)
+    {
+      return false;
+    }
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+      return false;
+    }
+    madvise(data, size, MADV_RANDOM);
+    this->Data = static_cast<char*>(data);
+    this->Size = size;
+    this->setg(this->Data, this->Data, this->Data + this->Size);
+    return true;
+  }
+
+protected:
+  std::streamsize xsgetn(char* s, std::streamsize count) override
+  {
+    const std::streamsize available = this->egptr() - this->gptr();
+    const std::streamsize n = count < available ? count : available;
+    if (n <= 0)
+    {
+      return 0;
+    }
+    if (n >= vtkMappedFileBuffer::PrefetchThreshold)
+    {
+      // with MADV_RANDOM every fault reads a single page; prefetch the whole
+      // range (page aligned) before copying it.
+      const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+      const uintptr_t begin = reinterpret_cast<uintptr_t>(this->gptr()) & ~(page - 1);
+      const uintptr_t end = reinterpret_cast<uintptr_t>(this->gptr()) + n;
+      madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+    }
+    memcpy(s, this->gptr(), static_cast<size_t>(n));
+    this->setg(this->eback(), this->gptr() + n, this->egptr());
+    return n;
+  }
+
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+  {
+    off_type base = 0;
+    switch (dir)
+    {
+      case std::ios_base::beg:
+        break;
+      case std::ios_base::cur:
+        base = (this->gptr() - this->eback()) + this->Overrun;
+        break;
+      case std::ios_base::end:
+        base = static_cast<off_type>(this->Size);
+        break;
+      default:
+        return pos_type(off_type(-1));
+    }
+    return this->seekpos(pos_type(base + off), std::ios_base::in);
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode) override
+  {
+    const off_type offset = static_cast<off_type>(pos);
+    if (offset < 0)
+    {
+      return pos_type(off_type(-1));
+    }
+    // past the end, park at the end of the get area so that reads fail, but
+    // remember the requested position for tellg().
+    const off_type size = static_cast<off_type>(this->Size);
+    this->Overrun = offset > size ? offset - size : 0;
+    this->setg(this->eback(), this->eback() + (offset - this->Overrun), this->egptr());
+    return pos;
+  }
+
+private:
+  static const std::streamsize PrefetchThreshold = 64 * 1024;
+
+  char* Data;
+  size_t Size;
+  // how far past the end the last seek went.
+  off_type Overrun;
+};
+
+//----------------------------------------------------------------------------
+class vtkMappedFileStream : public std::istream
+{
+public:
+  vtkMappedFileStream()
+    : std::istream(nullptr)
+  {
+  }
+
+  bool Open(const char* filename, size_t size)
+  {
+    if (!this->Buffer.Open(filename, size))
+    {
+      return false;
+    }
+    this->rdbuf(&this->Buffer);
+    return true;
+  }
+
+private:
+  vtkMappedFileBuffer Buffer;
+};
+#endif
+}
+
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 {
   this->IFile = NULL;
   this->FileSize = 0;
+  this->UseMemoryMappedIO = true;
   this->Fortran = 0;
   this->NodeIdsListed = 0;
   this->ElementIdsListed = 0;
@@ -49,7 +204,6 @@ vtkPEnSightGoldBinaryReader::~vtkPEnSightGoldBinaryReader()
 {
   if (this->IFile)
   {
-    this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
@@ -71,7 +225,6 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
   // Close file from any previous image
   if (this->IFile)
   {
-    this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
@@ -84,7 +237,25 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
 
-#ifdef _WIN32
+#ifdef VTK_PENSIGHT_HAS_MMAP
+    if (this->UseMemoryMappedIO)
+    {
+      vtkMappedFileStream* mapped = new vtkMappedFileStream();
+      if (mapped->Open(filename, static_cast<size_t>(fs.st_size)))
+      {
+        this->IFile = mapped;
+      }
+      else
+      {
+        vtkDebugMacro(<< "Could not memory-map " << filename << ", using stream I/O instead.");
+        delete mapped;
+      }
+    }
+    if (!this->IFile)
+    {
+      this->IFile = new ifstream(filename, ios::in);
+    }
+#elif defined(_WIN32)
     this->IFile = new ifstream(filename, ios::in | ios::binary);
 #else
     this->IFile = new ifstream(filename, ios::in);
@@ -392,7 +563,6 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
         free(name);
         if (this->IFile)
         {
-          this->IFile->close();
           delete this->IFile;
           this->IFile = NULL;
         }
@@ -404,7 +574,6 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
 
   if (this->IFile)
   {
-    this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
@@ -537,7 +706,6 @@ int vtkPEnSightGoldBinaryReader::SkipTimeStep()
   {
     if (this->IFile)
     {
-      this->IFile->close();
       delete this->IFile;
       this->IFile = NULL;
     }
@@ -1280,7 +1448,6 @@ int vtkPEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
 
   if (this->IFile)
   {
-    this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
@@ -1434,7 +1601,6 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
     }
     if (this->IFile)
     {
-      this->IFile->close();
       delete this->IFile;
       this->IFile = NULL;
     }
@@ -1501,7 +1667,6 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
 
   if (this->IFile)
   {
-    this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
@@ -1655,7 +1820,6 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
     }
     if (this->IFile)
     {
-      this->IFile->close();
       delete this->IFile;
       this->IFile = NULL;
     }
@@ -1712,7 +1876,6 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
 
   if (this->IFile)
   {
-    this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
@@ -1875,7 +2038,6 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
 
   if (this->IFile)
   {
-    this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
@@ -1983,7 +2145,6 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
                 vtkErrorMacro("Unknown element type \"" << line << "\"");
                 if (this->IFile)
                 {
-                  this->IFile->close();
                   delete this->IFile;
                   this->IFile = NULL;
                 }
@@ -2070,7 +2231,6 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
             vtkErrorMacro("Unknown element type \"" << line << "\"");
             if (this->IFile)
             {
-              this->IFile->close();
               delete this->IFile;
               this->IFile = NULL;
             }
@@ -2132,7 +2292,6 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
 
   if (this->IFile)
   {
-    this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
@@ -2381,7 +2540,6 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
 
   if (this->IFile)
   {
-    this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
@@ -2651,7 +2809,6 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
 
   if (this->IFile)
   {
-    this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
@@ -4544,4 +4701,5 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
 void vtkPEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseMemoryMappedIO: " << this->UseMemoryMappedIO << endl;
 }
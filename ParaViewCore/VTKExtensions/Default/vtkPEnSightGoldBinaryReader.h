@@ -46,6 +46,19 @@ public:
   vtkTypeMacro(vtkPEnSightGoldBinaryReader, vtkPEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * When enabled (default), files are memory-mapped instead of being read
+   * through a buffered stream. Reads then become plain copies out of the page
+   * cache and skipping parts not needed by this rank costs nothing. Falls back
+   * to regular stream I/O if mapping the file fails or on platforms without
+   * mmap support.
+   */
+  vtkSetMacro(UseMemoryMappedIO, bool);
+  vtkGetMacro(UseMemoryMappedIO, bool);
+  vtkBooleanMacro(UseMemoryMappedIO, bool);
+  //@}
+
 protected:
   vtkPEnSightGoldBinaryReader();
   ~vtkPEnSightGoldBinaryReader() override;
@@ -204,9 +217,10 @@ protected:
   int ElementIdsListed;
   int Fortran;
 
-  ifstream* IFile;
+  istream* IFile;
   // The size of the file could be used to choose byte order.
   long FileSize;
+  bool UseMemoryMappedIO;
 
   // Float Vector Buffer utils
   void GetVectorFromFloatBuffer(vtkIdType i, float* vector);
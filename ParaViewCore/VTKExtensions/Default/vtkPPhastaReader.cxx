@@ -20,6 +20,7 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
+#include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
@@ -31,8 +32,11 @@
 
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <cstdio>
 #include <map>
 #include <sstream>
+#include <thread>
 
 struct vtkPPhastaReaderInternal
 {
@@ -54,10 +58,75 @@ struct vtkPPhastaReaderInternal
   TimeStepInfoMapType TimeStepInfoMap;
   typedef std::map<int, vtkSmartPointer<vtkUnstructuredGrid> > CachedGridsMapType;
   CachedGridsMapType CachedGrids;
+
+  // Piece to update piece assignment, computed once per meta-file so that
+  // cached grids stay valid across time steps.
+  std::vector<int> PieceAssignment;
+  int AssignmentNumberOfProcPieces = 0;
 };
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Substitutes the time and piece indices in a Phasta file name pattern. Names
+// with a relative path are relative to the meta-file directory.
+std::string vtkPPhastaFileName(const char* pattern, int hasTime, int hasPiece, int timeIndex,
+  int piece, const std::string& metaFilePath)
+{
+  std::vector<char> name(strlen(pattern) + 60);
+  if (hasTime && hasPiece)
+  {
+    snprintf(&name[0], name.size(), pattern, timeIndex, piece + 1);
+  }
+  else if (hasPiece)
+  {
+    snprintf(&name[0], name.size(), pattern, piece + 1);
+  }
+  else if (hasTime)
+  {
+    snprintf(&name[0], name.size(), pattern, timeIndex);
+  }
+  else
+  {
+    snprintf(&name[0], name.size(), "%s", pattern);
+  }
+
+  std::string fname;
+  std::string path = vtksys::SystemTools::GetFilenamePath(&name[0]);
+  if ((path.empty() || !vtksys::SystemTools::FileIsFullPath(path.c_str())) &&
+    !metaFilePath.empty())
+  {
+    fname = metaFilePath + "/";
+  }
+  fname += &name[0];
+  return fname;
+}
+
+//----------------------------------------------------------------------------
+// Reads files through so that they are in the page cache by the time
+// vtkPhastaReader parses them. Large sequential reads are used since the
+// small reads done while parsing are the bottleneck on parallel file systems.
+void vtkPPhastaReadAhead(const std::vector<std::string>& files)
+{
+  std::vector<char> buffer(4 << 20);
+  for (size_t cc = 0; cc < files.size(); ++cc)
+  {
+    FILE* file = fopen(files[cc].c_str(), "rb");
+    if (!file)
+    {
+      continue;
+    }
+    while (fread(&buffer[0], 1, buffer.size(), file) == buffer.size())
+    {
+    }
+    fclose(file);
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkPPhastaReader);
+vtkCxxSetObjectMacro(vtkPPhastaReader, Controller, vtkMultiProcessController);
 
 //----------------------------------------------------------------------------
 vtkPPhastaReader::vtkPPhastaReader()
@@ -77,6 +146,11 @@ vtkPPhastaReader::vtkPPhastaReader()
 
   this->TimeStepRange[0] = 0;
   this->TimeStepRange[1] = 0;
+
+  this->BalancePiecesBySize = true;
+  this->NumberOfReadAheadPieces = 2;
+  this->Controller = nullptr;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
 //----------------------------------------------------------------------------
@@ -91,6 +165,7 @@ vtkPPhastaReader::~vtkPPhastaReader()
   }
 
   delete this->Internal;
+  this->SetController(nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -207,75 +282,55 @@ int vtkPPhastaReader::RequestData(
     return 0;
   }
 
-  char* geom_name = new char[strlen(geometryPattern) + 60];
-  char* field_name = new char[strlen(fieldPattern) + 60];
-
-  // now loop over all of the files that I should load
-  for (int loadingPiece = piece; loadingPiece < numPieces; loadingPiece += numProcPieces)
+  const std::string metaFilePath = vtksys::SystemTools::GetFilenamePath(this->FileName);
+  const vtkPPhastaReaderInternal::TimeStepInfo& timeStepInfo =
+    this->Internal->TimeStepInfoMap[this->ActualTimeStep];
+  std::vector<std::string> geomFileNames(numPieces);
+  std::vector<std::string> fieldFileNames(numPieces);
+  for (int cc = 0; cc < numPieces; cc++)
   {
-    if (geomHasTime && geomHasPiece)
-    {
-      sprintf(geom_name, geometryPattern,
-        this->Internal->TimeStepInfoMap[this->ActualTimeStep].GeomIndex, loadingPiece + 1);
-    }
-    else if (geomHasPiece)
-    {
-      sprintf(geom_name, geometryPattern, loadingPiece + 1);
-    }
-    else if (geomHasTime)
-    {
-      sprintf(geom_name, geometryPattern,
-        this->Internal->TimeStepInfoMap[this->ActualTimeStep].GeomIndex);
-    }
-    else
-    {
-      strcpy(geom_name, geometryPattern);
-    }
+    geomFileNames[cc] = vtkPPhastaFileName(
+      geometryPattern, geomHasTime, geomHasPiece, timeStepInfo.GeomIndex, cc, metaFilePath);
+    fieldFileNames[cc] = vtkPPhastaFileName(
+      fieldPattern, fieldHasTime, fieldHasPiece, timeStepInfo.FieldIndex, cc, metaFilePath);
+  }
 
-    if (fieldHasTime && fieldHasPiece)
-    {
-      sprintf(field_name, fieldPattern,
-        this->Internal->TimeStepInfoMap[this->ActualTimeStep].FieldIndex, loadingPiece + 1);
-    }
-    else if (fieldHasPiece)
-    {
-      sprintf(field_name, fieldPattern, loadingPiece + 1);
-    }
-    else if (fieldHasTime)
-    {
-      sprintf(
-        field_name, fieldPattern, this->Internal->TimeStepInfoMap[this->ActualTimeStep].FieldIndex);
-    }
-    else
-    {
-      strcpy(geom_name, fieldPattern);
-    }
+  std::vector<int> piecesToLoad = this->GetPiecesToLoad(piece, numProcPieces, geomFileNames);
+
+  // read ahead the files of the next pieces while the current one is parsed.
+  // Geometry files of pieces with a cached grid are not read at all. The
+  // thread reading a piece is joined right before that piece is parsed, so at
+  // most NumberOfReadAheadPieces threads run at a time.
+  std::vector<std::thread> readAheadThreads(piecesToLoad.size());
+  size_t readAheadEnd = 0;
 
-    std::ostringstream geomFName;
-    std::string gpath = vtksys::SystemTools::GetFilenamePath(geom_name);
-    if (gpath.empty() || !vtksys::SystemTools::FileIsFullPath(gpath.c_str()))
+  // now loop over all of the files that I should load
+  for (size_t cc = 0; cc < piecesToLoad.size(); ++cc)
+  {
+    const int loadingPiece = piecesToLoad[cc];
+    for (; readAheadEnd < std::min(piecesToLoad.size(), cc + 1 + this->NumberOfReadAheadPieces);
+         ++readAheadEnd)
     {
-      std::string path = vtksys::SystemTools::GetFilenamePath(this->FileName);
-      if (!path.empty())
+      const int nextPiece = piecesToLoad[readAheadEnd];
+      if (readAheadEnd == cc)
       {
-        geomFName << path.c_str() << "/";
+        continue;
       }
-    }
-    geomFName << geom_name << ends;
-    this->Reader->SetGeometryFileName(geomFName.str().c_str());
-
-    std::ostringstream fieldFName;
-    std::string fpath = vtksys::SystemTools::GetFilenamePath(field_name);
-    if (fpath.empty() || !vtksys::SystemTools::FileIsFullPath(fpath.c_str()))
-    {
-      std::string path = vtksys::SystemTools::GetFilenamePath(this->FileName);
-      if (!path.empty())
+      std::vector<std::string> files;
+      if (this->Internal->CachedGrids.find(nextPiece) == this->Internal->CachedGrids.end())
       {
-        fieldFName << path.c_str() << "/";
+        files.push_back(geomFileNames[nextPiece]);
       }
+      files.push_back(fieldFileNames[nextPiece]);
+      readAheadThreads[readAheadEnd] = std::thread(vtkPPhastaReadAhead, files);
     }
-    fieldFName << field_name << ends;
-    this->Reader->SetFieldFileName(fieldFName.str().c_str());
+    if (readAheadThreads[cc].joinable())
+    {
+      readAheadThreads[cc].join();
+    }
+
+    this->Reader->SetGeometryFileName(geomFileNames[loadingPiece].c_str());
+    this->Reader->SetFieldFileName(fieldFileNames[loadingPiece].c_str());
 
     vtkPPhastaReaderInternal::CachedGridsMapType::iterator CachedCopy =
       this->Internal->CachedGrids.find(loadingPiece);
@@ -302,9 +357,6 @@ int vtkPPhastaReader::RequestData(
     MultiPieceDataSet->SetPiece(loadingPiece, copy);
   }
 
-  delete[] geom_name;
-  delete[] field_name;
-
   if (steps)
   {
     output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), steps[this->ActualTimeStep]);
@@ -318,6 +370,7 @@ int vtkPPhastaReader::RequestInformation(
   vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
 {
   this->Internal->TimeStepInfoMap.clear();
+  this->Internal->PieceAssignment.clear();
   this->Reader->ClearFieldInfo();
 
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
@@ -563,6 +616,76 @@ int vtkPPhastaReader::RequestInformation(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+std::vector<int> vtkPPhastaReader::GetPiecesToLoad(
+  int piece, int numProcPieces, const std::vector<std::string>& geometryFiles)
+{
+  const int numPieces = static_cast<int>(geometryFiles.size());
+  std::vector<int> piecesToLoad;
+  if (!this->BalancePiecesBySize || numProcPieces <= 1)
+  {
+    for (int cc = piece; cc < numPieces; cc += numProcPieces)
+    {
+      piecesToLoad.push_back(cc);
+    }
+    return piecesToLoad;
+  }
+
+  std::vector<int>& assignment = this->Internal->PieceAssignment;
+  if (static_cast<int>(assignment.size()) != numPieces ||
+    this->Internal->AssignmentNumberOfProcPieces != numProcPieces)
+  {
+    // Only one process queries the file sizes when every process reads one
+    // update piece; with thousands of files, stat calls from every rank
+    // would swamp the metadata server.
+    std::vector<unsigned long> sizes(numPieces, 0);
+    vtkMultiProcessController* controller = this->Controller;
+    const bool shareSizes = controller && controller->GetNumberOfProcesses() == numProcPieces;
+    if (!shareSizes || controller->GetLocalProcessId() == 0)
+    {
+      for (int cc = 0; cc < numPieces; ++cc)
+      {
+        sizes[cc] = vtksys::SystemTools::FileLength(geometryFiles[cc]);
+      }
+    }
+    if (shareSizes && numPieces > 0)
+    {
+      controller->Broadcast(&sizes[0], numPieces, 0);
+    }
+
+    // Largest pieces first, each to the least loaded update piece. Ties are
+    // broken by index so that all processes compute the same assignment.
+    std::vector<int> order(numPieces);
+    for (int cc = 0; cc < numPieces; ++cc)
+    {
+      order[cc] = cc;
+    }
+    std::stable_sort(order.begin(), order.end(),
+      [&sizes](int a, int b) { return sizes[a] > sizes[b]; });
+
+    std::vector<unsigned long> load(numProcPieces, 0);
+    assignment.assign(numPieces, 0);
+    for (int cc = 0; cc < numPieces; ++cc)
+    {
+      const int target =
+        static_cast<int>(std::min_element(load.begin(), load.end()) - load.begin());
+      assignment[order[cc]] = target;
+      // count empty files as one byte so that they are spread out too.
+      load[target] += std::max(sizes[order[cc]], 1ul);
+    }
+    this->Internal->AssignmentNumberOfProcPieces = numProcPieces;
+  }
+
+  for (int cc = 0; cc < numPieces; ++cc)
+  {
+    if (assignment[cc] == piece)
+    {
+      piecesToLoad.push_back(cc);
+    }
+  }
+  return piecesToLoad;
+}
+
 //-----------------------------------------------------------------------------
 int vtkPPhastaReader::CanReadFile(const char* filename)
 {
@@ -594,4 +717,7 @@ void vtkPPhastaReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "TimeStepIndex: " << this->TimeStepIndex << endl;
   os << indent << "TimeStepRange: " << this->TimeStepRange[0] << " " << this->TimeStepRange[1]
      << endl;
+  os << indent << "BalancePiecesBySize: " << this->BalancePiecesBySize << endl;
+  os << indent << "NumberOfReadAheadPieces: " << this->NumberOfReadAheadPieces << endl;
+  os << indent << "Controller: " << this->Controller << endl;
 }
@@ -112,6 +112,12 @@
  * velocity (index 1-3 under solution)
  * temperature (index 4 under soltuion)
  *
+ * Pieces are distributed among the update pieces so that each one reads
+ * about the same number of bytes, using the sizes of the geometry files
+ * (see BalancePiecesBySize). While a piece is parsed, the files of the next
+ * pieces assigned to the same process are read ahead by background threads
+ * (see NumberOfReadAheadPieces), overlapping the I/O of consecutive pieces.
+ *
  * @sa
  * vtkPhastaReader
 */
@@ -122,6 +128,10 @@
 #include "vtkMultiBlockDataSetAlgorithm.h"
 #include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
 
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class vtkMultiProcessController;
 class vtkPVXMLParser;
 class vtkPhastaReader;
 
@@ -157,6 +167,37 @@ public:
   vtkGetVector2Macro(TimeStepRange, int);
   //@}
 
+  //@{
+  /**
+   * When on (default), pieces are assigned to update pieces by decreasing
+   * geometry file size, each one going to the least loaded update piece. When
+   * off, pieces are assigned round-robin.
+   */
+  vtkSetMacro(BalancePiecesBySize, bool);
+  vtkGetMacro(BalancePiecesBySize, bool);
+  vtkBooleanMacro(BalancePiecesBySize, bool);
+  //@}
+
+  //@{
+  /**
+   * Number of upcoming pieces whose files are read ahead in background
+   * threads while the current piece is parsed. Set to 0 to disable read-ahead.
+   * Defaults to 2.
+   */
+  vtkSetClampMacro(NumberOfReadAheadPieces, int, 0, 64);
+  vtkGetMacro(NumberOfReadAheadPieces, int);
+  //@}
+
+  //@{
+  /**
+   * Controller used to share the file sizes needed to balance pieces, so that
+   * only one process queries the file system. Defaults to the global
+   * controller.
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
   static int CanReadFile(const char* filename);
 
 protected:
@@ -182,6 +223,18 @@ protected:
 
   int ActualTimeStep;
 
+  bool BalancePiecesBySize;
+  int NumberOfReadAheadPieces;
+  vtkMultiProcessController* Controller;
+
+  /**
+   * Returns the pieces among `numPieces` to be read by update piece `piece`
+   * out of `numProcPieces`. `geometryFiles` are the geometry file names of all
+   * the pieces.
+   */
+  std::vector<int> GetPiecesToLoad(int piece, int numProcPieces,
+    const std::vector<std::string>& geometryFiles);
+
 private:
   vtkPPhastaReaderInternal* Internal;
 
@@ -652,6 +652,7 @@ void vtkPlotEdges::ReducePolyData(vtkPolyData* polyData, vtkPolyData* output)
 
   vtkSmartPointer<vtkAppendPolyData> as = vtkSmartPointer<vtkAppendPolyData>::New();
   md->SetPostGatherHelper(as);
+  md->TreeReductionOn();
 
   vtkSmartPointer<vtkPolyData> inputPD = vtkSmartPointer<vtkPolyData>::New();
   inputPD->ShallowCopy(vtkPolyData::SafeDownCast(polyData));
@@ -5,9 +5,12 @@
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
+#include <atomic>
 #include <sstream>
 #include <vector>
 #include <vtksys/RegularExpression.hxx>
@@ -38,6 +41,79 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   return os;
 }
 
+template <class t>
+int vtkSpyPlotUniReaderRunLengthDataDecode(
+  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1);
+
+namespace
+{
+// A run-length encoded plane of a cell field read from the file and the
+// location in the field's array where it is to be decoded.
+struct vtkSpyPlotEncodedPlane
+{
+  size_t Offset;
+  int Size;
+  vtkFloatArray* FloatArray;
+  vtkUnsignedCharArray* UnsignedCharArray;
+  vtkIdType OutOffset;
+  int OutSize;
+};
+
+// Decodes all planes of a cell field in parallel. Planes are independent so
+// each one can be decoded by any thread. Errors are not reported from the
+// worker threads; the caller reports them instead.
+bool vtkSpyPlotDecodePlanes(
+  const std::vector<unsigned char>& encoded, const std::vector<vtkSpyPlotEncodedPlane>& planes)
+{
+  std::atomic<bool> success(true);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(planes.size()),
+    [&encoded, &planes, &success](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end && success; ++cc)
+      {
+        const vtkSpyPlotEncodedPlane& plane = planes[cc];
+        const unsigned char* in = encoded.data() + plane.Offset;
+        int status = 1;
+        if (plane.FloatArray)
+        {
+          status = ::vtkSpyPlotUniReaderRunLengthDataDecode<float>(nullptr, in, plane.Size,
+            plane.FloatArray->GetPointer(plane.OutOffset), plane.OutSize);
+        }
+        else if (plane.UnsignedCharArray)
+        {
+          status = ::vtkSpyPlotUniReaderRunLengthDataDecode<unsigned char>(nullptr, in,
+            plane.Size, plane.UnsignedCharArray->GetPointer(plane.OutOffset), plane.OutSize,
+            static_cast<unsigned char>(255));
+        }
+        if (!status)
+        {
+          success = false;
+        }
+      }
+    });
+  return success;
+}
+
+// Frees the data blocks of a variable so that they are read again on the next
+// MakeCurrent().
+void vtkSpyPlotReleaseDataBlocks(vtkSpyPlotUniReader::Variable* var, int numBlocks)
+{
+  if (var->DataBlocks)
+  {
+    for (int cc = 0; cc < numBlocks; ++cc)
+    {
+      if (var->DataBlocks[cc])
+      {
+        var->DataBlocks[cc]->Delete();
+      }
+    }
+    delete[] var->DataBlocks;
+    var->DataBlocks = nullptr;
+  }
+  delete[] var->GhostCellsFixed;
+  var->GhostCellsFixed = nullptr;
+}
+}
+
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 {
@@ -212,6 +288,8 @@ int vtkSpyPlotUniReader::MakeCurrent()
   }
 
   std::vector<unsigned char> arrayBuffer;
+  std::vector<unsigned char> encodedPlanes;
+  std::vector<vtkSpyPlotEncodedPlane> planes;
   ifstream ifs(this->FileName, ios::binary | ios::in);
   vtkSpyPlotIStream spis;
   spis.SetStream(&ifs);
@@ -386,7 +464,14 @@ int vtkSpyPlotUniReader::MakeCurrent()
     // vtkDebugMacro( "  Field: " << fieldCnt << " / " << dp->NumVars
     // << " [" << var->Name << "]" );
     // vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
+    // The planes for all blocks are read sequentially from the file first,
+    // and then decoded in parallel.
+    // The arrays are only handed over to var->DataBlocks once decoded, so
+    // that a failure doesn't leave partially read blocks behind.
     spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
+    encodedPlanes.clear();
+    planes.clear();
+    std::vector<vtkSmartPointer<vtkDataArray> > newBlocks(dp->ActualNumberOfBlocks);
     int numBytes;
     int block;
     int actualBlockId = 0;
@@ -414,6 +499,7 @@ int vtkSpyPlotUniReader::MakeCurrent()
           dataArray->SetNumberOfTuples(
             bk->GetDimension(0) * bk->GetDimension(1) * bk->GetDimension(2));
           dataArray->SetName(var->Name);
+          newBlocks[actualBlockId].TakeReference(dataArray);
           // vtkDebugMacro( "*** Create data array: "
           // << dataArray->GetNumberOfTuples() );
         }
@@ -423,48 +509,64 @@ int vtkSpyPlotUniReader::MakeCurrent()
         for (zax = 0; zax < bdims[2]; ++zax)
         {
           int planeSize = bdims[0] * bdims[1];
-          if (!spis.ReadInt32s(&numBytes, 1))
+          if (!spis.ReadInt32s(&numBytes, 1) || numBytes < 0)
           {
             vtkErrorMacro("Problem reading the number of bytes");
+            vtkSpyPlotReleaseDataBlocks(var, dp->ActualNumberOfBlocks);
             return 0;
           }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
+          unsigned char* buffer;
+          if (dataArray)
           {
-            arrayBuffer.resize(numBytes);
+            vtkSpyPlotEncodedPlane plane;
+            plane.Offset = encodedPlanes.size();
+            plane.Size = numBytes;
+            plane.FloatArray = floatArray;
+            plane.UnsignedCharArray = unsignedCharArray;
+            plane.OutOffset = static_cast<vtkIdType>(zax) * planeSize;
+            plane.OutSize = planeSize;
+            planes.push_back(plane);
+            encodedPlanes.resize(plane.Offset + numBytes);
+            buffer = encodedPlanes.data() + plane.Offset;
           }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
-          {
-            vtkErrorMacro("Problem reading the bytes");
-            return 0;
-          }
-          if (floatArray)
+          else
           {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
+            if (static_cast<int>(arrayBuffer.size()) < numBytes)
             {
-              vtkErrorMacro("Problem RLD decoding float data array");
-              return 0;
+              arrayBuffer.resize(numBytes);
             }
+            buffer = arrayBuffer.data();
           }
-          if (unsignedCharArray)
+          if (numBytes > 0 && !spis.ReadString(buffer, numBytes))
           {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
-              return 0;
-            }
+            vtkErrorMacro("Problem reading the bytes");
+            vtkSpyPlotReleaseDataBlocks(var, dp->ActualNumberOfBlocks);
+            return 0;
           }
         }
         if (dataArray)
         {
-          var->DataBlocks[actualBlockId] = dataArray;
-          var->GhostCellsFixed[actualBlockId] = 0;
-          vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
           actualBlockId++;
         }
       }
     }
+
+    if (!vtkSpyPlotDecodePlanes(encodedPlanes, planes))
+    {
+      vtkErrorMacro("Problem RLD decoding data array for variable: " << var->Name);
+      vtkSpyPlotReleaseDataBlocks(var, dp->ActualNumberOfBlocks);
+      return 0;
+    }
+    for (int cc = 0; cc < dp->ActualNumberOfBlocks; ++cc)
+    {
+      if (vtkDataArray* dataArray = newBlocks[cc])
+      {
+        dataArray->Register(nullptr);
+        var->DataBlocks[cc] = dataArray;
+        var->GhostCellsFixed[cc] = 0;
+        vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
+      }
+    }
   }
 
   if (blocksUpdated && needMarkers)
@@ -664,7 +766,7 @@ void vtkSpyPlotUniReader::PrintInformation()
 //-----------------------------------------------------------------------------
 template <class t>
 int vtkSpyPlotUniReaderRunLengthDataDecode(
-  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
+  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale)
 {
   int outIndex = 0, inIndex = 0;
 
@@ -688,8 +790,11 @@ int vtkSpyPlotUniReaderRunLengthDataDecode(
       {
         if (outIndex >= outSize)
         {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-              << "Too much data generated. Expected: " << outSize);
+          if (self)
+          {
+            vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
+                << "Too much data generated. Expected: " << outSize);
+          }
           return 0;
         }
         out[outIndex] = static_cast<t>(val * scale);
@@ -704,8 +809,11 @@ int vtkSpyPlotUniReaderRunLengthDataDecode(
       {
         if (outIndex >= outSize)
         {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-              << "Too much data generated. Expected: " << outSize);
+          if (self)
+          {
+            vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
+                << "Too much data generated. Expected: " << outSize);
+          }
           return 0;
         }
         float val;
@@ -0,0 +1,195 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestOrderedCompositeDistributorPlanReuse.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkOrderedCompositeDistributor reuses its redistribution plan
+// when only attribute arrays change, even though the kd-tree is rebuilt (as
+// vtkPVRenderViewDataDeliveryManager does), and that the result matches a
+// full redistribution, including the arrays generated by the redistribution,
+// for every boundary mode.
+
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkOrderedCompositeDistributor.h"
+#include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> NewPiece(int rank, int numRanks, float scale)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->UpdatePiece(rank, numRanks, 0);
+
+  auto piece = vtkSmartPointer<vtkPolyData>::New();
+  piece->ShallowCopy(sphere->GetOutput());
+  vtkNew<vtkFloatArray> values;
+  values->SetName("Values");
+  values->SetNumberOfTuples(piece->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < piece->GetNumberOfPoints(); ++cc)
+  {
+    double pt[3];
+    piece->GetPoint(cc, pt);
+    values->SetValue(cc, scale * static_cast<float>(pt[0] + 2 * pt[1] + 3 * pt[2]));
+  }
+  piece->GetPointData()->SetScalars(values);
+
+  vtkNew<vtkIntArray> cellValues;
+  cellValues->SetName("CellValues");
+  cellValues->SetNumberOfComponents(2);
+  cellValues->SetNumberOfTuples(piece->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < piece->GetNumberOfCells(); ++cc)
+  {
+    cellValues->SetTypedComponent(cc, 0, rank);
+    cellValues->SetTypedComponent(cc, 1, static_cast<int>(scale * cc));
+  }
+  piece->GetCellData()->AddArray(cellValues);
+  return piece;
+}
+
+vtkSmartPointer<vtkPKdTree> NewKdTree(vtkMultiProcessController* controller, vtkPolyData* piece)
+{
+  auto kdtree = vtkSmartPointer<vtkPKdTree>::New();
+  kdtree->SetController(controller);
+  kdtree->SetNumberOfRegionsOrMore(controller->GetNumberOfProcesses());
+  kdtree->SetDataSet(piece);
+  kdtree->BuildLocator();
+  kdtree->CreateProcessDataArrays();
+  kdtree->AssignRegionsContiguous();
+  return kdtree;
+}
+
+bool SameArrays(vtkDataSetAttributes* a, vtkDataSetAttributes* b, const char* type)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    cerr << "Mismatch in number of " << type << " arrays." << endl;
+    return false;
+  }
+  for (int idx = 0; idx < a->GetNumberOfArrays(); ++idx)
+  {
+    vtkAbstractArray* aa = a->GetAbstractArray(idx);
+    vtkAbstractArray* ab = aa->GetName() ? b->GetAbstractArray(aa->GetName()) : nullptr;
+    if (ab == nullptr || aa->GetNumberOfComponents() != ab->GetNumberOfComponents() ||
+      aa->GetNumberOfTuples() != ab->GetNumberOfTuples() ||
+      aa->GetDataType() != ab->GetDataType())
+    {
+      cerr << "Mismatch in " << type << " array '" << (aa->GetName() ? aa->GetName() : "")
+           << "'." << endl;
+      return false;
+    }
+    for (vtkIdType cc = 0; cc < aa->GetNumberOfValues(); ++cc)
+    {
+      if (aa->GetVariantValue(cc) != ab->GetVariantValue(cc))
+      {
+        cerr << "Mismatch in " << type << " array '" << aa->GetName() << "' at value " << cc
+             << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    cerr << "Mismatch in number of points or cells." << endl;
+    return false;
+  }
+  return SameArrays(a->GetPointData(), b->GetPointData(), "point") &&
+    SameArrays(a->GetCellData(), b->GetCellData(), "cell");
+}
+
+bool TestBoundaryMode(vtkMultiProcessController* controller, int mode)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+  bool success = true;
+
+  vtkNew<vtkOrderedCompositeDistributor> distributor;
+  distributor->SetController(controller);
+  distributor->SetBoundaryMode(mode);
+  distributor->SetOutputType("vtkPolyData");
+
+  vtkNew<vtkOrderedCompositeDistributor> reference;
+  reference->SetController(controller);
+  reference->SetBoundaryMode(mode);
+  reference->SetOutputType("vtkPolyData");
+  reference->ReuseRedistributionPlanOff();
+
+  for (int step = 0; step < 3; ++step)
+  {
+    // attributes change on every step, the geometry doesn't. The kd-tree is
+    // rebuilt every time since the data changed.
+    auto piece = NewPiece(rank, numRanks, static_cast<float>(step + 1));
+    auto kdtree = NewKdTree(controller, piece);
+
+    distributor->SetPKdTree(kdtree);
+    distributor->SetInputData(piece);
+    distributor->Update();
+
+    reference->SetPKdTree(kdtree);
+    reference->SetInputData(piece);
+    reference->Update();
+
+    // splitting cells interpolates attributes, so the plan is never reused.
+    const bool expectReuse =
+      step > 0 && numRanks > 1 && mode != vtkOrderedCompositeDistributor::SPLIT_BOUNDARY_CELLS;
+    if (distributor->GetRedistributionPlanReused() != expectReuse)
+    {
+      cerr << "Rank " << rank << ", mode " << mode << ", step " << step << ": plan "
+           << (expectReuse ? "was not" : "was unexpectedly") << " reused." << endl;
+      success = false;
+    }
+    if (!SameOutput(vtkPolyData::SafeDownCast(distributor->GetOutputDataObject(0)),
+          vtkPolyData::SafeDownCast(reference->GetOutputDataObject(0))))
+    {
+      cerr << "Rank " << rank << ", mode " << mode << ", step " << step
+           << ": output differs from a full redistribution." << endl;
+      success = false;
+    }
+  }
+  return success;
+}
+}
+
+int TestOrderedCompositeDistributorPlanReuse(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int success = 1;
+  success &= TestBoundaryMode(controller, vtkOrderedCompositeDistributor::ASSIGN_TO_ONE_REGION);
+  success &= TestBoundaryMode(
+    controller, vtkOrderedCompositeDistributor::ASSIGN_TO_ALL_INTERSECTING_REGIONS);
+  success &= TestBoundaryMode(controller, vtkOrderedCompositeDistributor::SPLIT_BOUNDARY_CELLS);
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -26,8 +26,13 @@
 
 #include "vtkBSPCuts.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSetSurfaceFilter.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -35,13 +40,392 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #if VTK_MODULE_ENABLE_VTK_FiltersParallelMPI
 #include "vtkDistributedDataFilter.h"
+#include "vtkMPICommunicator.h"
+#include "vtkMPIController.h"
 #endif
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Saved redistribution plan. For every rank, we keep the local point and cell
+// ids sent to that rank and the output point and cell ids that receive the
+// values from that rank, in the order they are sent.
+class vtkOrderedCompositeDistributor::vtkPlan
+{
+public:
+  bool Valid = false;
+  vtkTypeUInt64 GeometryHash = 0;
+  int BoundaryMode = -1;
+
+  // Copy of the cuts and the region assignments the plan was built with. The
+  // kd-tree is rebuilt whenever any of the data it was built from changes, so
+  // its modification time cannot be used to tell if the partitioning is the
+  // same.
+  vtkSmartPointer<vtkBSPCuts> Cuts;
+  std::vector<int> RegionAssignments;
+
+  // Redistributed dataset with only the point and cell arrays generated by
+  // the redistribution.
+  vtkSmartPointer<vtkDataSet> Output;
+
+  std::vector<std::vector<vtkIdType> > SendPointIds;
+  std::vector<std::vector<vtkIdType> > SendCellIds;
+  std::vector<std::vector<vtkIdType> > RecvPointIds;
+  std::vector<std::vector<vtkIdType> > RecvCellIds;
+
+  void Reset() { *this = vtkPlan(); }
+};
+
+namespace
+{
+const char* vtkOCDSourceIdsName = "vtkOrderedCompositeDistributorSourceIds";
+
+// Simple 64-bit hash used to detect changes to the input geometry and topology
+// without keeping a copy of it around.
+vtkTypeUInt64 vtkOCDHash(const void* data, size_t length, vtkTypeUInt64 hash)
+{
+  const vtkTypeUInt64 prime = 0x100000001b3ull;
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  size_t cc = 0;
+  for (; cc + sizeof(vtkTypeUInt64) <= length; cc += sizeof(vtkTypeUInt64))
+  {
+    vtkTypeUInt64 word;
+    std::memcpy(&word, bytes + cc, sizeof(word));
+    hash = (hash ^ word) * prime;
+    hash ^= hash >> 29;
+  }
+  for (; cc < length; ++cc)
+  {
+    hash = (hash ^ bytes[cc]) * prime;
+  }
+  return hash;
+}
+
+vtkTypeUInt64 vtkOCDHash(vtkDataArray* array, vtkTypeUInt64 hash)
+{
+  if (array == nullptr || array->GetNumberOfValues() == 0)
+  {
+    return vtkOCDHash(&hash, sizeof(hash), hash);
+  }
+  const size_t length = static_cast<size_t>(array->GetNumberOfValues()) * array->GetDataTypeSize();
+  hash = vtkOCDHash(&length, sizeof(length), hash);
+  return vtkOCDHash(array->GetVoidPointer(0), length, hash);
+}
+
+vtkTypeUInt64 vtkOCDHash(vtkCellArray* cells, vtkTypeUInt64 hash)
+{
+  return vtkOCDHash(cells ? cells->GetData() : nullptr, hash);
+}
+
+// Returns a hash for the geometry and topology of the dataset, or false if
+// the dataset type is not supported.
+bool vtkOCDGeometryHash(vtkDataSet* ds, vtkTypeUInt64& hash)
+{
+  hash = 0xcbf29ce484222325ull;
+  const vtkIdType counts[2] = { ds->GetNumberOfPoints(), ds->GetNumberOfCells() };
+  hash = vtkOCDHash(counts, sizeof(counts), hash);
+  if (auto pd = vtkPolyData::SafeDownCast(ds))
+  {
+    hash = vtkOCDHash(pd->GetPoints() ? pd->GetPoints()->GetData() : nullptr, hash);
+    hash = vtkOCDHash(pd->GetVerts(), hash);
+    hash = vtkOCDHash(pd->GetLines(), hash);
+    hash = vtkOCDHash(pd->GetPolys(), hash);
+    hash = vtkOCDHash(pd->GetStrips(), hash);
+    return true;
+  }
+  if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    hash = vtkOCDHash(ug->GetPoints() ? ug->GetPoints()->GetData() : nullptr, hash);
+    hash = vtkOCDHash(ug->GetCells(), hash);
+    hash = vtkOCDHash(ug->GetCellTypesArray(), hash);
+    hash = vtkOCDHash(ug->GetFaces(), hash);
+    return true;
+  }
+  return false;
+}
+
+// Add an array to `attributes` with the (rank, id) for each element.
+void vtkOCDAddSourceIds(vtkDataSetAttributes* attributes, vtkIdType count, int rank)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName(vtkOCDSourceIdsName);
+  ids->SetNumberOfComponents(2);
+  ids->SetNumberOfTuples(count);
+  for (vtkIdType cc = 0; cc < count; ++cc)
+  {
+    ids->SetValue(2 * cc, rank);
+    ids->SetValue(2 * cc + 1, cc);
+  }
+  attributes->AddArray(ids);
+}
+
+// Split the (rank, id) array in `attributes` into ids requested from each rank
+// and the local ids receiving the values from each rank.
+bool vtkOCDSplitSourceIds(vtkDataSetAttributes* attributes, vtkIdType count, int numRanks,
+  std::vector<std::vector<vtkIdType> >& requested, std::vector<std::vector<vtkIdType> >& recv)
+{
+  requested.assign(numRanks, std::vector<vtkIdType>());
+  recv.assign(numRanks, std::vector<vtkIdType>());
+  auto ids = vtkIdTypeArray::SafeDownCast(attributes->GetArray(vtkOCDSourceIdsName));
+  if (ids == nullptr || ids->GetNumberOfComponents() != 2 || ids->GetNumberOfTuples() != count)
+  {
+    return count == 0;
+  }
+  for (vtkIdType cc = 0; cc < count; ++cc)
+  {
+    const vtkIdType rank = ids->GetValue(2 * cc);
+    if (rank < 0 || rank >= numRanks)
+    {
+      return false;
+    }
+    requested[rank].push_back(ids->GetValue(2 * cc + 1));
+    recv[rank].push_back(cc);
+  }
+  return true;
+}
+
+// Extract the tuples with the given ids from all arrays in `attributes`.
+void vtkOCDExtract(
+  vtkDataSetAttributes* attributes, const std::vector<vtkIdType>& ids, vtkTable* table)
+{
+  vtkNew<vtkIdList> idList;
+  idList->SetNumberOfIds(static_cast<vtkIdType>(ids.size()));
+  std::copy(ids.begin(), ids.end(), idList->GetPointer(0));
+  for (int cc = 0, max = attributes->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    vtkAbstractArray* array = attributes->GetAbstractArray(cc);
+    if (array->GetName() == nullptr)
+    {
+      continue;
+    }
+    vtkSmartPointer<vtkAbstractArray> subset;
+    subset.TakeReference(array->NewInstance());
+    subset->SetName(array->GetName());
+    subset->SetNumberOfComponents(array->GetNumberOfComponents());
+    subset->SetNumberOfTuples(idList->GetNumberOfIds());
+    array->GetTuples(idList, subset);
+    table->AddColumn(subset);
+  }
+}
+
+// Scatter the rows in `table` to the tuples with the given ids in `attributes`,
+// creating the arrays as needed.
+void vtkOCDScatter(vtkTable* table, const std::vector<vtkIdType>& ids, vtkIdType count,
+  vtkDataSetAttributes* attributes)
+{
+  if (table->GetNumberOfRows() != static_cast<vtkIdType>(ids.size()))
+  {
+    return;
+  }
+  for (vtkIdType col = 0, max = table->GetNumberOfColumns(); col < max; ++col)
+  {
+    vtkAbstractArray* source = table->GetColumn(col);
+    vtkAbstractArray* target = attributes->GetAbstractArray(source->GetName());
+    if (target == nullptr)
+    {
+      vtkSmartPointer<vtkAbstractArray> array;
+      array.TakeReference(source->NewInstance());
+      array->SetName(source->GetName());
+      array->SetNumberOfComponents(source->GetNumberOfComponents());
+      array->SetNumberOfTuples(count);
+      attributes->AddArray(array);
+      target = array;
+    }
+    else if (target->GetNumberOfComponents() != source->GetNumberOfComponents())
+    {
+      continue;
+    }
+    for (size_t cc = 0; cc < ids.size(); ++cc)
+    {
+      target->SetTuple(ids[cc], static_cast<vtkIdType>(cc), source);
+    }
+  }
+}
+
+// Remove from the redistributed `attributes` the arrays that are exchanged
+// when a plan is reused i.e. the arrays of the input. What remains was
+// generated by the redistribution, such as the ghost array marking duplicated
+// boundary cells, and only depends on the geometry and the partitioning. The
+// ghost array is kept even if the input has one, since it is updated by the
+// redistribution.
+void vtkOCDKeepGeneratedArrays(
+  vtkDataSetAttributes* attributes, vtkDataSetAttributes* inputAttributes)
+{
+  for (int cc = attributes->GetNumberOfArrays() - 1; cc >= 0; --cc)
+  {
+    const char* name = attributes->GetAbstractArray(cc)->GetName();
+    if (name && strcmp(name, vtkDataSetAttributes::GhostArrayName()) == 0)
+    {
+      continue;
+    }
+    if (name == nullptr || inputAttributes->GetAbstractArray(name) != nullptr)
+    {
+      attributes->RemoveArray(cc);
+    }
+  }
+}
+
+// Add all arrays of `source` to `attributes`, replacing arrays with the same
+// name.
+void vtkOCDAddArrays(vtkDataSetAttributes* source, vtkDataSetAttributes* attributes)
+{
+  for (int cc = 0, max = source->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    attributes->AddArray(source->GetAbstractArray(cc));
+  }
+}
+
+// Make the same arrays as in `reference` active in `attributes`.
+void vtkOCDCopyActiveAttributes(vtkDataSetAttributes* reference, vtkDataSetAttributes* attributes)
+{
+  for (int attr = 0; attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+  {
+    vtkAbstractArray* array = reference->GetAbstractAttribute(attr);
+    if (array && array->GetName())
+    {
+      attributes->SetActiveAttribute(array->GetName(), attr);
+    }
+  }
+}
+
+#if VTK_MODULE_ENABLE_VTK_FiltersParallelMPI
+// Returns true if `cuts` and the region assignments of `kdtree` are the same as
+// the ones a plan was built with.
+bool vtkOCDSamePartitioning(const std::vector<int>& assignments, vtkBSPCuts* planCuts,
+  vtkBSPCuts* cuts, vtkPKdTree* kdtree)
+{
+  if (planCuts == nullptr || !planCuts->Equals(cuts))
+  {
+    return false;
+  }
+  const int* map = kdtree->GetRegionAssignmentMap();
+  const int length = kdtree->GetRegionAssignmentMapLength();
+  return static_cast<size_t>(length) == assignments.size() &&
+    (length == 0 || std::equal(map, map + length, assignments.begin()));
+}
+
+// MPI counts are ints, so messages are split into chunks of at most this many
+// bytes.
+const vtkIdType vtkOCDMaximumMessageSize = 1 << 30;
+
+// Exchange variable sized buffers between all ranks. `send[r]` is sent to rank
+// r and `recv[r]` is filled with the buffer received from rank r.
+void vtkOCDExchange(vtkMPIController* controller, std::vector<std::vector<char> >& send,
+  std::vector<std::vector<char> >& recv)
+{
+  const int tag = 970143;
+  const int numRanks = controller->GetNumberOfProcesses();
+  const int myRank = controller->GetLocalProcessId();
+
+  std::vector<vtkIdType> sizes(numRanks);
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    sizes[rank] = static_cast<vtkIdType>(send[rank].size());
+  }
+  std::vector<vtkIdType> allSizes(numRanks * numRanks);
+  controller->AllGather(&sizes[0], &allSizes[0], numRanks);
+
+  // requests must not be moved once posted, so count them first.
+  const auto numChunks = [](vtkIdType size) {
+    return static_cast<int>((size + vtkOCDMaximumMessageSize - 1) / vtkOCDMaximumMessageSize);
+  };
+  int numRequests = 0;
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    if (rank != myRank)
+    {
+      numRequests += numChunks(allSizes[rank * numRanks + myRank]);
+      numRequests += numChunks(static_cast<vtkIdType>(send[rank].size()));
+    }
+  }
+
+  recv.assign(numRanks, std::vector<char>());
+  std::vector<vtkMPICommunicator::Request> requests(numRequests);
+  numRequests = 0;
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    const vtkIdType size = allSizes[rank * numRanks + myRank];
+    if (rank != myRank && size > 0)
+    {
+      recv[rank].resize(size);
+      // chunks between the same pair of ranks are matched in the order they
+      // are posted.
+      for (vtkIdType offset = 0; offset < size; offset += vtkOCDMaximumMessageSize)
+      {
+        const vtkIdType length = std::min(size - offset, vtkOCDMaximumMessageSize);
+        controller->NoBlockReceive(
+          &recv[rank][offset], static_cast<int>(length), rank, tag, requests[numRequests++]);
+      }
+    }
+  }
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    const vtkIdType size = static_cast<vtkIdType>(send[rank].size());
+    if (rank != myRank && size > 0)
+    {
+      for (vtkIdType offset = 0; offset < size; offset += vtkOCDMaximumMessageSize)
+      {
+        const vtkIdType length = std::min(size - offset, vtkOCDMaximumMessageSize);
+        controller->NoBlockSend(
+          &send[rank][offset], static_cast<int>(length), rank, tag, requests[numRequests++]);
+      }
+    }
+  }
+  recv[myRank].swap(send[myRank]);
+  if (numRequests > 0)
+  {
+    vtkMPICommunicator::WaitAll(numRequests, &requests[0]);
+  }
+}
+
+void vtkOCDAppend(std::vector<char>& buffer, const void* data, size_t length)
+{
+  const char* bytes = static_cast<const char*>(data);
+  buffer.insert(buffer.end(), bytes, bytes + length);
+}
+
+void vtkOCDAppend(std::vector<char>& buffer, vtkDataObject* dobj)
+{
+  vtkNew<vtkCharArray> marshaled;
+  vtkCommunicator::MarshalDataObject(dobj, marshaled);
+  const vtkIdType length = marshaled->GetNumberOfTuples();
+  vtkOCDAppend(buffer, &length, sizeof(length));
+  vtkOCDAppend(buffer, marshaled->GetPointer(0), static_cast<size_t>(length));
+}
+
+bool vtkOCDRead(const std::vector<char>& buffer, size_t& offset, vtkDataObject* dobj)
+{
+  vtkIdType length;
+  if (offset + sizeof(length) > buffer.size())
+  {
+    return false;
+  }
+  std::memcpy(&length, &buffer[offset], sizeof(length));
+  offset += sizeof(length);
+  if (length < 0 || offset + static_cast<size_t>(length) > buffer.size())
+  {
+    return false;
+  }
+  vtkNew<vtkCharArray> marshaled;
+  marshaled->SetArray(const_cast<char*>(&buffer[offset]), length, /*save=*/1);
+  offset += static_cast<size_t>(length);
+  return vtkCommunicator::UnMarshalDataObject(marshaled, dobj) != 0;
+}
+#endif
+}
+
 //-----------------------------------------------------------------------------
 #if VTK_MODULE_ENABLE_VTK_FiltersParallelMPI
 static void D3UpdateProgress(vtkObject* _D3, unsigned long, void* _distributor, void*)
@@ -66,7 +450,10 @@ vtkOrderedCompositeDistributor::vtkOrderedCompositeDistributor()
   this->PKdTree = NULL;
   this->Controller = NULL;
   this->PassThrough = false;
+  this->ReuseRedistributionPlan = true;
+  this->RedistributionPlanReused = false;
   this->OutputType = NULL;
+  this->Plan = new vtkPlan();
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
@@ -76,6 +463,7 @@ vtkOrderedCompositeDistributor::~vtkOrderedCompositeDistributor()
   this->SetPKdTree(NULL);
   this->SetController(NULL);
   this->SetOutputType(NULL);
+  delete this->Plan;
 }
 
 //-----------------------------------------------------------------------------
@@ -87,6 +475,7 @@ void vtkOrderedCompositeDistributor::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
   os << indent << "OutputType: " << (this->OutputType ? this->OutputType : "(none)") << endl;
+  os << indent << "ReuseRedistributionPlan: " << this->ReuseRedistributionPlan << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -157,6 +546,7 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
     return 1;
   }
 
+  this->RedistributionPlanReused = false;
   if (this->PassThrough || this->Controller == NULL ||
     this->Controller->GetNumberOfProcesses() == 1)
   {
@@ -192,8 +582,47 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
     return 1;
   }
 
+  // Check if the saved plan can be reused. This has to be agreed upon by all
+  // ranks since both paths are collective.
+  vtkMPIController* mpiController = vtkMPIController::SafeDownCast(this->Controller);
+  vtkTypeUInt64 geometryHash = 0;
+  int planStatus[2] = { 0, 0 }; // { use plan, plan valid }
+  if (this->ReuseRedistributionPlan && mpiController &&
+    this->BoundaryMode != SPLIT_BOUNDARY_CELLS && vtkOCDGeometryHash(input, geometryHash))
+  {
+    const vtkPlan& plan = *this->Plan;
+    planStatus[0] = 1;
+    planStatus[1] = (plan.Valid && plan.GeometryHash == geometryHash &&
+                      plan.BoundaryMode == this->BoundaryMode &&
+                      vtkOCDSamePartitioning(
+                        plan.RegionAssignments, plan.Cuts, cuts, this->PKdTree))
+      ? 1
+      : 0;
+  }
+  int reducedPlanStatus[2] = { 0, 0 };
+  this->Controller->AllReduce(planStatus, reducedPlanStatus, 2, vtkCommunicator::MIN_OP);
+  const bool usePlan = reducedPlanStatus[0] == 1;
+  if (usePlan && reducedPlanStatus[1] == 1)
+  {
+    this->RedistributionPlanReused = true;
+    return this->ExchangeAttributes(input, output) ? 1 : 0;
+  }
+  this->Plan->Reset();
+
   this->UpdateProgress(0.01);
 
+  // When saving the plan, tag points and cells with their source rank and id
+  // so we can tell where each point and cell in the output came from.
+  vtkSmartPointer<vtkDataSet> d3Input = input;
+  if (usePlan)
+  {
+    const int myRank = this->Controller->GetLocalProcessId();
+    d3Input.TakeReference(input->NewInstance());
+    d3Input->ShallowCopy(input);
+    vtkOCDAddSourceIds(d3Input->GetPointData(), d3Input->GetNumberOfPoints(), myRank);
+    vtkOCDAddSourceIds(d3Input->GetCellData(), d3Input->GetNumberOfCells(), myRank);
+  }
+
   vtkNew<vtkDistributedDataFilter> d3;
 
   // add progress observer.
@@ -213,7 +642,7 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
       d3->SetBoundaryModeToAssignToAllIntersectingRegions();
       break;
   }
-  d3->SetInputData(input);
+  d3->SetInputData(d3Input);
   d3->SetCuts(cuts);
 
   // We need to pass the region assignments from PKdTree to D3
@@ -247,7 +676,141 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
       return 0;
     }
   }
+
+  if (usePlan)
+  {
+    this->BuildPlan(input, output, geometryHash);
+  }
 #endif
 
   return 1;
 }
+
+//-----------------------------------------------------------------------------
+void vtkOrderedCompositeDistributor::BuildPlan(
+  vtkDataSet* input, vtkDataSet* output, vtkTypeUInt64 geometryHash)
+{
+#if VTK_MODULE_ENABLE_VTK_FiltersParallelMPI
+  vtkMPIController* controller = vtkMPIController::SafeDownCast(this->Controller);
+  const int numRanks = controller->GetNumberOfProcesses();
+  vtkPlan& plan = *this->Plan;
+
+  std::vector<std::vector<vtkIdType> > requestedPointIds, requestedCellIds;
+  const bool valid = vtkOCDSplitSourceIds(output->GetPointData(), output->GetNumberOfPoints(),
+                       numRanks, requestedPointIds, plan.RecvPointIds) &&
+    vtkOCDSplitSourceIds(output->GetCellData(), output->GetNumberOfCells(), numRanks,
+      requestedCellIds, plan.RecvCellIds);
+  output->GetPointData()->RemoveArray(vtkOCDSourceIdsName);
+  output->GetCellData()->RemoveArray(vtkOCDSourceIdsName);
+
+  // let each rank know which of its points and cells it needs to send where.
+  std::vector<std::vector<char> > send(numRanks), recv;
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    const vtkIdType counts[2] = { static_cast<vtkIdType>(requestedPointIds[rank].size()),
+      static_cast<vtkIdType>(requestedCellIds[rank].size()) };
+    if (counts[0] > 0 || counts[1] > 0)
+    {
+      vtkOCDAppend(send[rank], counts, sizeof(counts));
+      vtkOCDAppend(send[rank], requestedPointIds[rank].data(), counts[0] * sizeof(vtkIdType));
+      vtkOCDAppend(send[rank], requestedCellIds[rank].data(), counts[1] * sizeof(vtkIdType));
+    }
+  }
+  vtkOCDExchange(controller, send, recv);
+
+  plan.SendPointIds.assign(numRanks, std::vector<vtkIdType>());
+  plan.SendCellIds.assign(numRanks, std::vector<vtkIdType>());
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    const std::vector<char>& buffer = recv[rank];
+    if (buffer.size() < 2 * sizeof(vtkIdType))
+    {
+      continue;
+    }
+    vtkIdType counts[2];
+    std::memcpy(counts, &buffer[0], sizeof(counts));
+    const vtkIdType* ids = reinterpret_cast<const vtkIdType*>(&buffer[sizeof(counts)]);
+    plan.SendPointIds[rank].assign(ids, ids + counts[0]);
+    plan.SendCellIds[rank].assign(ids + counts[0], ids + counts[0] + counts[1]);
+  }
+
+  plan.Output.TakeReference(output->NewInstance());
+  plan.Output->ShallowCopy(output);
+  vtkOCDKeepGeneratedArrays(plan.Output->GetPointData(), input->GetPointData());
+  vtkOCDKeepGeneratedArrays(plan.Output->GetCellData(), input->GetCellData());
+  plan.GeometryHash = geometryHash;
+  plan.BoundaryMode = this->BoundaryMode;
+  plan.Cuts = vtkSmartPointer<vtkBSPCuts>::New();
+  plan.Cuts->DeepCopy(this->PKdTree->GetCuts());
+  const int* map = this->PKdTree->GetRegionAssignmentMap();
+  plan.RegionAssignments.assign(map, map + this->PKdTree->GetRegionAssignmentMapLength());
+  plan.Valid = valid;
+#else
+  (void)input;
+  (void)output;
+  (void)geometryHash;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+bool vtkOrderedCompositeDistributor::ExchangeAttributes(vtkDataSet* input, vtkDataSet* output)
+{
+#if VTK_MODULE_ENABLE_VTK_FiltersParallelMPI
+  vtkMPIController* controller = vtkMPIController::SafeDownCast(this->Controller);
+  const int numRanks = controller->GetNumberOfProcesses();
+  const vtkPlan& plan = *this->Plan;
+
+  std::vector<std::vector<char> > send(numRanks), recv;
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    if (!plan.SendPointIds[rank].empty() || !plan.SendCellIds[rank].empty())
+    {
+      vtkNew<vtkTable> pointValues;
+      vtkOCDExtract(input->GetPointData(), plan.SendPointIds[rank], pointValues);
+      vtkNew<vtkTable> cellValues;
+      vtkOCDExtract(input->GetCellData(), plan.SendCellIds[rank], cellValues);
+      vtkOCDAppend(send[rank], pointValues);
+      vtkOCDAppend(send[rank], cellValues);
+    }
+  }
+  this->UpdateProgress(0.3);
+  vtkOCDExchange(controller, send, recv);
+  this->UpdateProgress(0.7);
+
+  // exchanged arrays are scattered into new arrays, the arrays generated by
+  // the redistribution are shared with the plan and added last.
+  output->ShallowCopy(plan.Output);
+  output->GetPointData()->Initialize();
+  output->GetCellData()->Initialize();
+  const vtkIdType numPoints = output->GetNumberOfPoints();
+  const vtkIdType numCells = output->GetNumberOfCells();
+  bool status = true;
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    if (recv[rank].empty())
+    {
+      continue;
+    }
+    size_t offset = 0;
+    vtkNew<vtkTable> pointValues;
+    vtkNew<vtkTable> cellValues;
+    if (!vtkOCDRead(recv[rank], offset, pointValues) || !vtkOCDRead(recv[rank], offset, cellValues))
+    {
+      vtkErrorMacro("Failed to read attributes received from rank " << rank);
+      status = false;
+      continue;
+    }
+    vtkOCDScatter(pointValues, plan.RecvPointIds[rank], numPoints, output->GetPointData());
+    vtkOCDScatter(cellValues, plan.RecvCellIds[rank], numCells, output->GetCellData());
+  }
+  vtkOCDAddArrays(plan.Output->GetPointData(), output->GetPointData());
+  vtkOCDAddArrays(plan.Output->GetCellData(), output->GetCellData());
+  vtkOCDCopyActiveAttributes(input->GetPointData(), output->GetPointData());
+  vtkOCDCopyActiveAttributes(input->GetCellData(), output->GetCellData());
+  return status;
+#else
+  (void)input;
+  (void)output;
+  return false;
+#endif
+}
@@ -36,6 +36,14 @@
  * This class also has an optional pass through mode to make it easy to
  * turn ordered compositing on and off.
  *
+ * When the boundary mode does not split cells, the distributor saves the
+ * exchange plan i.e. which points and cells are sent to which rank. If a
+ * subsequent update has the same input geometry and topology and the kd-tree
+ * has the same cuts and region assignments (the kd-tree itself may have been
+ * rebuilt), e.g. when only time-dependent attributes change, the saved
+ * plan is used to exchange the attribute arrays alone instead of redoing the
+ * full redistribution. See ReuseRedistributionPlan.
+ *
 */
 
 #ifndef vtkOrderedCompositeDistributor_h
@@ -113,6 +121,23 @@ public:
   vtkGetMacro(BoundaryMode, int);
   //@}
 
+  //@{
+  /**
+   * When on (default), the redistribution plan is saved and reused for
+   * updates where only attribute arrays changed. This is not supported with
+   * SPLIT_BOUNDARY_CELLS since clipping cells interpolates attributes for the
+   * new points. Changing this flag or the boundary mode discards the saved plan.
+   */
+  vtkSetMacro(ReuseRedistributionPlan, bool);
+  vtkGetMacro(ReuseRedistributionPlan, bool);
+  vtkBooleanMacro(ReuseRedistributionPlan, bool);
+  //@}
+
+  /**
+   * Returns true if the last execution reused a saved redistribution plan.
+   */
+  vtkGetMacro(RedistributionPlanReused, bool);
+
 protected:
   vtkOrderedCompositeDistributor();
   ~vtkOrderedCompositeDistributor() override;
@@ -120,6 +145,8 @@ protected:
   int BoundaryMode;
   char* OutputType;
   bool PassThrough;
+  bool ReuseRedistributionPlan;
+  bool RedistributionPlanReused;
   vtkPKdTree* PKdTree;
   vtkMultiProcessController* Controller;
 
@@ -127,9 +154,25 @@ protected:
   int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Saves the redistribution plan using the source ids tagged on `output`.
+   * Arrays of `output` that are not in `input` were generated by the
+   * redistribution and are saved with the plan.
+   */
+  void BuildPlan(vtkDataSet* input, vtkDataSet* output, vtkTypeUInt64 geometryHash);
+
+  /**
+   * Fills `output` by exchanging the attribute arrays of `input` using the
+   * saved plan.
+   */
+  bool ExchangeAttributes(vtkDataSet* input, vtkDataSet* output);
+
 private:
   vtkOrderedCompositeDistributor(const vtkOrderedCompositeDistributor&) = delete;
   void operator=(const vtkOrderedCompositeDistributor&) = delete;
+
+  class vtkPlan;
+  vtkPlan* Plan;
 };
 
 #endif // vtkOrderedCompositeDistributor_h
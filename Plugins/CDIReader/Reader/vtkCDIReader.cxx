@@ -52,6 +52,7 @@
 #include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -59,7 +60,14 @@
 #include "cdi.h"
 #include "vtk_netcdf.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <fstream>
+#include <functional>
+#include <mutex>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -128,6 +136,10 @@ namespace
 //----------------------------------------------------------------------------
 //  CDI helper functions
 //----------------------------------------------------------------------------
+// Neither cdilib nor netCDF are thread-safe: variables are converted
+// concurrently, but all reads go through this lock.
+std::mutex cdi_mutex;
+
 void cdi_set_cur(CDIVar* cdiVar, int Timestep, int level)
 {
   cdiVar->Timestep = Timestep;
@@ -137,6 +149,7 @@ void cdi_set_cur(CDIVar* cdiVar, int Timestep, int level)
 template <class T>
 void cdi_get_part(CDIVar* cdiVar, int start, size_t size, T* buffer, int nlevels)
 {
+  std::lock_guard<std::mutex> lock(cdi_mutex);
   size_t nmiss;
   int memtype = 0;
   int nrecs = streamInqTimestep(cdiVar->StreamID, cdiVar->Timestep);
@@ -410,6 +423,7 @@ vtkCDIReader::vtkCDIReader()
 #endif
 
   this->Output = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  this->GridCacheDirectory = nullptr;
 
   this->SetDefaults();
 
@@ -479,6 +493,7 @@ vtkCDIReader::~vtkCDIReader()
 {
   vtkDebugMacro("Destructing vtkCDIReader..." << endl);
   this->SetFileName(nullptr);
+  this->SetGridCacheDirectory(nullptr);
 
   if (this->StreamID >= 0)
   {
@@ -824,24 +839,7 @@ int vtkCDIReader::RequestData(vtkInformation* vtkNotUsed(reqInfo),
   vtkDebugMacro("dTimeTemp: " << dTimeTemp << endl);
   this->DTime = dTimeTemp;
 
-  for (int var = 0; var < this->NumberOfCellVars; var++)
-  {
-    if (this->GetCellArrayStatus(this->Internals->CellVars[var].Name))
-    {
-      vtkDebugMacro("Loading Cell Variable: " << this->Internals->CellVars[var].Name << endl);
-      this->LoadCellVarData(var, this->DTime);
-      output->GetCellData()->AddArray(this->CellVarDataArray[var]);
-    }
-  }
-  for (int var = 0; var < this->NumberOfPointVars; var++)
-  {
-    if (this->GetPointArrayStatus(this->Internals->PointVars[var].Name))
-    {
-      vtkDebugMacro("Loading Point Variable: " << var << endl);
-      this->LoadPointVarData(var, this->DTime);
-      output->GetPointData()->AddArray(this->PointVarDataArray[var]);
-    }
-  }
+  this->LoadSelectedVarData(this->DTime, true);
 
   for (int var = 0; var < this->NumberOfDomainVars; var++)
   {
@@ -953,24 +951,7 @@ int vtkCDIReader::RegenerateGeometry()
   output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), dTimeTemp);
   this->DTime = dTimeTemp;
 
-  for (int var = 0; var < this->NumberOfCellVars; var++)
-  {
-    if (this->GetCellArrayStatus(this->Internals->CellVars[var].Name))
-    {
-      vtkDebugMacro("Loading Cell Variable: " << this->Internals->CellVars[var].Name << endl);
-      this->LoadCellVarData(var, this->DTime);
-      output->GetCellData()->AddArray(this->CellVarDataArray[var]);
-    }
-  }
-  for (int var = 0; var < this->NumberOfPointVars; var++)
-  {
-    if (this->GetPointArrayStatus(this->Internals->PointVars[var].Name))
-    {
-      vtkDebugMacro("Loading Point Variable: " << var << endl);
-      this->LoadPointVarData(var, this->DTime);
-      output->GetPointData()->AddArray(this->PointVarDataArray[var]);
-    }
-  }
+  this->LoadSelectedVarData(this->DTime, true);
 
   for (int var = 0; var < this->NumberOfDomainVars; var++)
   {
@@ -1685,21 +1666,40 @@ int vtkCDIReader::ConstructGridGeometry()
   vtkDebugMacro("Starting grid reconstruction ..." << endl);
   int size = this->NumberLocalCells * this->PointsPerCell;
   int size2 = this->NumberAllCells * this->PointsPerCell;
+  this->DepthVar = new double[this->MaximumNVertLevels];
+  CHECK_NEW(this->DepthVar);
+  zaxisInqLevels(this->ZAxisID, this->DepthVar);
+  this->OrigConnections = new int[size];
+  CHECK_NEW(this->OrigConnections);
+
+  // try the on-disk grid cache first. With data decomposition, the point
+  // mapping between processes is needed too, which is not cached.
+  std::string cacheKey;
+  std::string cacheFileName;
+  if (!this->Decomposition)
+  {
+    cacheFileName = this->GetGridCacheFileName(cacheKey);
+  }
+  if (!cacheFileName.empty() && this->ReadGridCache(cacheFileName, cacheKey, size))
+  {
+    vtkDebugMacro("Grid read from cache " << cacheFileName << endl);
+    this->GridReconstructed = true;
+    this->ReconstructNew = false;
+    this->VertexIds = new int[size];
+    CHECK_NEW(this->VertexIds);
+    return 1;
+  }
+
   this->CLonVertices = new double[size];
   this->CLatVertices = new double[size];
-  this->DepthVar = new double[this->MaximumNVertLevels];
   CHECK_NEW(this->CLonVertices);
   CHECK_NEW(this->CLatVertices);
-  CHECK_NEW(this->DepthVar);
 
   gridInqXboundsPart(
     this->GridID, (this->BeginCell * this->PointsPerCell), size, this->CLonVertices);
   gridInqYboundsPart(
     this->GridID, (this->BeginCell * this->PointsPerCell), size, this->CLatVertices);
-  zaxisInqLevels(this->ZAxisID, this->DepthVar);
   char units[CDI_MAX_NAME];
-  this->OrigConnections = new int[size];
-  CHECK_NEW(this->OrigConnections);
   int* new_cells = new int[2];
 
   if (this->ProjectionMode != 4)
@@ -1747,6 +1747,10 @@ int vtkCDIReader::ConstructGridGeometry()
   {
     this->MirrorMesh();
   }
+  if (!cacheFileName.empty())
+  {
+    this->WriteGridCache(cacheFileName, cacheKey, size);
+  }
   this->GridReconstructed = true;
   this->ReconstructNew = false;
 
@@ -1819,6 +1823,140 @@ int vtkCDIReader::ConstructGridGeometry()
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Returns the name of the grid cache file for the current grid, local cell
+// range and projection, or an empty string when grids are not cached. `key`
+// is set to a description of the grid which is stored in the file to detect
+// hash collisions and stale files.
+//----------------------------------------------------------------------------
+std::string vtkCDIReader::GetGridCacheFileName(std::string& key)
+{
+  if (!this->GridCacheDirectory || !this->GridCacheDirectory[0])
+  {
+    return std::string();
+  }
+
+  std::ostringstream keyStream;
+  unsigned char uuid[CDI_UUID_SIZE] = { 0 };
+  gridInqUUID(this->GridID, uuid);
+  bool hasUUID = false;
+  for (int i = 0; i < CDI_UUID_SIZE; i++)
+  {
+    hasUUID = hasUUID || uuid[i] != 0;
+  }
+  if (hasUUID)
+  {
+    keyStream << "uuid ";
+    for (int i = 0; i < CDI_UUID_SIZE; i++)
+    {
+      keyStream << static_cast<int>(uuid[i]) << ".";
+    }
+  }
+  else
+  {
+    std::string fname = vtksys::SystemTools::CollapseFullPath(this->FileName);
+    keyStream << "file " << fname << " " << vtksys::SystemTools::ModifiedTime(fname);
+  }
+  keyStream << " cells " << this->NumberAllCells << " " << this->PointsPerCell << " "
+            << this->BeginCell << " " << this->NumberLocalCells << " projection "
+            << this->ProjectionMode;
+  key = keyStream.str();
+
+  std::ostringstream fname;
+  fname << this->GridCacheDirectory << "/cdigrid-" << std::hex << std::hash<std::string>()(key)
+        << ".bin";
+  return fname.str();
+}
+
+//----------------------------------------------------------------------------
+// Read the reconstructed grid from the cache file. Returns false if the file
+// does not exist or does not match the current grid.
+//----------------------------------------------------------------------------
+bool vtkCDIReader::ReadGridCache(const std::string& fileName, const std::string& key, int size)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+
+  // header: key length, connectivity size, number of cells and points.
+  int header[4];
+  file.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!file || header[0] != static_cast<int>(key.size()))
+  {
+    return false;
+  }
+  std::string fileKey(key.size(), '\0');
+  file.read(&fileKey[0], fileKey.size());
+  if (!file || fileKey != key || header[1] != size || header[2] < 0 || header[3] < 0)
+  {
+    return false;
+  }
+
+  const int numberLocalCells = header[2];
+  const int numberLocalPoints = header[3];
+  double* pointX = new double[numberLocalPoints];
+  double* pointY = new double[numberLocalPoints];
+  double* pointZ = new double[numberLocalPoints];
+  file.read(reinterpret_cast<char*>(this->OrigConnections), sizeof(int) * size);
+  file.read(reinterpret_cast<char*>(pointX), sizeof(double) * numberLocalPoints);
+  file.read(reinterpret_cast<char*>(pointY), sizeof(double) * numberLocalPoints);
+  file.read(reinterpret_cast<char*>(pointZ), sizeof(double) * numberLocalPoints);
+  if (!file)
+  {
+    delete[] pointX;
+    delete[] pointY;
+    delete[] pointZ;
+    return false;
+  }
+
+  this->NumberLocalCells = numberLocalCells;
+  this->NumberLocalPoints = numberLocalPoints;
+  this->PointX = pointX;
+  this->PointY = pointY;
+  this->PointZ = pointZ;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Write the reconstructed grid to the cache file. The file is written under a
+// temporary name and renamed so that concurrent readers never see a partial
+// file.
+//----------------------------------------------------------------------------
+void vtkCDIReader::WriteGridCache(const std::string& fileName, const std::string& key, int size)
+{
+  vtksys::SystemTools::MakeDirectory(this->GridCacheDirectory);
+
+  std::ostringstream tmpName;
+  tmpName << fileName << "." << this->Piece << ".tmp";
+  {
+    std::ofstream file(tmpName.str().c_str(), std::ios::out | std::ios::binary);
+    int header[4] = { static_cast<int>(key.size()), size, this->NumberLocalCells,
+      this->NumberLocalPoints };
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(key.c_str(), key.size());
+    file.write(reinterpret_cast<const char*>(this->OrigConnections), sizeof(int) * size);
+    file.write(
+      reinterpret_cast<const char*>(this->PointX), sizeof(double) * this->NumberLocalPoints);
+    file.write(
+      reinterpret_cast<const char*>(this->PointY), sizeof(double) * this->NumberLocalPoints);
+    file.write(
+      reinterpret_cast<const char*>(this->PointZ), sizeof(double) * this->NumberLocalPoints);
+    if (!file)
+    {
+      vtkWarningMacro("Could not write grid cache file " << tmpName.str());
+      file.close();
+      vtksys::SystemTools::RemoveFile(tmpName.str());
+      return;
+    }
+  }
+  if (!vtksys::SystemTools::RenameFile(tmpName.str().c_str(), fileName.c_str()))
+  {
+    vtksys::SystemTools::RemoveFile(tmpName.str());
+  }
+}
+
 //----------------------------------------------------------------------------
 // Allocate into sphere view of geometry
 // This is work in progress, but as almost all variables are cell based, it
@@ -2461,8 +2599,6 @@ void vtkCDIReader::OutputCells(bool init)
 //----------------------------------------------------------------------------
 int vtkCDIReader::LoadPointVarData(int variableIndex, double dTimeStep)
 {
-  this->PointDataSelected = variableIndex;
-
   vtkDataArray* dataArray = this->PointVarDataArray[variableIndex];
 
   // Allocate data array for this variable
@@ -2495,13 +2631,69 @@ int vtkCDIReader::LoadPointVarData(int variableIndex, double dTimeStep)
   return success;
 }
 
+//----------------------------------------------------------------------------
+//  Load the data for all selected cell and point variables. Variables are
+//  read and converted concurrently, one task per variable.
+//----------------------------------------------------------------------------
+void vtkCDIReader::LoadSelectedVarData(double dTimeStep, bool addToOutput)
+{
+  // (is point variable, variable index)
+  std::vector<std::pair<bool, int> > vars;
+  for (int var = 0; var < this->NumberOfCellVars; var++)
+  {
+    if (this->CellDataArraySelection->ArrayIsEnabled(this->Internals->CellVars[var].Name))
+    {
+      vtkDebugMacro("Loading Cell Variable: " << this->Internals->CellVars[var].Name << endl);
+      vars.push_back(std::make_pair(false, var));
+      this->CellDataSelected = var;
+    }
+  }
+  for (int var = 0; var < this->NumberOfPointVars; var++)
+  {
+    if (this->PointDataArraySelection->ArrayIsEnabled(this->Internals->PointVars[var].Name))
+    {
+      vtkDebugMacro("Loading Point Variable: " << this->Internals->PointVars[var].Name << endl);
+      vars.push_back(std::make_pair(true, var));
+      this->PointDataSelected = var;
+    }
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(vars.size()), 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      if (vars[cc].first)
+      {
+        this->LoadPointVarData(vars[cc].second, dTimeStep);
+      }
+      else
+      {
+        this->LoadCellVarData(vars[cc].second, dTimeStep);
+      }
+    }
+  });
+
+  if (!addToOutput)
+  {
+    return;
+  }
+  for (size_t cc = 0; cc < vars.size(); ++cc)
+  {
+    if (vars[cc].first)
+    {
+      this->Output->GetPointData()->AddArray(this->PointVarDataArray[vars[cc].second]);
+    }
+    else
+    {
+      this->Output->GetCellData()->AddArray(this->CellVarDataArray[vars[cc].second]);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 //  Load the data for a cell variable specified.
 //----------------------------------------------------------------------------
 int vtkCDIReader::LoadCellVarData(int variableIndex, double dTimeStep)
 {
-  this->CellDataSelected = variableIndex;
-
   vtkDataArray* dataArray = this->CellVarDataArray[variableIndex];
   // Allocate data array for this variable
   if (dataArray == nullptr)
@@ -3066,23 +3258,7 @@ void vtkCDIReader::SetVerticalLevel(int level)
     return;
   }
 
-  for (int var = 0; var < this->NumberOfPointVars; var++)
-  {
-    if (this->PointDataArraySelection->GetArraySetting(var))
-    {
-      vtkDebugMacro("Loading Point Variable: " << this->Internals->PointVars[var].Name << endl);
-      this->LoadPointVarData(var, this->DTime);
-    }
-  }
-
-  for (int var = 0; var < this->NumberOfCellVars; var++)
-  {
-    if (this->CellDataArraySelection->GetArraySetting(var))
-    {
-      vtkDebugMacro("Loading Cell Variable: " << this->Internals->CellVars[var].Name << endl);
-      this->LoadCellVarData(var, this->DTime);
-    }
-  }
+  this->LoadSelectedVarData(this->DTime, false);
 
   this->PointDataArraySelection->Modified();
   this->CellDataArraySelection->Modified();
@@ -3266,6 +3442,8 @@ void vtkCDIReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UseTopography: " << (this->IncludeTopography ? "ON" : "OFF") << endl;
   os << indent << "SetInvertTopography: " << (this->InvertedTopography ? "ON" : "OFF") << endl;
   os << indent << "VerticalLevel: " << this->VerticalLevelSelected << "\n";
+  os << indent << "GridCacheDirectory: "
+     << (this->GridCacheDirectory ? this->GridCacheDirectory : "(none)") << "\n";
   os << indent << "VerticalLevelRange: " << this->VerticalLevelRange[0] << ","
      << this->VerticalLevelRange[1] << endl;
   os << indent << "LayerThicknessRange: " << this->LayerThicknessRange[0] << ","
@@ -16,9 +16,12 @@
 
 #include "vtkAlgorithmOutput.h"
 #include "vtkAppendCompositeDataLeaves.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositePolyDataMapper2.h"
+#include "vtkDataObjectTypes.h"
 #include "vtkFieldData.h"
 #include "vtkGeometryRepresentation.h"
 #include "vtkInformation.h"
@@ -38,10 +41,19 @@
 #include "vtkStreamingParticlesPriorityQueue.h"
 #include "vtkUnsignedIntArray.h"
 
+#include <vtksys/SystemTools.hxx>
+
 #include <algorithm>
 #include <assert.h>
+#include <fstream>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
 
 static char const BLOCKS_TO_PURGE_ARRAY_NAME[] = "__blocks_to_purge";
+static char const BLOCKS_TO_CACHE_ARRAY_NAME[] = "__blocks_to_cache";
+static char const BLOCKS_TO_EVICT_ARRAY_NAME[] = "__blocks_to_evict";
 
 static inline void purge_blocks(
   vtkMultiBlockDataSet* data, const std::set<unsigned int>& blocksToPurge)
@@ -64,6 +76,167 @@ static inline void purge_blocks(
   }
 }
 
+// Locates the block with the given block index, using the same numbering as
+// vtkStreamingParticlesPriorityQueue.
+static inline bool locate_block(
+  vtkMultiBlockDataSet* data, unsigned int block_index, vtkMultiBlockDataSet*& parent,
+  unsigned int& index)
+{
+  unsigned int num_levels = data->GetNumberOfBlocks();
+  for (unsigned int level = 0; level < num_levels; level++)
+  {
+    vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(data->GetBlock(level));
+    unsigned int num_blocks = mb ? mb->GetNumberOfBlocks() : 0;
+    if (block_index < num_blocks)
+    {
+      parent = mb;
+      index = block_index;
+      return true;
+    }
+    block_index -= num_blocks;
+  }
+  return false;
+}
+
+static vtkSmartPointer<vtkUnsignedIntArray> gather_block_list(
+  vtkMultiProcessController* controller, vtkUnsignedIntArray* localArray, const char* name)
+{
+  vtkSmartPointer<vtkUnsignedIntArray> globalArray = vtkSmartPointer<vtkUnsignedIntArray>::New();
+  globalArray->SetNumberOfComponents(2);
+  controller->GatherV(localArray, globalArray, 0);
+  globalArray->SetName(name);
+  return globalArray;
+}
+
+class vtkStreamingParticlesRepresentation::vtkInternals
+{
+public:
+  typedef std::pair<unsigned int, unsigned int> BlockKey;
+
+  // Data-server side bookkeeping, all sizes are in KiB. `Delivered` are the
+  // blocks this process streamed that are currently rendered. `Parked` are the
+  // blocks that were purged from the view but are still held by the block
+  // cache on the rendering nodes, most recently parked first.
+  std::map<unsigned int, unsigned long> Delivered;
+  std::list<std::pair<unsigned int, unsigned long> > Parked;
+  unsigned long ParkedSize;
+  std::vector<unsigned int> StreamingRestore;
+
+  // Blocks this process parked that the rendering nodes failed to restore
+  // from the block cache. They are requested from the pipeline again.
+  std::vector<unsigned int> Reload;
+
+  // Rendering side block cache, keyed by (process, block). Blocks are either
+  // held in memory or marshaled to the spill file.
+  struct CacheEntry
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    int DataType;
+    std::streamoff Offset;
+    vtkIdType Length;
+  };
+  std::map<BlockKey, CacheEntry> Cache;
+  std::string SpillFileName;
+  std::fstream Spill;
+
+  vtkInternals()
+    : ParkedSize(0)
+  {
+  }
+
+  ~vtkInternals() { this->Reset(); }
+
+  void Reset()
+  {
+    this->Delivered.clear();
+    this->Parked.clear();
+    this->ParkedSize = 0;
+    this->StreamingRestore.clear();
+    this->Reload.clear();
+    this->Cache.clear();
+    if (this->Spill.is_open())
+    {
+      this->Spill.close();
+      vtksys::SystemTools::RemoveFile(this->SpillFileName);
+    }
+    this->SpillFileName.clear();
+  }
+
+  bool OpenSpill(const char* fname)
+  {
+    if (this->Spill.is_open() && this->SpillFileName == fname)
+    {
+      return true;
+    }
+    if (this->Spill.is_open())
+    {
+      // the spill file changed, blocks already spilled stay in the old one.
+      return false;
+    }
+    this->Spill.open(fname, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    this->SpillFileName = fname;
+    return this->Spill.is_open();
+  }
+
+  void Store(const BlockKey& key, vtkDataObject* block, const char* spillFileName)
+  {
+    CacheEntry entry;
+    entry.DataType = block->GetDataObjectType();
+    entry.Offset = 0;
+    entry.Length = 0;
+    if (spillFileName && spillFileName[0] && this->OpenSpill(spillFileName))
+    {
+      vtkNew<vtkCharArray> marshaled;
+      if (vtkCommunicator::MarshalDataObject(block, marshaled.GetPointer()))
+      {
+        // space used by blocks restored from the spill file is only reclaimed
+        // when the cache is reset.
+        this->Spill.seekp(0, std::ios::end);
+        entry.Offset = static_cast<std::streamoff>(this->Spill.tellp());
+        entry.Length = marshaled->GetNumberOfTuples();
+        this->Spill.write(marshaled->GetPointer(0), static_cast<std::streamsize>(entry.Length));
+        if (this->Spill.good())
+        {
+          this->Cache[key] = entry;
+          return;
+        }
+        this->Spill.clear();
+      }
+    }
+    entry.Data = block;
+    this->Cache[key] = entry;
+  }
+
+  vtkSmartPointer<vtkDataObject> Load(const BlockKey& key)
+  {
+    std::map<BlockKey, CacheEntry>::iterator iter = this->Cache.find(key);
+    if (iter == this->Cache.end())
+    {
+      return nullptr;
+    }
+    vtkSmartPointer<vtkDataObject> data = iter->second.Data;
+    if (!data && this->Spill.is_open())
+    {
+      const CacheEntry& entry = iter->second;
+      vtkNew<vtkCharArray> marshaled;
+      marshaled->SetNumberOfTuples(entry.Length);
+      this->Spill.seekg(entry.Offset);
+      this->Spill.read(marshaled->GetPointer(0), static_cast<std::streamsize>(entry.Length));
+      if (this->Spill.good())
+      {
+        data.TakeReference(vtkDataObjectTypes::NewDataObject(entry.DataType));
+        if (data && !vtkCommunicator::UnMarshalDataObject(marshaled.GetPointer(), data))
+        {
+          data = nullptr;
+        }
+      }
+      this->Spill.clear();
+    }
+    this->Cache.erase(iter);
+    return data;
+  }
+};
+
 vtkStandardNewMacro(vtkStreamingParticlesRepresentation);
 //----------------------------------------------------------------------------
 vtkStreamingParticlesRepresentation::vtkStreamingParticlesRepresentation()
@@ -72,6 +245,9 @@ vtkStreamingParticlesRepresentation::vtkStreamingParticlesRepresentation()
   this->InStreamingUpdate = false;
   this->UseOutline = false;
   this->StreamingRequestSize = 1;
+  this->BlockCacheSize = 256;
+  this->BlockCacheSpillFileName = nullptr;
+  this->Internals = new vtkInternals();
 
   this->PriorityQueue = vtkSmartPointer<vtkStreamingParticlesPriorityQueue>::New();
   this->PriorityQueue->UseBlockDetailInformationOn();
@@ -89,6 +265,8 @@ vtkStreamingParticlesRepresentation::vtkStreamingParticlesRepresentation()
 //----------------------------------------------------------------------------
 vtkStreamingParticlesRepresentation::~vtkStreamingParticlesRepresentation()
 {
+  delete this->Internals;
+  this->SetBlockCacheSpillFileName(nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -209,12 +387,25 @@ int vtkStreamingParticlesRepresentation::ProcessViewRequest(
       assert(this->RenderedData != NULL);
       vtkStreamingStatusMacro(<< this << ": received new piece.");
 
-      vtkSmartPointer<vtkUnsignedIntArray> array = vtkUnsignedIntArray::SafeDownCast(
-        piece->GetFieldData()->GetArray(BLOCKS_TO_PURGE_ARRAY_NAME));
+      vtkFieldData* fd = piece->GetFieldData();
+      vtkMultiBlockDataSet* data = vtkMultiBlockDataSet::SafeDownCast(this->RenderedData);
+
+      // park blocks in the block cache before purging them.
+      vtkSmartPointer<vtkUnsignedIntArray> toCache =
+        vtkUnsignedIntArray::SafeDownCast(fd->GetArray(BLOCKS_TO_CACHE_ARRAY_NAME));
+      vtkSmartPointer<vtkUnsignedIntArray> toEvict =
+        vtkUnsignedIntArray::SafeDownCast(fd->GetArray(BLOCKS_TO_EVICT_ARRAY_NAME));
+      fd->RemoveArray(BLOCKS_TO_CACHE_ARRAY_NAME);
+      fd->RemoveArray(BLOCKS_TO_EVICT_ARRAY_NAME);
+      this->CacheBlocks(data, toCache, toEvict);
+
+      // note: blocks parked in the block cache are restored by each process
+      // in StreamingUpdate().
+      vtkSmartPointer<vtkUnsignedIntArray> array =
+        vtkUnsignedIntArray::SafeDownCast(fd->GetArray(BLOCKS_TO_PURGE_ARRAY_NAME));
       if (array != NULL)
       {
-        piece->GetFieldData()->RemoveArray(BLOCKS_TO_PURGE_ARRAY_NAME);
-        vtkMultiBlockDataSet* data = vtkMultiBlockDataSet::SafeDownCast(this->RenderedData);
+        fd->RemoveArray(BLOCKS_TO_PURGE_ARRAY_NAME);
         std::set<unsigned int> blocksToPurge;
         for (int i = 0; i < array->GetNumberOfTuples(); ++i)
         {
@@ -379,6 +570,7 @@ int vtkStreamingParticlesRepresentation::RequestData(
   if (!this->GetInStreamingUpdate())
   {
     this->RenderedData = 0;
+    this->Internals->Reset();
 
     // provide the mapper with an empty input. This is needed only because
     // mappers die when input is NULL, currently.
@@ -397,6 +589,12 @@ bool vtkStreamingParticlesRepresentation::StreamingUpdate(const double view_plan
   // update the priority queue, if needed.
   this->PriorityQueue->Update(view_planes);
 
+  // blocks this process delivered that are purged now are parked in the block
+  // cache on the rendering nodes, if there's room for them.
+  vtkNew<vtkUnsignedIntArray> localCacheArray;
+  vtkNew<vtkUnsignedIntArray> localEvictArray;
+  this->ParkPurgedBlocks(localCacheArray.GetPointer(), localEvictArray.GetPointer());
+
   // FIXME: This will not work in client-server mode.
   // For this demo, we'll just use the local data object.
   if (this->RenderedData && this->PriorityQueue->GetBlocksToPurge().size() > 0)
@@ -407,6 +605,7 @@ bool vtkStreamingParticlesRepresentation::StreamingUpdate(const double view_plan
 
     vtkMultiBlockDataSet* data = vtkMultiBlockDataSet::SafeDownCast(this->RenderedData);
 
+    this->CacheBlocks(data, localCacheArray.GetPointer(), localEvictArray.GetPointer());
     purge_blocks(data, blocksToPurge);
 
     this->RenderedData->Modified();
@@ -435,63 +634,272 @@ bool vtkStreamingParticlesRepresentation::StreamingUpdate(const double view_plan
   controller->GatherV(localPurgeArray, globalPurgeArray, 0);
   globalPurgeArray->SetName(BLOCKS_TO_PURGE_ARRAY_NAME);
 
-  int needsToStream = !this->PriorityQueue->IsEmpty();
-  int allNeedToStream;
-  controller->AllReduce(&needsToStream, &allNeedToStream, 1, vtkCommunicator::LOGICAL_OR_OP);
-  // If this process doesn't need to fetch another block, return without executing the pipeline
-  // The return value should be true if ANY process needs to fetch another block
-  if (!needsToStream)
+  // determine if we need to stream any blocks. Blocks that are parked in the
+  // block cache are restored by the rendering nodes instead.
+  int needsToStream = !this->PriorityQueue->IsEmpty() || !this->Internals->Reload.empty();
+  bool haveBlocks = needsToStream && this->DetermineBlocksToStream();
+
+  // like purged blocks, the blocks this process parked are restored in the
+  // local data object (see the FIXME above), from this process' own ledger.
+  // Only the root process sends block lists with the piece, so restore lists
+  // would never reach the other processes.
+  const unsigned int myid = static_cast<unsigned int>(controller->GetLocalProcessId());
+  vtkNew<vtkUnsignedIntArray> localRestoreArray;
+  localRestoreArray->SetNumberOfComponents(2);
+  for (size_t cc = 0; cc < this->Internals->StreamingRestore.size(); ++cc)
   {
-    if (controller->GetLocalProcessId() == 0 && globalPurgeArray->GetNumberOfTuples() > 0)
-    {
-      this->ProcessedPiece->GetFieldData()->AddArray(globalPurgeArray);
-    }
-    return (allNeedToStream == 0) ? false : true;
+    unsigned int tuple[2] = { myid, this->Internals->StreamingRestore[cc] };
+    localRestoreArray->InsertNextTypedTuple(tuple);
+  }
+  this->Internals->StreamingRestore.clear();
+  if (this->RenderedData && localRestoreArray->GetNumberOfTuples() > 0)
+  {
+    this->RestoreBlocks(
+      vtkMultiBlockDataSet::SafeDownCast(this->RenderedData), localRestoreArray.GetPointer());
   }
 
-  // determine if we need to stream any blocks.
-  if (!this->DetermineBlocksToStream())
+  std::vector<vtkSmartPointer<vtkUnsignedIntArray> > globalCacheArrays;
+  globalCacheArrays.push_back(
+    gather_block_list(controller, localCacheArray.GetPointer(), BLOCKS_TO_CACHE_ARRAY_NAME));
+  globalCacheArrays.push_back(
+    gather_block_list(controller, localEvictArray.GetPointer(), BLOCKS_TO_EVICT_ARRAY_NAME));
+
+  // The block cache requests must reach the rendering nodes even if no process
+  // streams a new block, otherwise they'd go out of sync with the ledger.
+  int hasCacheRequests =
+    localCacheArray->GetNumberOfTuples() > 0 || localEvictArray->GetNumberOfTuples() > 0;
+  int needs[2] = { haveBlocks ? 1 : 0, hasCacheRequests };
+  int allNeed[2];
+  controller->AllReduce(needs, allNeed, 2, vtkCommunicator::LOGICAL_OR_OP);
+  if (allNeed[0] == 0 && allNeed[1] == 0)
   {
     // nothing to stream at the moment.
     return false;
   }
 
-  // We've determined we need to request something. Do it.
-  this->InStreamingUpdate = true;
-  vtkStreamingStatusMacro(<< this << ": doing streaming-update.");
+  if (haveBlocks && !this->StreamingRequest.empty())
+  {
+    // We've determined we need to request something. Do it.
+    this->InStreamingUpdate = true;
+    vtkStreamingStatusMacro(<< this << ": doing streaming-update.");
+
+    // This ensure that the representation re-executes.
+    this->MarkModified();
 
-  // This ensure that the representation re-executes.
-  this->MarkModified();
+    // Execute the pipeline.
+    this->Update();
 
-  // Execute the pipeline.
-  this->Update();
+    // remember the size of the blocks we delivered, for the block cache.
+    vtkMultiBlockDataSet* piece = vtkMultiBlockDataSet::SafeDownCast(this->ProcessedPiece);
+    for (size_t cc = 0; piece != NULL && cc < this->StreamingRequest.size(); ++cc)
+    {
+      vtkMultiBlockDataSet* parent = NULL;
+      unsigned int index = 0;
+      const unsigned int cid = static_cast<unsigned int>(this->StreamingRequest[cc]);
+      if (locate_block(piece, cid, parent, index) && parent->GetBlock(index))
+      {
+        this->Internals->Delivered[cid] = parent->GetBlock(index)->GetActualMemorySize();
+      }
+    }
 
-  if (controller->GetLocalProcessId() == 0 && globalPurgeArray->GetNumberOfTuples() > 0)
+    this->InStreamingUpdate = false;
+  }
+  else
   {
-    this->ProcessedPiece->GetFieldData()->AddArray(globalPurgeArray);
+    // nothing new for this process, or only blocks the rendering nodes restore
+    // from the block cache: deliver an empty piece. ProcessedPiece still holds
+    // the last piece streamed, which would otherwise be appended again.
+    vtkNew<vtkMultiBlockDataSet> clone;
+    vtkMultiBlockDataSet* structure = vtkMultiBlockDataSet::SafeDownCast(this->ProcessedPiece);
+    clone->CopyStructure(structure ? structure : this->ProcessedData.GetPointer());
+    this->ProcessedPiece = clone.GetPointer();
   }
 
-  this->InStreamingUpdate = false;
+  // the block lists go with the piece even when this process has no blocks,
+  // so that the cache requests of the other processes reach the rendering
+  // nodes.
+  if (controller->GetLocalProcessId() == 0)
+  {
+    this->AddBlockLists(globalPurgeArray, globalCacheArrays);
+  }
   return true;
 }
 
+//----------------------------------------------------------------------------
+void vtkStreamingParticlesRepresentation::AddBlockLists(vtkUnsignedIntArray* purgeArray,
+  const std::vector<vtkSmartPointer<vtkUnsignedIntArray> >& cacheArrays)
+{
+  vtkFieldData* fd = this->ProcessedPiece->GetFieldData();
+  if (purgeArray->GetNumberOfTuples() > 0)
+  {
+    fd->AddArray(purgeArray);
+  }
+  for (size_t cc = 0; cc < cacheArrays.size(); ++cc)
+  {
+    if (cacheArrays[cc]->GetNumberOfTuples() > 0)
+    {
+      fd->AddArray(cacheArrays[cc]);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 bool vtkStreamingParticlesRepresentation::DetermineBlocksToStream()
 {
-  assert(this->PriorityQueue->IsEmpty() == false);
   assert(this->StreamingRequestSize > 0);
   this->StreamingRequest.clear();
+  this->Internals->StreamingRestore.clear();
 
-  for (int jj = 0; jj < this->StreamingRequestSize; jj++)
+  vtkInternals& internals = *this->Internals;
+  for (size_t cc = 0; cc < internals.Reload.size(); ++cc)
+  {
+    vtkStreamingStatusMacro(<< this << ": requesting block lost by the cache: "
+                            << internals.Reload[cc]);
+    this->StreamingRequest.push_back(static_cast<int>(internals.Reload[cc]));
+  }
+  internals.Reload.clear();
+
+  for (int jj = 0; jj < this->StreamingRequestSize && !this->PriorityQueue->IsEmpty(); jj++)
   {
     unsigned int cid = this->PriorityQueue->Pop();
-    if (cid != VTK_UNSIGNED_INT_MAX)
+    if (cid == VTK_UNSIGNED_INT_MAX)
+    {
+      continue;
+    }
+
+    std::list<std::pair<unsigned int, unsigned long> >::iterator iter = internals.Parked.begin();
+    while (iter != internals.Parked.end() && iter->first != cid)
+    {
+      ++iter;
+    }
+    if (iter != internals.Parked.end())
+    {
+      vtkStreamingStatusMacro(<< this << ": restoring cached block: " << cid);
+      internals.ParkedSize -= iter->second;
+      internals.Delivered[cid] = iter->second;
+      internals.Parked.erase(iter);
+      internals.StreamingRestore.push_back(cid);
+    }
+    else
     {
       vtkStreamingStatusMacro(<< this << ": requesting blocks: " << cid);
       this->StreamingRequest.push_back(static_cast<int>(cid));
     }
   }
-  return this->StreamingRequest.size() > 0;
+  return this->StreamingRequest.size() > 0 || internals.StreamingRestore.size() > 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkStreamingParticlesRepresentation::ParkPurgedBlocks(
+  vtkUnsignedIntArray* toCache, vtkUnsignedIntArray* toEvict)
+{
+  toCache->SetNumberOfComponents(2);
+  toEvict->SetNumberOfComponents(2);
+
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const unsigned int myid = static_cast<unsigned int>(controller->GetLocalProcessId());
+  const unsigned long budget = static_cast<unsigned long>(this->BlockCacheSize) * 1024 /
+    static_cast<unsigned long>(controller->GetNumberOfProcesses());
+
+  vtkInternals& internals = *this->Internals;
+  const std::set<unsigned int>& toPurge = this->PriorityQueue->GetBlocksToPurge();
+  for (std::set<unsigned int>::const_iterator itr = toPurge.begin(); itr != toPurge.end(); ++itr)
+  {
+    std::map<unsigned int, unsigned long>::iterator delivered = internals.Delivered.find(*itr);
+    if (delivered == internals.Delivered.end())
+    {
+      // not delivered by this process.
+      continue;
+    }
+    if (budget > 0)
+    {
+      unsigned int tuple[2] = { myid, *itr };
+      toCache->InsertNextTypedTuple(tuple);
+      internals.Parked.push_front(*delivered);
+      internals.ParkedSize += delivered->second;
+    }
+    internals.Delivered.erase(delivered);
+  }
+
+  while (internals.ParkedSize > budget && !internals.Parked.empty())
+  {
+    unsigned int tuple[2] = { myid, internals.Parked.back().first };
+    toEvict->InsertNextTypedTuple(tuple);
+    internals.ParkedSize -= internals.Parked.back().second;
+    internals.Parked.pop_back();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkStreamingParticlesRepresentation::CacheBlocks(
+  vtkMultiBlockDataSet* data, vtkUnsignedIntArray* toCache, vtkUnsignedIntArray* toEvict)
+{
+  // ranks may share a file system, give each its own spill file.
+  std::string spillFileName;
+  if (this->BlockCacheSpillFileName && this->BlockCacheSpillFileName[0])
+  {
+    vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+    spillFileName = this->BlockCacheSpillFileName;
+    spillFileName += "." + std::to_string(controller ? controller->GetLocalProcessId() : 0);
+  }
+  for (vtkIdType cc = 0; data != NULL && toCache != NULL && cc < toCache->GetNumberOfTuples();
+       ++cc)
+  {
+    vtkInternals::BlockKey key(
+      toCache->GetTypedComponent(cc, 0), toCache->GetTypedComponent(cc, 1));
+    vtkMultiBlockDataSet* parent = NULL;
+    unsigned int index = 0;
+    // the block may already have been cached, when data-server and rendering
+    // nodes are the same.
+    if (locate_block(data, key.second, parent, index) && parent->GetBlock(index))
+    {
+      this->Internals->Store(key, parent->GetBlock(index), spillFileName.c_str());
+    }
+  }
+  for (vtkIdType cc = 0; toEvict != NULL && cc < toEvict->GetNumberOfTuples(); ++cc)
+  {
+    vtkInternals::BlockKey key(
+      toEvict->GetTypedComponent(cc, 0), toEvict->GetTypedComponent(cc, 1));
+    this->Internals->Cache.erase(key);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkStreamingParticlesRepresentation::RestoreBlocks(
+  vtkMultiBlockDataSet* data, vtkUnsignedIntArray* toRestore)
+{
+  for (vtkIdType cc = 0; data != NULL && toRestore != NULL && cc < toRestore->GetNumberOfTuples();
+       ++cc)
+  {
+    vtkInternals::BlockKey key(
+      toRestore->GetTypedComponent(cc, 0), toRestore->GetTypedComponent(cc, 1));
+    vtkSmartPointer<vtkDataObject> block = this->Internals->Load(key);
+    vtkMultiBlockDataSet* parent = NULL;
+    unsigned int index = 0;
+    if (block && locate_block(data, key.second, parent, index))
+    {
+      vtkStreamingStatusMacro(<< this << ": restored cached block: " << key.second);
+      parent->SetBlock(index, block);
+    }
+    else if (!block)
+    {
+      // the data server thinks the block is rendered now. Have it requested
+      // again, the data server and rendering nodes are the same processes
+      // (see the FIXME in StreamingUpdate()).
+      vtkWarningMacro("Failed to restore block " << key.second << " from the block cache.");
+      vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+      const int myid = controller ? controller->GetLocalProcessId() : 0;
+      if (key.first == static_cast<unsigned int>(myid))
+      {
+        this->Internals->Delivered.erase(key.second);
+        this->Internals->Reload.push_back(key.second);
+      }
+    }
+  }
+  if (data != NULL && toRestore != NULL && toRestore->GetNumberOfTuples() > 0)
+  {
+    data->Modified();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -540,6 +948,9 @@ void vtkStreamingParticlesRepresentation::PrintSelf(ostream& os, vtkIndent inden
   os << indent << "StreamingCapablePipeline: " << this->StreamingCapablePipeline << endl;
   os << indent << "UseOutline: " << this->UseOutline << endl;
   os << indent << "StreamingRequestSize: " << this->StreamingRequestSize << endl;
+  os << indent << "BlockCacheSize: " << this->BlockCacheSize << endl;
+  os << indent << "BlockCacheSpillFileName: "
+     << (this->BlockCacheSpillFileName ? this->BlockCacheSpillFileName : "(none)") << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -33,6 +33,7 @@ class vtkMultiBlockDataSet;
 class vtkPVLODActor;
 class vtkScalarsToColors;
 class vtkStreamingParticlesPriorityQueue;
+class vtkUnsignedIntArray;
 
 class VTKSTREAMINGPARTICLES_EXPORT vtkStreamingParticlesRepresentation
   : public vtkPVDataRepresentation
@@ -80,6 +81,26 @@ public:
   vtkSetClampMacro(StreamingRequestSize, int, 1, 10000);
   vtkGetMacro(StreamingRequestSize, int);
 
+  // Description:
+  // Set the size of the block cache, in MiB. Blocks purged from the view
+  // because they are out of the view frustum or replaced by a different
+  // resolution are kept in this cache on the rendering nodes, so that they can
+  // be restored without being read and delivered again when the view returns
+  // to them. Least recently purged blocks are evicted first when the cache
+  // exceeds this size. The budget is shared evenly between data-server ranks.
+  // Set to 0 to disable the cache. Defaults to 256.
+  vtkSetClampMacro(BlockCacheSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(BlockCacheSize, int);
+
+  // Description:
+  // When set, blocks in the block cache are written to a local file on the
+  // rendering nodes instead of being kept in memory. Each rank uses this name
+  // followed by `.<rank>`. The files are recreated whenever the input changes
+  // and removed when the representation is destroyed. Defaults to NULL i.e.
+  // blocks are cached in memory.
+  vtkSetStringMacro(BlockCacheSpillFileName);
+  vtkGetStringMacro(BlockCacheSpillFileName);
+
   // Description:
   // Helps with debugging.
   vtkSetMacro(UseOutline, bool);
@@ -182,6 +203,31 @@ protected:
   // current pass. Returns false if no blocks need to be streaming currently.
   bool DetermineBlocksToStream();
 
+  // Description:
+  // Called in StreamingUpdate() on the data-server nodes to move the blocks
+  // this process delivered and that the priority queue purged into the block
+  // cache ledger. Fills `toCache` with the blocks the rendering nodes must keep
+  // in their block cache and `toEvict` with the blocks they must drop from it
+  // to stay within BlockCacheSize. Both arrays hold (process, block) tuples.
+  void ParkPurgedBlocks(vtkUnsignedIntArray* toCache, vtkUnsignedIntArray* toEvict);
+
+  // Description:
+  // Called on the rendering nodes to move blocks of `data` into the block
+  // cache, and to drop evicted blocks from it.
+  void CacheBlocks(
+    vtkMultiBlockDataSet* data, vtkUnsignedIntArray* toCache, vtkUnsignedIntArray* toEvict);
+
+  // Description:
+  // Called in StreamingUpdate() on every process to put the blocks it parked
+  // back in `data` from the block cache.
+  void RestoreBlocks(vtkMultiBlockDataSet* data, vtkUnsignedIntArray* toRestore);
+
+  // Description:
+  // Called in StreamingUpdate() on the root data-server node to attach the
+  // gathered purge and block cache requests to the piece being streamed.
+  void AddBlockLists(vtkUnsignedIntArray* purgeArray,
+    const std::vector<vtkSmartPointer<vtkUnsignedIntArray> >& cacheArrays);
+
   // Description:
   // This is the data object generated processed by the most recent call to
   // RequestData() while not streaming.
@@ -217,11 +263,16 @@ protected:
   std::vector<int> StreamingRequest;
   int StreamingRequestSize;
   bool UseOutline;
+  int BlockCacheSize;
+  char* BlockCacheSpillFileName;
 
 private:
   vtkStreamingParticlesRepresentation(const vtkStreamingParticlesRepresentation&) = delete;
   void operator=(const vtkStreamingParticlesRepresentation&) = delete;
 
+  class vtkInternals;
+  vtkInternals* Internals;
+
   // Description:
   // This flag is set to true if the input pipeline is streaming capable in
   // RequestInformation(). Note that in client-server mode, this is valid only
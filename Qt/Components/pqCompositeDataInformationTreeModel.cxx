@@ -60,9 +60,14 @@ class CNode
   unsigned int LeafIndex;
   int DataType;
   int NumberOfPieces;
+  int Row; // index of this node in Parent->Children.
   CNode* Parent;
   std::vector<CNode> Children;
 
+  // Number of children in each Qt::CheckState. This lets us update the check
+  // state for a non-leaf node without iterating over all its children.
+  int ChildStateCounts[3];
+
   std::pair<Qt::CheckState, bool> CheckState; // bool is true if value was explicitly set,
                                               // false, if value is inherited.
   Qt::CheckState
@@ -81,62 +86,57 @@ class CNode
     {
       if (force == true || iter->CheckState.second == false)
       {
+        --this->ChildStateCounts[iter->CheckState.first];
+        ++this->ChildStateCounts[state];
         iter->CheckState.first = state;
         iter->CheckState.second = false; // flag value as inherited.
         iter->setChildrenCheckState(state, force, dmodel);
       }
     }
-    if (this->Children.size() > 0)
+    if (this->Children.size() > 0 && !dmodel->BulkUpdate)
     {
       dmodel->dataChanged(
         this->Children.front().createIndex(dmodel), this->Children.back().createIndex(dmodel));
     }
   }
 
+  void childCheckStateChanged(
+    Qt::CheckState oldState, Qt::CheckState newState, pqCompositeDataInformationTreeModel* dmodel)
+  {
+    --this->ChildStateCounts[oldState];
+    ++this->ChildStateCounts[newState];
+    this->updateCheckState(dmodel);
+  }
+
   void updateCheckState(pqCompositeDataInformationTreeModel* dmodel)
   {
-    int state = 0;
-    for (auto iter = this->Children.begin(); iter != this->Children.end(); ++iter)
+    const int count = static_cast<int>(this->Children.size());
+    Qt::CheckState target;
+    if (this->ChildStateCounts[Qt::Unchecked] == count)
     {
-      switch (iter->CheckState.first)
-      {
-        case Qt::Unchecked:
-          state |= 0x01;
-          break;
-
-        case Qt::PartiallyChecked:
-          state |= 0x02;
-          break;
-
-        case Qt::Checked:
-          state |= 0x04;
-          break;
-      }
+      target = Qt::Unchecked;
     }
-    Qt::CheckState target;
-    switch (state)
+    else if (this->ChildStateCounts[Qt::Checked] == count)
     {
-      case 0x01:
-      case 0:
-        target = Qt::Unchecked;
-        break;
-      case 0x04:
-        target = Qt::Checked;
-        break;
-
-      case 0x02:
-      default:
-        target = Qt::PartiallyChecked;
+      target = Qt::Checked;
+    }
+    else
+    {
+      target = Qt::PartiallyChecked;
     }
     if (this->CheckState.first != target)
     {
+      const Qt::CheckState prevState = this->CheckState.first;
       this->CheckState.first = target;
       if (this->Parent)
       {
-        this->Parent->updateCheckState(dmodel);
+        this->Parent->childCheckStateChanged(prevState, target, dmodel);
+      }
+      if (!dmodel->BulkUpdate)
+      {
+        QModelIndex idx = this->createIndex(dmodel);
+        dmodel->dataChanged(idx, idx);
       }
-      QModelIndex idx = this->createIndex(dmodel);
-      dmodel->dataChanged(idx, idx);
     }
   }
 
@@ -146,7 +146,9 @@ public:
     , LeafIndex(VTK_UNSIGNED_INT_MAX)
     , DataType(0)
     , NumberOfPieces(-1)
+    , Row(0)
     , Parent(nullptr)
+    , ChildStateCounts{ 0, 0, 0 }
     , CheckState(Qt::Unchecked, false)
     , ForceSetState(Qt::Unchecked)
     , CustomColumnState()
@@ -160,12 +162,10 @@ public:
     return NullNode;
   }
 
-  bool operator==(const CNode& other) const
-  {
-    return this->Name == other.Name && this->Index == other.Index &&
-      this->DataType == other.DataType && this->NumberOfPieces == other.NumberOfPieces &&
-      this->Parent == other.Parent && this->Children == other.Children;
-  }
+  // Nodes are only ever compared against other nodes in the same tree (or the
+  // null node), hence identity is sufficient. Comparing the subtrees is too
+  // slow for large hierarchies.
+  bool operator==(const CNode& other) const { return this == &other; }
   bool operator!=(const CNode& other) const { return !(*this == other); }
 
   void reset() { (*this) = CNode::nullNode(); }
@@ -209,14 +209,7 @@ public:
 
   int childIndex(const CNode& achild) const
   {
-    for (size_t cc = 0, max = this->Children.size(); cc < max; ++cc)
-    {
-      if (this->Children[cc] == achild)
-      {
-        return static_cast<int>(cc);
-      }
-    }
-    return 0;
+    return (achild.Parent == this) ? achild.Row : 0;
   }
   const CNode& parent() const { return this->Parent ? *this->Parent : CNode::nullNode(); }
 
@@ -229,17 +222,21 @@ public:
     {
       if (force == true || this->CheckState.second == false)
       {
+        const Qt::CheckState prevState = this->CheckState.first;
         this->CheckState.first = val ? Qt::Checked : Qt::Unchecked;
         this->ForceSetState = this->CheckState.first;
         this->CheckState.second = true;
         this->setChildrenCheckState(this->CheckState.first, force, dmodel);
         if (this->Parent)
         {
-          this->Parent->updateCheckState(dmodel);
+          this->Parent->childCheckStateChanged(prevState, this->CheckState.first, dmodel);
         }
 
-        QModelIndex idx = this->createIndex(dmodel);
-        dmodel->dataChanged(idx, idx);
+        if (!dmodel->BulkUpdate)
+        {
+          QModelIndex idx = this->createIndex(dmodel);
+          dmodel->dataChanged(idx, idx);
+        }
         return true;
       }
     }
@@ -310,8 +307,11 @@ public:
     if (value_pair.first != value)
     {
       value_pair.first = value;
-      QModelIndex idx = this->createIndex(dmodel, col + 1);
-      dmodel->dataChanged(idx, idx);
+      if (!dmodel->BulkUpdate)
+      {
+        QModelIndex idx = this->createIndex(dmodel, col + 1);
+        dmodel->dataChanged(idx, idx);
+      }
     }
 
     // flag that this value was explicitly set, unless value is invalid -- which
@@ -356,6 +356,22 @@ public:
     }
   }
 
+  // Fire dataChanged for all nodes in the subtree for the given column range.
+  // Used at the end of bulk updates, when signals for individual nodes are
+  // suppressed.
+  void emitDataChanged(int firstCol, int lastCol, pqCompositeDataInformationTreeModel* dmodel) const
+  {
+    if (this->Children.size() > 0)
+    {
+      dmodel->dataChanged(this->Children.front().createIndex(dmodel, firstCol),
+        this->Children.back().createIndex(dmodel, lastCol));
+      for (auto iter = this->Children.begin(); iter != this->Children.end(); ++iter)
+      {
+        iter->emitDataChanged(firstCol, lastCol, dmodel);
+      }
+    }
+  }
+
   bool build(vtkPVDataInformation* info, bool expand_multi_piece, unsigned int& index,
     unsigned int& leaf_index, int custom_column_count,
     std::unordered_map<unsigned int, CNode*>& lookupMap)
@@ -392,6 +408,7 @@ public:
           custom_column_count, lookupMap);
         // note:  build() will reset childNode, so don't set any ivars before calling it.
         childNode.Parent = this;
+        childNode.Row = static_cast<int>(cc);
         // if Name for block was provided, use that instead of the data type.
         const char* name = cinfo->GetName(cc);
         if (name && name[0])
@@ -407,6 +424,8 @@ public:
           childNode.Name = QString("Level %1").arg(cc);
         }
       }
+      // all nodes start unchecked.
+      this->ChildStateCounts[Qt::Unchecked] = static_cast<int>(this->Children.size());
     }
     else if (is_multipiece)
     {
@@ -497,6 +516,7 @@ pqCompositeDataInformationTreeModel::pqCompositeDataInformationTreeModel(QObject
   , ExpandMultiPiece(false)
   , Exclusivity(false)
   , DefaultCheckState(false)
+  , BulkUpdate(false)
 {
 }
 
@@ -736,10 +756,29 @@ bool pqCompositeDataInformationTreeModel::reset(vtkPVDataInformation* info)
   return retVal;
 }
 
+//-----------------------------------------------------------------------------
+void pqCompositeDataInformationTreeModel::beginBulkUpdate()
+{
+  this->BulkUpdate = true;
+}
+
+//-----------------------------------------------------------------------------
+void pqCompositeDataInformationTreeModel::endBulkUpdate(int firstCol, int lastCol)
+{
+  this->BulkUpdate = false;
+
+  // notify views once for the entire tree instead of once per modified node.
+  pqInternals& internals = (*this->Internals);
+  const CNode& root = internals.rootNode();
+  emit this->dataChanged(root.createIndex(this, firstCol), root.createIndex(this, lastCol));
+  root.emitDataChanged(firstCol, lastCol, this);
+}
+
 //-----------------------------------------------------------------------------
 void pqCompositeDataInformationTreeModel::setChecked(const QList<unsigned int>& indices)
 {
   pqInternals& internals = (*this->Internals);
+  this->beginBulkUpdate();
   internals.clearCheckState(this);
 
   foreach (unsigned int findex, indices)
@@ -747,6 +786,24 @@ void pqCompositeDataInformationTreeModel::setChecked(const QList<unsigned int>&
     CNode& node = internals.find(findex);
     node.setChecked(true, true, this);
   }
+  this->endBulkUpdate(0, 0);
+}
+
+//-----------------------------------------------------------------------------
+void pqCompositeDataInformationTreeModel::setCheckState(
+  const QList<unsigned int>& indices, bool checked)
+{
+  pqInternals& internals = (*this->Internals);
+  this->beginBulkUpdate();
+  foreach (unsigned int findex, indices)
+  {
+    CNode& node = internals.find(findex);
+    if (node != CNode::nullNode())
+    {
+      node.setChecked(checked, true, this);
+    }
+  }
+  this->endBulkUpdate(0, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -781,6 +838,7 @@ void pqCompositeDataInformationTreeModel::setCheckStates(
   const QList<QPair<unsigned int, bool> >& states)
 {
   pqInternals& internals = (*this->Internals);
+  this->beginBulkUpdate();
   internals.clearCheckState(this);
 
   for (auto iter = states.begin(); iter != states.end(); ++iter)
@@ -791,6 +849,7 @@ void pqCompositeDataInformationTreeModel::setCheckStates(
       node.setChecked(iter->second, /*force=*/false, this);
     }
   }
+  this->endBulkUpdate(0, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -813,6 +872,7 @@ QList<unsigned int> pqCompositeDataInformationTreeModel::checkedLevels() const
 void pqCompositeDataInformationTreeModel::setCheckedLevels(const QList<unsigned int>& indices)
 {
   pqInternals& internals = (*this->Internals);
+  this->beginBulkUpdate();
   internals.clearCheckState(this);
 
   CNode& root = internals.rootNode();
@@ -824,6 +884,7 @@ void pqCompositeDataInformationTreeModel::setCheckedLevels(const QList<unsigned
       root.child(idx).setChecked(true, true, this);
     }
   }
+  this->endBulkUpdate(0, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -852,6 +913,7 @@ void pqCompositeDataInformationTreeModel::setCheckedLevelDatasets(
   const QList<QPair<unsigned int, unsigned int> >& indices)
 {
   pqInternals& internals = (*this->Internals);
+  this->beginBulkUpdate();
   internals.clearCheckState(this);
 
   CNode& root = internals.rootNode();
@@ -869,6 +931,7 @@ void pqCompositeDataInformationTreeModel::setCheckedLevelDatasets(
       }
     }
   }
+  this->endBulkUpdate(0, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -939,6 +1002,7 @@ void pqCompositeDataInformationTreeModel::setColumnStates(
 
   CNode& root = internals.rootNode();
 
+  this->beginBulkUpdate();
   // clear all values.
   root.setCustomColumnState(col, QVariant(), /*force=*/true, this);
   foreach (const PairT& pair, values)
@@ -952,6 +1016,7 @@ void pqCompositeDataInformationTreeModel::setColumnStates(
       }
     }
   }
+  this->endBulkUpdate(col + 1, col + 1);
 }
 
 //-----------------------------------------------------------------------------
@@ -244,6 +244,14 @@ public:
    */
   void setChecked(const QList<unsigned int>& indices);
 
+  /**
+   * API to check or uncheck several nodes at once. Unlike `setChecked`, this
+   * does not clear the current state before setting. Views are notified once
+   * after all nodes have been updated, hence this is preferred over calling
+   * `setData` for each node when changing a large number of nodes.
+   */
+  void setCheckState(const QList<unsigned int>& indices, bool checked);
+
   /**
    * Returns check state for nodes explicitly toggled.
    */
@@ -364,6 +372,15 @@ public slots:
 private:
   Q_DISABLE_COPY(pqCompositeDataInformationTreeModel);
 
+  //@{
+  /**
+   * While in a bulk update, nodes don't fire dataChanged individually.
+   * `endBulkUpdate` fires dataChanged for all nodes for the given columns.
+   */
+  void beginBulkUpdate();
+  void endBulkUpdate(int firstCol, int lastCol);
+  //@}
+
   class pqInternals;
   QScopedPointer<pqInternals> Internals;
   QString HeaderLabel;
@@ -372,6 +389,7 @@ private:
   bool ExpandMultiPiece;
   bool Exclusivity;
   bool DefaultCheckState;
+  bool BulkUpdate;
 
   friend class pqCompositeDataInformationTreeModelNS::CNode;
 };
@@ -643,6 +643,7 @@ public:
   pqPropertyLinks Links;
   pqTimer ColoringTimer;
   pqTimer ResetTimer;
+  pqTimer VisibilityTimer;
 
   pqInternals(pqMultiBlockInspectorWidget* self)
     : CDTModel(new pqCompositeDataInformationTreeModel(self))
@@ -666,6 +667,12 @@ public:
     this->ResetTimer.setSingleShot(true);
     this->ResetTimer.setInterval(0);
 
+    // toggling a node may change check states for the entire subtree, which
+    // the model reports node by node. We only want to push the new block
+    // visibilities once.
+    this->VisibilityTimer.setSingleShot(true);
+    this->VisibilityTimer.setInterval(0);
+
     if (pqSettings* settings = pqApplicationCore::instance()->settings())
     {
       bool checked = settings->value("pqMultiBlockInspectorWidget/ShowHints", true).toBool();
@@ -794,6 +801,7 @@ pqMultiBlockInspectorWidget::pqMultiBlockInspectorWidget(
   // Hookups for timers.
   this->connect(&internals.ColoringTimer, SIGNAL(timeout()), SLOT(updateScalarColoring()));
   this->connect(&internals.ResetTimer, SIGNAL(timeout()), SLOT(resetNow()));
+  this->connect(&internals.VisibilityTimer, SIGNAL(timeout()), SLOT(blockVisibilitiesModified()));
 
   // Hookups for user interactions.
   this->connect(internals.Ui.treeView, SIGNAL(doubleClicked(const QModelIndex&)),
@@ -1240,14 +1248,23 @@ void pqMultiBlockInspectorWidget::itemDoubleClicked(const QModelIndex& idx)
 //-----------------------------------------------------------------------------
 void pqMultiBlockInspectorWidget::modelDataChanged(const QModelIndex& start, const QModelIndex& end)
 {
-  if (start.column() <= 0 && end.column() >= 0)
+  // signals are blocked when the model is being updated to match the
+  // representation's properties, in which case there's nothing to push.
+  if (start.column() <= 0 && end.column() >= 0 && !this->signalsBlocked())
   {
-    SCOPED_UNDO_SET("Change Block Visibilities");
-    emit this->blockVisibilitiesChanged();
-    emit this->requestRender();
+    pqInternals& internals = (*this->Internals);
+    internals.VisibilityTimer.start();
   }
 }
 
+//-----------------------------------------------------------------------------
+void pqMultiBlockInspectorWidget::blockVisibilitiesModified()
+{
+  SCOPED_UNDO_SET("Change Block Visibilities");
+  emit this->blockVisibilitiesChanged();
+  emit this->requestRender();
+}
+
 //-----------------------------------------------------------------------------
 void pqMultiBlockInspectorWidget::contextMenu(const QPoint& pos)
 {
@@ -1284,13 +1301,18 @@ void pqMultiBlockInspectorWidget::contextMenu(const QPoint& pos)
     if (selAction == showBlocks || selAction == hideBlocks)
     {
       const QModelIndexList sRows = internals.SelectionModel->selectedRows(0);
-      const QVariant val(selAction == showBlocks ? Qt::Checked : Qt::Unchecked);
+      QList<unsigned int> indices;
+      indices.reserve(sRows.size());
       for (auto iter = sRows.begin(); iter != sRows.end(); ++iter)
       {
-        internals.ProxyModel->setData(*iter, val, Qt::CheckStateRole);
+        indices.push_back(internals.ProxyModel
+                            ->data(*iter, pqCompositeDataInformationTreeModel::CompositeIndexRole)
+                            .value<unsigned int>());
       }
-      emit this->blockVisibilitiesChanged();
-      emit this->requestRender();
+      // update all blocks at once rather than one at a time.
+      internals.CDTModel->setCheckState(indices, selAction == showBlocks);
+      internals.VisibilityTimer.stop();
+      this->blockVisibilitiesModified();
     }
     else if (selAction == setColors)
     {
@@ -169,6 +169,7 @@ private slots:
   void setRepresentation(pqDataRepresentation* repr);
   void selected(pqOutputPort* port);
   void modelDataChanged(const QModelIndex&, const QModelIndex&);
+  void blockVisibilitiesModified();
   void contextMenu(const QPoint&);
   void resetEventually();
   void resetNow();
@@ -516,6 +516,12 @@ void pqProxyInformationWidget::onCurrentChanged(const QModelIndex& idx)
   {
     unsigned int cid = this->Ui->compositeTreeModel->compositeIndex(idx);
     vtkPVDataInformation* info = dataInformation->GetDataInformationForCompositeIndex(cid);
+    if (info && info->GetIsCompact())
+    {
+      // only the block structure was gathered for large composite datasets,
+      // fetch the details for the selected block.
+      info = this->OutputPort->getOutputPortProxy()->GetSubsetDataInformation(cid);
+    }
     this->fillDataInformation(info);
   }
 }
@@ -779,6 +779,9 @@ void pqProxyWidget::hideEvent(QHideEvent* hevent)
 void pqProxyWidget::apply() const
 {
   SM_SCOPED_TRACE(PropertiesModified).arg("proxy", this->proxy());
+
+  // update dependent domains once, after all widgets have been applied.
+  vtkSMProperty::DeferDomainUpdates deferDomainUpdates;
   foreach (const pqProxyWidgetItem* item, this->Internals->Items)
   {
     item->apply();
@@ -788,6 +791,7 @@ void pqProxyWidget::apply() const
 //-----------------------------------------------------------------------------
 void pqProxyWidget::reset() const
 {
+  vtkSMProperty::DeferDomainUpdates deferDomainUpdates;
   foreach (const pqProxyWidgetItem* item, this->Internals->Items)
   {
     item->reset();
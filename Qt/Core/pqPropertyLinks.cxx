@@ -222,13 +222,16 @@ void pqPropertyLinks::accept()
   // To avoid such incorrect feedback when we are accepting all changes, we use
   // IgnoreSMChanges flag.
   this->Internals->IgnoreSMChanges = true;
-
-  foreach (pqPropertyLinksConnection* connection, this->Internals->Connections)
   {
-    if (connection && connection->proxy())
+    // update dependent domains once all values have been copied.
+    vtkSMProperty::DeferDomainUpdates deferDomainUpdates;
+    foreach (pqPropertyLinksConnection* connection, this->Internals->Connections)
     {
-      connection->copyValuesFromQtToServerManager(false);
-      proxies_to_update.insert(connection->proxy());
+      if (connection && connection->proxy())
+      {
+        connection->copyValuesFromQtToServerManager(false);
+        proxies_to_update.insert(connection->proxy());
+      }
     }
   }
   this->Internals->IgnoreSMChanges = false;
@@ -243,6 +246,7 @@ void pqPropertyLinks::accept()
 //-----------------------------------------------------------------------------
 void pqPropertyLinks::reset()
 {
+  vtkSMProperty::DeferDomainUpdates deferDomainUpdates;
   foreach (pqPropertyLinksConnection* connection, this->Internals->Connections)
   {
     if (connection && connection->proxy())
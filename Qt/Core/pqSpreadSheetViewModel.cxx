@@ -580,6 +580,9 @@ void pqSpreadSheetViewModel::resetCompositeDataSetIndex()
     return;
   }
 
+  // Note that only counts are used here, these are available even when the
+  // information for the blocks is compact (see
+  // vtkPVDataInformation::GetIsCompact()) so there's no need to fetch details.
   vtkPVDataInformation* blockInfo = mbInfo->GetDataInformationForCompositeIndex(cur_index);
   if (blockInfo && blockInfo->GetNumberOfPoints() > 0)
   {
@@ -0,0 +1,612 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    pvbenchmark.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// pvbenchmark runs native benchmarks for the parts of ParaView that data goes
+// through on its way from a filter to the screen: geometry extraction, data
+// information gathering, data marshalling for delivery, image compression,
+// client-server stream encoding and proxy state loading.
+//
+// All benchmarks operate on synthetic datasets whose size is controlled by
+// `--size`. Results are written as JSON (`--output`) and can be compared with
+// `pvbenchmark_compare.py`.
+//
+// Usage:
+//   pvbenchmark [--size=tiny|small|medium|large] [--repeat=N]
+//               [--filter=substring] [--output=results.json] [--list]
+
+#include "vtkClientServerStream.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkImageCompressor.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLZ4Compressor.h"
+#include "vtkMPIMoveData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPVOptions.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPolyData.h"
+#include "vtkProcessModule.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxyManager.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkSquirtCompressor.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkZlibImageCompressor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Exposes the marshalling code used by vtkMPIMoveData for data delivery.
+class vtkBenchmarkMoveData : public vtkMPIMoveData
+{
+public:
+  static vtkBenchmarkMoveData* New();
+  vtkTypeMacro(vtkBenchmarkMoveData, vtkMPIMoveData);
+
+  vtkIdType Marshal(vtkDataObject* data)
+  {
+    this->ClearBuffer();
+    this->MarshalDataToBuffer(data);
+    return this->BufferTotalLength;
+  }
+
+  void Reconstruct(vtkDataObject* data) { this->ReconstructDataFromBuffer(data); }
+};
+vtkStandardNewMacro(vtkBenchmarkMoveData);
+
+//----------------------------------------------------------------------------
+struct Config
+{
+  std::string Size = "small";
+  int Scale = 2;
+  int Repeat = 5;
+  std::string Filter;
+  std::string Output;
+  bool List = false;
+};
+
+//----------------------------------------------------------------------------
+// Result of a single benchmark. Times are wall-clock seconds for each
+// repetition. `Bytes` and `Items` are per repetition and are used to report
+// throughput.
+struct Result
+{
+  std::string Name;
+  std::vector<double> Times;
+  double Bytes = 0;
+  double Items = 0;
+
+  double Min() const { return *std::min_element(this->Times.begin(), this->Times.end()); }
+  double Mean() const
+  {
+    return std::accumulate(this->Times.begin(), this->Times.end(), 0.0) / this->Times.size();
+  }
+  double Median() const
+  {
+    std::vector<double> sorted(this->Times);
+    std::sort(sorted.begin(), sorted.end());
+    const size_t mid = sorted.size() / 2;
+    return (sorted.size() % 2) ? sorted[mid] : 0.5 * (sorted[mid - 1] + sorted[mid]);
+  }
+};
+
+// A benchmark is a setup function returning the body to time. The body
+// returns the number of bytes and items it processed.
+struct Counts
+{
+  double Bytes;
+  double Items;
+};
+using BodyType = std::function<Counts()>;
+using SetupType = std::function<BodyType(const Config&)>;
+
+struct Benchmark
+{
+  std::string Name;
+  SetupType Setup;
+};
+
+//----------------------------------------------------------------------------
+// Synthetic dataset generators.
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> MakeWavelet(int halfExtent)
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-halfExtent, halfExtent, -halfExtent, halfExtent, -halfExtent, halfExtent);
+  source->Update();
+  return source->GetOutputDataObject(0);
+}
+
+vtkSmartPointer<vtkDataObject> MakeTetrahedra(int halfExtent)
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-halfExtent, halfExtent, -halfExtent, halfExtent, -halfExtent, halfExtent);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputConnection(source->GetOutputPort());
+  tetrahedralize->Update();
+  return tetrahedralize->GetOutputDataObject(0);
+}
+
+vtkSmartPointer<vtkDataObject> MakeMultiBlock(int numberOfBlocks, int resolution)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(resolution);
+  sphere->SetPhiResolution(resolution);
+  sphere->Update();
+
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetNumberOfBlocks(numberOfBlocks);
+  for (int cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    vtkNew<vtkPolyData> block;
+    block->ShallowCopy(sphere->GetOutput());
+    mb->SetBlock(cc, block);
+  }
+  return vtkSmartPointer<vtkDataObject>(mb.GetPointer());
+}
+
+vtkSmartPointer<vtkUnsignedCharArray> MakeImage(int width, int height)
+{
+  auto pixels = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  pixels->SetNumberOfComponents(4);
+  pixels->SetNumberOfTuples(static_cast<vtkIdType>(width) * height);
+  unsigned char* ptr = pixels->GetPointer(0);
+  // smooth gradients with a few hard edges and some noise, which is roughly
+  // what rendered images look like to a compressor.
+  unsigned int seed = 1;
+  for (int j = 0; j < height; ++j)
+  {
+    for (int i = 0; i < width; ++i, ptr += 4)
+    {
+      seed = seed * 1103515245u + 12345u;
+      const unsigned char noise = static_cast<unsigned char>((seed >> 16) & 0x3);
+      const bool background = ((i / 64 + j / 64) % 3) == 0;
+      ptr[0] = background ? 255 : static_cast<unsigned char>((i * 255) / width + noise);
+      ptr[1] = background ? 255 : static_cast<unsigned char>((j * 255) / height + noise);
+      ptr[2] = background ? 255 : static_cast<unsigned char>(128 + noise);
+      ptr[3] = 255;
+    }
+  }
+  return pixels;
+}
+
+//----------------------------------------------------------------------------
+// Benchmarks.
+//----------------------------------------------------------------------------
+BodyType GeometryFilterBenchmark(vtkSmartPointer<vtkDataObject> input)
+{
+  return [input]() {
+    vtkNew<vtkPVGeometryFilter> filter;
+    filter->SetInputData(input);
+    filter->Update();
+    vtkDataObject* output = filter->GetOutputDataObject(0);
+    return Counts{ static_cast<double>(input->GetActualMemorySize()) * 1024,
+      static_cast<double>(output->GetNumberOfElements(vtkDataObject::CELL)) };
+  };
+}
+
+BodyType DataInformationBenchmark(vtkSmartPointer<vtkDataObject> input)
+{
+  return [input]() {
+    vtkNew<vtkPVDataInformation> info;
+    info->CopyFromObject(input);
+
+    // include the serialization round trip since the information is always
+    // shipped to the client.
+    vtkClientServerStream css;
+    info->CopyToStream(&css);
+    vtkNew<vtkPVDataInformation> copy;
+    copy->CopyFromStream(&css);
+
+    const unsigned char* data;
+    size_t length;
+    css.GetData(&data, &length);
+    return Counts{ static_cast<double>(length), static_cast<double>(copy->GetNumberOfCells()) };
+  };
+}
+
+BodyType MarshalBenchmark(vtkSmartPointer<vtkDataObject> input, bool reconstruct)
+{
+  vtkSmartPointer<vtkBenchmarkMoveData> mover = vtkSmartPointer<vtkBenchmarkMoveData>::New();
+  mover->SetOutputDataType(input->GetDataObjectType());
+  if (!reconstruct)
+  {
+    return [input, mover]() {
+      const vtkIdType length = mover->Marshal(input);
+      return Counts{ static_cast<double>(length), 1 };
+    };
+  }
+
+  const vtkIdType length = mover->Marshal(input);
+  return [input, mover, length]() {
+    vtkSmartPointer<vtkDataObject> output;
+    output.TakeReference(input->NewInstance());
+    mover->Reconstruct(output);
+    return Counts{ static_cast<double>(length), 1 };
+  };
+}
+
+BodyType CompressorBenchmark(vtkSmartPointer<vtkImageCompressor> compressor, int width, int height)
+{
+  auto image = MakeImage(width, height);
+  compressor->SetLossLessMode(1);
+  return [compressor, image, width, height]() {
+    compressor->SetImageResolution(width, height);
+    compressor->SetInput(image);
+    compressor->Compress();
+
+    vtkNew<vtkUnsignedCharArray> compressed;
+    compressed->DeepCopy(compressor->GetOutput());
+    compressor->SetInput(compressed);
+    compressor->Decompress();
+    return Counts{ static_cast<double>(image->GetNumberOfValues()),
+      static_cast<double>(width) * height };
+  };
+}
+
+BodyType StreamBenchmark(int numberOfMessages, bool decode)
+{
+  auto build = [numberOfMessages](vtkClientServerStream& stream) {
+    const std::vector<double> values(16, 1.5);
+    for (int cc = 0; cc < numberOfMessages; ++cc)
+    {
+      stream << vtkClientServerStream::Invoke << vtkClientServerID(cc + 1) << "SetValues" << cc
+             << "a-string-argument"
+             << vtkClientServerStream::InsertArray(values.data(), static_cast<int>(values.size()))
+             << vtkClientServerStream::End;
+    }
+  };
+
+  if (!decode)
+  {
+    return [build, numberOfMessages]() {
+      vtkClientServerStream stream;
+      build(stream);
+      const unsigned char* data;
+      size_t length;
+      stream.GetData(&data, &length);
+      return Counts{ static_cast<double>(length), static_cast<double>(numberOfMessages) };
+    };
+  }
+
+  auto source = std::make_shared<vtkClientServerStream>();
+  build(*source);
+  return [source]() {
+    const unsigned char* data;
+    size_t length;
+    source->GetData(&data, &length);
+
+    vtkClientServerStream stream;
+    stream.SetData(data, length);
+    const int numMessages = stream.GetNumberOfMessages();
+    double sum = 0;
+    for (int cc = 0; cc < numMessages; ++cc)
+    {
+      int index = 0;
+      const char* str = nullptr;
+      double values[16];
+      stream.GetArgument(cc, 2, &index);
+      stream.GetArgument(cc, 3, &str);
+      stream.GetArgument(cc, 4, values, 16);
+      sum += values[0] + index;
+    }
+    (void)sum;
+    return Counts{ static_cast<double>(length), static_cast<double>(numMessages) };
+  };
+}
+
+BodyType StateLoadingBenchmark(int numberOfChains)
+{
+  // The session is kept alive for as long as the benchmark body is.
+  auto session = vtkSmartPointer<vtkSMSession>::New();
+  vtkSMSessionProxyManager* pxm =
+    vtkSMProxyManager::GetProxyManager()->GetSessionProxyManager(session);
+
+  for (int cc = 0; cc < numberOfChains; ++cc)
+  {
+    vtkSmartPointer<vtkSMProxy> sphere;
+    sphere.TakeReference(pxm->NewProxy("sources", "SphereSource"));
+    vtkSMPropertyHelper(sphere, "Radius").Set(0.5 + cc);
+    sphere->UpdateVTKObjects();
+
+    vtkSmartPointer<vtkSMProxy> shrink;
+    shrink.TakeReference(pxm->NewProxy("filters", "ShrinkFilter"));
+    vtkSMPropertyHelper(shrink, "Input").Set(sphere.GetPointer());
+    shrink->UpdateVTKObjects();
+
+    const std::string suffix = std::to_string(cc);
+    pxm->RegisterProxy("sources", ("Sphere" + suffix).c_str(), sphere.GetPointer());
+    pxm->RegisterProxy("sources", ("Shrink" + suffix).c_str(), shrink.GetPointer());
+  }
+
+  vtkSmartPointer<vtkPVXMLElement> state;
+  state.TakeReference(pxm->SaveXMLState());
+  pxm->UnRegisterProxies();
+
+  return [session, pxm, state, numberOfChains]() {
+    pxm->LoadXMLState(state);
+    pxm->UnRegisterProxies();
+    return Counts{ 0, static_cast<double>(2 * numberOfChains) };
+  };
+}
+
+//----------------------------------------------------------------------------
+std::vector<Benchmark> GetBenchmarks()
+{
+  std::vector<Benchmark> benchmarks;
+  auto add = [&benchmarks](const std::string& name, SetupType setup) {
+    benchmarks.push_back(Benchmark{ name, setup });
+  };
+
+  add("GeometryFilter/ImageData",
+    [](const Config& c) { return GeometryFilterBenchmark(MakeWavelet(20 * c.Scale)); });
+  add("GeometryFilter/UnstructuredGrid",
+    [](const Config& c) { return GeometryFilterBenchmark(MakeTetrahedra(10 * c.Scale)); });
+  add("GeometryFilter/MultiBlock",
+    [](const Config& c) { return GeometryFilterBenchmark(MakeMultiBlock(250 * c.Scale, 16)); });
+
+  add("DataInformation/UnstructuredGrid",
+    [](const Config& c) { return DataInformationBenchmark(MakeTetrahedra(10 * c.Scale)); });
+  add("DataInformation/MultiBlock",
+    [](const Config& c) { return DataInformationBenchmark(MakeMultiBlock(500 * c.Scale, 8)); });
+
+  add("MoveData/Marshal", [](const Config& c) {
+    return MarshalBenchmark(MakeTetrahedra(8 * c.Scale), /*reconstruct=*/false);
+  });
+  add("MoveData/Reconstruct", [](const Config& c) {
+    return MarshalBenchmark(MakeTetrahedra(8 * c.Scale), /*reconstruct=*/true);
+  });
+
+  add("ImageCompressor/Zlib", [](const Config& c) {
+    return CompressorBenchmark(
+      vtkSmartPointer<vtkImageCompressor>::Take(vtkZlibImageCompressor::New()), 480 * c.Scale,
+      270 * c.Scale);
+  });
+  add("ImageCompressor/Squirt", [](const Config& c) {
+    return CompressorBenchmark(
+      vtkSmartPointer<vtkImageCompressor>::Take(vtkSquirtCompressor::New()), 480 * c.Scale,
+      270 * c.Scale);
+  });
+  add("ImageCompressor/LZ4", [](const Config& c) {
+    return CompressorBenchmark(
+      vtkSmartPointer<vtkImageCompressor>::Take(vtkLZ4Compressor::New()), 480 * c.Scale,
+      270 * c.Scale);
+  });
+
+  add("ClientServerStream/Encode",
+    [](const Config& c) { return StreamBenchmark(25000 * c.Scale, /*decode=*/false); });
+  add("ClientServerStream/Decode",
+    [](const Config& c) { return StreamBenchmark(25000 * c.Scale, /*decode=*/true); });
+
+  add("StateLoading/LoadXMLState",
+    [](const Config& c) { return StateLoadingBenchmark(25 * c.Scale); });
+  return benchmarks;
+}
+
+//----------------------------------------------------------------------------
+bool ParseArguments(int argc, char* argv[], Config& config)
+{
+  for (int cc = 1; cc < argc; ++cc)
+  {
+    const std::string arg = argv[cc];
+    const size_t eq = arg.find('=');
+    const std::string key = arg.substr(0, eq);
+    const std::string value = eq == std::string::npos ? std::string() : arg.substr(eq + 1);
+    if (key == "--size")
+    {
+      config.Size = value;
+      if (value == "tiny")
+      {
+        config.Scale = 1;
+      }
+      else if (value == "small")
+      {
+        config.Scale = 2;
+      }
+      else if (value == "medium")
+      {
+        config.Scale = 4;
+      }
+      else if (value == "large")
+      {
+        config.Scale = 8;
+      }
+      else
+      {
+        std::cerr << "Invalid size '" << value << "'." << std::endl;
+        return false;
+      }
+    }
+    else if (key == "--repeat")
+    {
+      config.Repeat = std::max(1, std::atoi(value.c_str()));
+    }
+    else if (key == "--filter")
+    {
+      config.Filter = value;
+    }
+    else if (key == "--output")
+    {
+      config.Output = value;
+    }
+    else if (key == "--list")
+    {
+      config.List = true;
+    }
+    else if (key == "--help" || key == "-h")
+    {
+      return false;
+    }
+    else
+    {
+      std::cerr << "Unknown argument '" << arg << "'." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+std::string EscapeJSON(const std::string& str)
+{
+  std::string result;
+  for (const char ch : str)
+  {
+    if (ch == '"' || ch == '\\')
+    {
+      result += '\\';
+    }
+    result += ch;
+  }
+  return result;
+}
+
+void WriteJSON(std::ostream& os, const Config& config, const std::vector<Result>& results)
+{
+  std::time_t now = std::time(nullptr);
+  char timestamp[64];
+  std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+  os.precision(9);
+  os << "{\n"
+     << "  \"version\": 1,\n"
+     << "  \"timestamp\": \"" << timestamp << "\",\n"
+     << "  \"size\": \"" << EscapeJSON(config.Size) << "\",\n"
+     << "  \"repeat\": " << config.Repeat << ",\n"
+     << "  \"benchmarks\": [";
+  for (size_t cc = 0; cc < results.size(); ++cc)
+  {
+    const Result& r = results[cc];
+    os << (cc > 0 ? "," : "") << "\n    {\n"
+       << "      \"name\": \"" << EscapeJSON(r.Name) << "\",\n"
+       << "      \"min\": " << r.Min() << ",\n"
+       << "      \"median\": " << r.Median() << ",\n"
+       << "      \"mean\": " << r.Mean() << ",\n"
+       << "      \"bytes\": " << r.Bytes << ",\n"
+       << "      \"items\": " << r.Items << ",\n"
+       << "      \"times\": [";
+    for (size_t t = 0; t < r.Times.size(); ++t)
+    {
+      os << (t > 0 ? ", " : "") << r.Times[t];
+    }
+    os << "]\n    }";
+  }
+  os << "\n  ]\n}\n";
+}
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  Config config;
+  if (!ParseArguments(argc, argv, config))
+  {
+    std::cerr << "Usage: " << argv[0] << " [--size=tiny|small|medium|large] [--repeat=N]\n"
+              << "          [--filter=substring] [--output=results.json] [--list]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const auto benchmarks = GetBenchmarks();
+  if (config.List)
+  {
+    for (const auto& benchmark : benchmarks)
+    {
+      std::cout << benchmark.Name << std::endl;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // arguments have already been processed, don't let vtkPVOptions complain
+  // about them.
+  int pvargc = 1;
+  vtkNew<vtkPVOptions> options;
+  vtkInitializationHelper::Initialize(pvargc, argv, vtkProcessModule::PROCESS_CLIENT, options);
+
+  std::vector<Result> results;
+  for (const auto& benchmark : benchmarks)
+  {
+    if (!config.Filter.empty() && benchmark.Name.find(config.Filter) == std::string::npos)
+    {
+      continue;
+    }
+
+    Result result;
+    result.Name = benchmark.Name;
+    {
+      BodyType body = benchmark.Setup(config);
+
+      // warm up caches and lazily initialized state.
+      body();
+      for (int cc = 0; cc < config.Repeat; ++cc)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        const Counts counts = body();
+        const auto end = std::chrono::steady_clock::now();
+        result.Times.push_back(std::chrono::duration<double>(end - start).count());
+        result.Bytes = counts.Bytes;
+        result.Items = counts.Items;
+      }
+    }
+
+    const double median = result.Median();
+    std::cout << result.Name << ": median " << median * 1000.0 << " ms";
+    if (result.Bytes > 0 && median > 0)
+    {
+      std::cout << ", " << (result.Bytes / median) / (1024.0 * 1024.0) << " MiB/s";
+    }
+    std::cout << std::endl;
+    results.push_back(result);
+  }
+
+  int status = EXIT_SUCCESS;
+  if (!config.Output.empty())
+  {
+    std::ofstream ofs(config.Output.c_str());
+    if (ofs)
+    {
+      WriteJSON(ofs, config, results);
+    }
+    else
+    {
+      std::cerr << "Failed to open '" << config.Output << "' for writing." << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,67 @@
+#!/usr/bin/env python
+"""Compare two result files generated by `pvbenchmark --output=...`.
+
+Usage:
+    pvbenchmark_compare.py baseline.json current.json [--threshold=0.10]
+
+For every benchmark present in both files, the median times are compared. A
+benchmark is flagged as a regression when the current median is slower than the
+baseline median by more than the threshold (a fraction, 10% by default). The
+script exits with a non-zero status if any regressions were found so that it
+can be used in automated checks.
+"""
+from __future__ import print_function
+
+import argparse
+import json
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        data = json.load(f)
+    return data, dict((b["name"], b) for b in data.get("benchmarks", []))
+
+
+def main(args=None):
+    parser = argparse.ArgumentParser(description="Compare pvbenchmark results.")
+    parser.add_argument("baseline", help="results to compare against")
+    parser.add_argument("current", help="results to check")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown to flag as a regression (default: 0.10)")
+    parser.add_argument("--metric", choices=["min", "median", "mean"], default="median",
+                        help="timing to compare (default: median)")
+    options = parser.parse_args(args)
+
+    baseline_info, baseline = load(options.baseline)
+    current_info, current = load(options.current)
+    if baseline_info.get("size") != current_info.get("size"):
+        print("warning: comparing results for different sizes ('%s' vs '%s')" %
+              (baseline_info.get("size"), current_info.get("size")))
+
+    regressions = []
+    print("%-40s %12s %12s %9s" % ("benchmark", "baseline(ms)", "current(ms)", "change"))
+    for name in sorted(set(baseline.keys()) | set(current.keys())):
+        if name not in baseline or name not in current:
+            print("%-40s %s" % (name, "only in current" if name in current else "only in baseline"))
+            continue
+        old = baseline[name][options.metric]
+        new = current[name][options.metric]
+        change = (new - old) / old if old > 0 else 0.0
+        flag = ""
+        if change > options.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        elif change < -options.threshold:
+            flag = "  improved"
+        print("%-40s %12.3f %12.3f %+8.1f%%%s" % (name, old * 1e3, new * 1e3, change * 100, flag))
+
+    if regressions:
+        print("\n%d regression(s) above %.0f%%: %s" %
+              (len(regressions), options.threshold * 100, ", ".join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())